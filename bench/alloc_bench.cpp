@@ -0,0 +1,160 @@
+/*
+** Filename: alloc_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Heap allocations per request, by request type.
+**              Feeds each kind of request (POST with 1 and 10 posts, GET_BOARD, filtered
+**              GET_BOARD, paged GET_BOARD, SUBSCRIBE/UNSUBSCRIBE, an invalid command) through
+**              the same framing, parsing and handling path the I/O loops use, and counts
+**              calls to operator new per request. --arena-bytes=0 turns the per-connection
+**              request arena off, so both runs can be compared.
+**
+** Usage:   ./build/alloc_bench [--requests=N] [--arena-bytes=N]
+** Example: ./build/alloc_bench --arena-bytes=0
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+static std::atomic<size_t> allocations{0};
+
+// GCC flags free() on memory from a replaced operator new once both are inlined; here they match
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// std::pmr::new_delete_resource() allocates through the aligned forms
+void* operator new(size_t size, std::align_val_t align)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t alignment = std::max(sizeof(void*), static_cast<size_t>(align));
+    if (void* p = std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Runs requests copies of message through process_buffered_messages
+/// @return Heap allocations per request
+static double allocations_per_request(const std::string& message, int requests, RequestArena& arena,
+                                      ClientSubscription& subscription)
+{
+    MessageFramer framer(transmissionTerminator);
+    size_t responseBytes = 0;
+    auto emit = [&](WireResponse&& response) { responseBytes += response.size(); };
+
+    // Warm-up: fills the response cache, the arena block and the thread-local field list
+    framer.append(message.data(), message.size());
+    process_buffered_messages(framer, -1, 1, subscription, arena, nullptr, emit);
+
+    size_t before = allocations.load(std::memory_order_relaxed);
+    for (int i = 0; i < requests; i++)
+    {
+        framer.append(message.data(), message.size());
+        process_buffered_messages(framer, -1, 1, subscription, arena, nullptr, emit);
+    }
+    size_t total = allocations.load(std::memory_order_relaxed) - before;
+    if (responseBytes == 0) std::exit(1);
+    return static_cast<double>(total) / requests;
+}
+
+/// @brief Builds a POST of count posts in wire format
+static std::string make_post(size_t count)
+{
+    std::string message = "POST";
+    for (size_t i = 0; i < count; i++)
+    {
+        message += (i == 0) ? fieldDelimiter : messageSeperator;
+        message += "Author" + std::to_string(i % 50) + fieldDelimiter + "Title " + std::to_string(i % 7) +
+                   fieldDelimiter + "Message body number " + std::to_string(i) + " with some typical text";
+    }
+    return message + transmissionTerminator;
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    int requests = 20000;                            // Requests per type
+    size_t arenaBytes = RequestArena::DEFAULT_BLOCK;  // Per-connection arena block (0 = off)
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--requests=", 0) == 0)          requests = std::max(1, std::atoi(arg.c_str() + 11));
+        else if (arg.rfind("--arena-bytes=", 0) == 0)  arenaBytes = (size_t)std::max(0, std::atoi(arg.c_str() + 14));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--requests=N] [--arena-bytes=N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Requests only touch memory: no post log, and a board of 1000 posts to read from
+    g_serverState.config.postLog.durability = LogDurability::NONE;
+    g_serverState.messageBoard.clear();
+    std::string error;
+    std::vector<Post> seed;
+    for (int i = 0; i < 1000; i++)
+    {
+        seed.push_back(Post{"Author" + std::to_string(i % 50), "Title " + std::to_string(i % 7),
+                            "Seed message number " + std::to_string(i)});
+    }
+    if (!publish_posts(std::move(seed), error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    RequestArena arena(arenaBytes);
+    ClientSubscription subscription;
+    struct Case { const char* name; std::string message; };
+    const Case cases[] = {
+        {"POST (1 post)", make_post(1)},
+        {"POST (10 posts)", make_post(10)},
+        {"GET_BOARD", "GET_BOARD" + transmissionTerminator},
+        {"GET_BOARD author", "GET_BOARD" + fieldDelimiter + "Author7" + transmissionTerminator},
+        {"GET_BOARD paged", "GET_BOARD" + fieldDelimiter + fieldDelimiter + fieldDelimiter + "990" + fieldDelimiter + "5" +
+                            transmissionTerminator},
+        {"SUBSCRIBE+UNSUB", "SUBSCRIBE" + fieldDelimiter + "Author7" + transmissionTerminator + "UNSUBSCRIBE" +
+                            transmissionTerminator},
+        {"invalid command", "BOGUS" + fieldDelimiter + "x" + transmissionTerminator},
+    };
+
+    std::printf("arena=%zu bytes, %d requests per type\n", arenaBytes, requests);
+    std::printf("  %-18s %14s\n", "request", "allocs/request");
+    for (const Case& c : cases)
+    {
+        // POSTs publish, so keep the board (and the cached GET_BOARD) from growing without bound
+        int count = c.message.rfind("POST", 0) == 0 ? std::min(requests, 2000) : requests;
+        double perRequest = allocations_per_request(c.message, count, arena, subscription);
+        if (c.message.rfind("SUBSCRIBE", 0) == 0) perRequest /= 2;  // Two requests per message
+        std::printf("  %-18s %14.2f\n", c.name, perRequest);
+        std::fflush(stdout);
+    }
+    end_subscription(subscription);
+    return 0;
+}
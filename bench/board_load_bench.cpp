@@ -0,0 +1,132 @@
+/*
+** Filename: board_load_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Startup-time benchmark for the saved message board formats.
+**              Writes a synthetic board as the old MessageBoard.txt text format and as the
+**              binary board file, then times loading each one into the board store, the
+**              one-time text-to-binary conversion, and the first GET_BOARD after loading.
+**
+** Usage:   ./build/board_load_bench [--posts=N] [--runs=N] [--dir=PATH]
+** Example: ./build/board_load_bench --posts=1000000 --dir=/var/tmp
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Milliseconds elapsed since start
+static double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Loads the text file the way the server did before the binary format
+static void load_text(const std::string& textPath)
+{
+    std::vector<Post> posts;
+    std::string error;
+    if (!BoardFile::readText(textPath, posts, error))
+    {
+        std::cerr << error << std::endl;
+        std::exit(1);
+    }
+    g_serverState.messageBoard.append(std::move(posts));
+}
+
+/// @brief Best-of-runs timing of one load path plus the first GET_BOARD served after it
+static void time_load(const char* name, int runs, size_t expected, const std::function<void()>& load)
+{
+    double bestLoad = 1e30, bestGet = 1e30;
+    for (int r = 0; r < runs; r++)
+    {
+        g_serverState.messageBoard.clear();
+        auto start = std::chrono::steady_clock::now();
+        load();
+        bestLoad = std::min(bestLoad, elapsed_ms(start));
+
+        if (g_serverState.messageBoard.size() != expected)
+        {
+            std::cerr << name << ": loaded " << g_serverState.messageBoard.size() << " posts, expected " << expected << std::endl;
+            std::exit(1);
+        }
+
+        start = std::chrono::steady_clock::now();
+        std::string response = get_board_handler("", "");
+        bestGet = std::min(bestGet, elapsed_ms(start));
+    }
+    std::printf("  %-28s %12.1f %18.1f\n", name, bestLoad, bestGet);
+    std::fflush(stdout);
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    size_t postCount = 200000;  // Posts on the synthetic board
+    int runs = 3;               // Each load path is timed this many times (best is reported)
+    std::string dir = ".";      // Where the temporary board files are written
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--posts=", 0) == 0)      postCount = std::strtoul(arg.c_str() + 8, nullptr, 10);
+        else if (arg.rfind("--runs=", 0) == 0)  runs = std::max(1, std::atoi(arg.c_str() + 7));
+        else if (arg.rfind("--dir=", 0) == 0)   dir = arg.substr(6);
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--posts=N] [--runs=N] [--dir=PATH]" << std::endl;
+            return 1;
+        }
+    }
+    std::string textPath = dir + "/board_load_bench.txt";
+    std::string boardPath = dir + "/board_load_bench.board";
+
+    // Synthetic board: a few hundred authors, short titles, ~100-byte messages
+    std::vector<Post> posts;
+    posts.reserve(postCount);
+    for (size_t i = 0; i < postCount; i++)
+    {
+        posts.push_back(Post{"user" + std::to_string(i % 500), "Topic " + std::to_string(i % 1000),
+                             "Message number " + std::to_string(i) + " - a typical short post body with a little text in it.",
+                             (int)(i % 64)});
+    }
+    std::string text;
+    for (const Post& post : posts) BoardFile::appendTextLine(post, text);
+    {
+        std::ofstream file(textPath, std::ios::binary);
+        file << text;
+    }
+
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    size_t converted = 0;
+    if (!BoardFile::convertText(textPath, boardPath, converted, error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    double convertMs = elapsed_ms(start);
+    posts.clear();
+
+    g_serverState.config.snapshotPath = boardPath;
+    g_serverState.config.legacyBoardPath = textPath;
+
+    std::printf("posts=%zu text=%.1f MB\n", postCount, text.size() / 1048576.0);
+    std::printf("  %-28s %12s %18s\n", "load path", "load ms", "first GET_BOARD ms");
+    time_load("text (parse + copy)", runs, postCount, [&] { load_text(textPath); });
+    time_load("binary (mmap + index)", runs, postCount, [] { g_serverState.loadFromFile(); });
+    std::printf("  one-time conversion: %.1f ms\n", convertMs);
+
+    g_serverState.messageBoard.clear();
+    unlink(textPath.c_str());
+    unlink(boardPath.c_str());
+    return 0;
+}
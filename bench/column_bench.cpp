@@ -0,0 +1,144 @@
+/*
+** Filename: column_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Scan-heavy board queries over the columnar board layout.
+**              Appends a synthetic board and times the queries that walk every post:
+**              the GUI's substring filter on author and title (row by row through at(),
+**              as the GUI used to, and through BoardStore::select() over the id columns),
+**              an equality count on the author, and building the author/title index.
+**              Also reports resident bytes per post.
+**
+** Usage:   ./build/column_bench [--posts=N] [--authors=N] [--titles=N]
+** Example: ./build/column_bench --posts=10000000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Resident set size of this process in bytes
+static size_t resident_bytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/// @brief Best of repeats runs of fn(), in seconds
+template <typename Fn>
+static double best_seconds(int repeats, Fn&& fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+static std::string author_name(size_t i) { return "Author number " + std::to_string(i); }
+static std::string title_name(size_t i)  { return "Discussion topic " + std::to_string(i); }
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    size_t posts = 1000000;  // Board size
+    size_t authors = 100;    // Distinct authors
+    size_t titles = 50;      // Distinct titles
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--posts=", 0) == 0)         posts = std::max(1L, std::atol(arg.c_str() + 8));
+        else if (arg.rfind("--authors=", 0) == 0)  authors = std::max(1L, std::atol(arg.c_str() + 10));
+        else if (arg.rfind("--titles=", 0) == 0)   titles = std::max(1L, std::atol(arg.c_str() + 9));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--posts=N] [--authors=N] [--titles=N]" << std::endl;
+            return 1;
+        }
+    }
+
+    BoardStore& board = g_serverState.messageBoard;
+    board.clear();
+
+    size_t residentBefore = resident_bytes();
+    std::vector<Post> batch;
+    for (size_t i = 0; i < posts; i++)
+    {
+        batch.push_back(Post{author_name(i % authors), title_name((i / authors) % titles),
+                             "Message body number " + std::to_string(i)});
+        if (batch.size() == 1024 || i + 1 == posts)
+        {
+            board.append(std::move(batch));
+            batch.clear();
+        }
+    }
+    size_t boardBytes = resident_bytes() - residentBefore;
+    std::printf("posts=%zu authors=%zu titles=%zu\n", posts, authors, titles);
+    std::printf("  resident:            %8.1f MiB (%.1f bytes/post)\n", boardBytes / 1048576.0,
+                (double)boardBytes / posts);
+
+    // ====================================================================
+    // SUBSTRING FILTER: what the GUI does for its author/title filter boxes
+    // ====================================================================
+    const std::string authorPart = "number 4";  // Matches 11 of the first 100 authors
+    const std::string titlePart = "topic 2";    // Matches 11 of the first 50 titles
+    const int repeats = 3;
+    size_t rowMatches = 0, columnMatches = 0;
+    double rowSec = best_seconds(repeats, [&] {
+        rowMatches = 0;
+        for (size_t i = 0; i < board.size(); i++)
+        {
+            PostView post = board.at(i);
+            rowMatches += post.author.find(authorPart) != std::string_view::npos &&
+                          post.title.find(titlePart) != std::string_view::npos;
+        }
+    });
+    double columnSec = best_seconds(repeats, [&] {
+        columnMatches = board.select(0, board.size(),
+            [&](std::string_view author) { return author.find(authorPart) != std::string_view::npos; },
+            [&](std::string_view title) { return title.find(titlePart) != std::string_view::npos; }).size();
+    });
+    std::printf("  substring rows:      %8.2f ms (%zu matches, %.2f ns/post)\n", rowSec * 1e3, rowMatches,
+                rowSec * 1e9 / posts);
+    std::printf("  substring columns:   %8.2f ms (%zu matches, %.2f ns/post)\n", columnSec * 1e3, columnMatches,
+                columnSec * 1e9 / posts);
+
+    // ====================================================================
+    // EQUALITY COUNT: one author, rows vs the author id column
+    // ====================================================================
+    uint32_t authorId = board.names().find(author_name(authors / 2));
+    size_t rowCount = 0, columnCount = 0;
+    double rowEqSec = best_seconds(repeats, [&] {
+        rowCount = 0;
+        board.forEach([&](const PostView& post) { rowCount += post.authorId == authorId; });
+    });
+    double columnEqSec = best_seconds(repeats, [&] {
+        columnCount = 0;
+        board.scanNames(0, board.size(), [&](size_t, size_t count, const uint32_t* ids, const uint32_t*) {
+            for (size_t i = 0; i < count; i++) columnCount += ids[i] == authorId;
+        });
+    });
+    std::printf("  author count rows:   %8.2f ms (%.2f ns/post)\n", rowEqSec * 1e3, rowEqSec * 1e9 / posts);
+    std::printf("  author count column: %8.2f ms (%.2f ns/post)\n", columnEqSec * 1e3, columnEqSec * 1e9 / posts);
+
+    double indexSec = best_seconds(1, [&] {
+        g_serverState.boardIndex.lookup(board, board.size(), author_name(0), "");
+    });
+    std::printf("  index build:         %8.2f ms\n", indexSec * 1e3);
+    return (rowMatches == columnMatches && rowCount == columnCount) ? 0 : 1;
+}
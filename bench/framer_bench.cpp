@@ -0,0 +1,139 @@
+/*
+** Filename: framer_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Throughput benchmark for splitting received bytes into messages.
+**              Feeds the same byte stream, cut into recv()-sized chunks, through the
+**              string-buffer framing (append + find from the start + substr + erase, as
+**              extract_message_from_buffer does) and through MessageFramer, and reports
+**              MB/s for many small pipelined requests and for a few large messages.
+**
+** Usage:   ./build/framer_bench [--chunk=BYTES] [--large-kb=N] [--runs=N]
+** Example: ./build/framer_bench --chunk=4096 --large-kb=4096
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Seconds for the fastest of runs calls to fn
+template <typename Fn>
+static double best_seconds(int runs, Fn&& fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < runs; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+/// @brief Frames stream with the string buffer, chunk bytes per simulated recv()
+/// @return Number of frames (and their total length in bytes, to keep the work observable)
+static size_t frame_with_string(const std::string& stream, size_t chunk, size_t& bytes)
+{
+    std::string buffer, message;
+    size_t frames = 0;
+    bytes = 0;
+    for (size_t offset = 0; offset < stream.size(); offset += chunk)
+    {
+        buffer.append(stream, offset, std::min(chunk, stream.size() - offset));
+        while (extract_message_from_buffer(buffer, transmissionTerminator, message))
+        {
+            frames++;
+            bytes += message.size();
+        }
+    }
+    return frames;
+}
+
+/// @brief Frames stream with MessageFramer, recv() writing straight into its buffer
+static size_t frame_with_framer(const std::string& stream, size_t chunk, size_t& bytes)
+{
+    MessageFramer framer(transmissionTerminator);
+    std::string_view frame;
+    size_t frames = 0;
+    bytes = 0;
+    for (size_t offset = 0; offset < stream.size(); offset += chunk)
+    {
+        size_t length = std::min(chunk, stream.size() - offset);
+        std::memcpy(framer.writeBuffer(length), stream.data() + offset, length);  // Stands in for recv()
+        framer.commit(length);
+        while (framer.next(frame))
+        {
+            frames++;
+            bytes += frame.size();
+        }
+    }
+    return frames;
+}
+
+/// @brief Times both framers on one stream and prints a table row
+static void run_case(const char* name, const std::string& stream, size_t chunk, int runs)
+{
+    size_t stringBytes = 0, framerBytes = 0, stringFrames = 0, framerFrames = 0;
+    double stringSec = best_seconds(runs, [&] { stringFrames = frame_with_string(stream, chunk, stringBytes); });
+    double framerSec = best_seconds(runs, [&] { framerFrames = frame_with_framer(stream, chunk, framerBytes); });
+    if (stringFrames != framerFrames || stringBytes != framerBytes)
+    {
+        std::cerr << name << ": framers disagree (" << stringFrames << " vs " << framerFrames << " frames)" << std::endl;
+        std::exit(1);
+    }
+
+    double mb = stream.size() / 1048576.0;
+    std::printf("  %-34s %8zu %14.1f %14.1f %8.1fx\n", name, framerFrames, mb / stringSec, mb / framerSec, stringSec / framerSec);
+    std::fflush(stdout);
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    size_t chunk = 4096;     // Bytes per simulated recv()
+    size_t largeKb = 4096;   // Size of each large message
+    int runs = 3;            // Each case is timed this many times (best is reported)
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--chunk=", 0) == 0)          chunk = std::max(1UL, std::strtoul(arg.c_str() + 8, nullptr, 10));
+        else if (arg.rfind("--large-kb=", 0) == 0)  largeKb = std::max(1UL, std::strtoul(arg.c_str() + 11, nullptr, 10));
+        else if (arg.rfind("--runs=", 0) == 0)      runs = std::max(1, std::atoi(arg.c_str() + 7));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--chunk=BYTES] [--large-kb=N] [--runs=N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Many small pipelined requests (what a busy client sends back to back)
+    std::string pipelined;
+    for (int i = 0; i < 200000; i++)
+    {
+        pipelined += (i % 2) ? "GET_BOARD}+{Alice}+{}}&{{" : "POST}+{Alice}+{Hello}+{A short message body}}&{{";
+    }
+
+    // A few large POSTs, each arriving over many recv() calls
+    std::string large;
+    for (int i = 0; i < 4; i++)
+    {
+        large += "POST";
+        while (large.size() < (i + 1) * largeKb * 1024) large += "}+{Author}+{Title}+{Some message text here";
+        large += transmissionTerminator;
+    }
+
+    std::printf("chunk=%zu bytes per recv()\n", chunk);
+    std::printf("  %-34s %8s %14s %14s %9s\n", "stream", "frames", "string MB/s", "framer MB/s", "speedup");
+    run_case("pipelined small requests", pipelined, chunk, runs);
+    run_case(("large messages (" + std::to_string(largeKb) + " KB each)").c_str(), large, chunk, runs);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*
+** Filename: intern_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Board memory and filtered GET_BOARD benchmark.
+**              Appends a synthetic board (10M posts by default) whose authors and titles
+**              repeat like real boards, and reports resident bytes per post, the time to
+**              build the author/title index (the first filtered GET_BOARD), filtered
+**              GET_BOARD time, and a full-board equality scan on the author.
+**
+** Usage:   ./build/intern_bench [--posts=N] [--authors=N] [--titles=N]
+** Example: ./build/intern_bench --posts=10000000 --authors=100 --titles=50
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Resident set size of this process in bytes
+static size_t resident_bytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/// @brief Seconds taken by fn()
+template <typename Fn>
+static double seconds(Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string author_name(size_t i) { return "Author number " + std::to_string(i); }
+static std::string title_name(size_t i)  { return "Discussion topic " + std::to_string(i); }
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    size_t posts = 10000000;  // Board size
+    size_t authors = 100;     // Distinct authors
+    size_t titles = 50;       // Distinct titles
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--posts=", 0) == 0)         posts = std::max(1L, std::atol(arg.c_str() + 8));
+        else if (arg.rfind("--authors=", 0) == 0)  authors = std::max(1L, std::atol(arg.c_str() + 10));
+        else if (arg.rfind("--titles=", 0) == 0)   titles = std::max(1L, std::atol(arg.c_str() + 9));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--posts=N] [--authors=N] [--titles=N]" << std::endl;
+            return 1;
+        }
+    }
+
+    BoardStore& board = g_serverState.messageBoard;
+    board.clear();
+
+    // ====================================================================
+    // BUILD: append in POST-sized batches and measure what the board costs
+    // ====================================================================
+    size_t residentBefore = resident_bytes();
+    double appendSec = seconds([&] {
+        std::vector<Post> batch;
+        for (size_t i = 0; i < posts; i++)
+        {
+            batch.push_back(Post{author_name(i % authors), title_name((i / authors) % titles),
+                                 "Message body number " + std::to_string(i)});
+            if (batch.size() == 1024 || i + 1 == posts)
+            {
+                board.append(std::move(batch));
+                batch.clear();
+            }
+        }
+    });
+    size_t boardBytes = resident_bytes() - residentBefore;
+    std::printf("posts=%zu authors=%zu titles=%zu\n", posts, authors, titles);
+    std::printf("  append:            %8.2f s  (%.0f posts/s)\n", appendSec, posts / appendSec);
+    std::printf("  resident:          %8.1f MiB (%.1f bytes/post)\n", boardBytes / 1048576.0,
+                (double)boardBytes / posts);
+    std::fflush(stdout);
+
+    // ====================================================================
+    // FILTERS: index build, indexed GET_BOARD and a full equality scan
+    // ====================================================================
+    const std::string author = author_name(authors / 2);
+    const std::string title = title_name(titles / 2);
+    size_t residentIndexed = resident_bytes();
+    double indexSec = seconds([&] { g_serverState.boardIndex.lookup(board, board.size(), author, ""); });
+    std::printf("  index build:       %8.2f s  (+%.1f MiB)\n", indexSec,
+                (resident_bytes() - residentIndexed) / 1048576.0);
+
+    const int repeats = 20;
+    size_t responseBytes = 0;
+    double authorSec = seconds([&] {
+        for (int r = 0; r < repeats; r++) responseBytes += get_board_handler(author, "").size();
+    }) / repeats;
+    double bothSec = seconds([&] {
+        for (int r = 0; r < repeats; r++) responseBytes += get_board_handler(author, title).size();
+    }) / repeats;
+    std::printf("  GET_BOARD author:  %8.2f ms\n", authorSec * 1e3);
+    std::printf("  GET_BOARD a+t:     %8.3f ms\n", bothSec * 1e3);
+
+    // What a filter costs without the index: compare every post's author with the filter
+    uint32_t authorId = board.names().find(author);
+    size_t matches = 0;
+    double scanSec = seconds([&] {
+        board.forEach([&](const PostView& post) {
+            matches += (post.authorId != NO_STRING_ID) ? post.authorId == authorId : post.author == author;
+        });
+    });
+    std::printf("  author scan:       %8.2f ms (%zu matches, %.1f ns/post)\n", scanSec * 1e3, matches,
+                scanSec * 1e9 / posts);
+    if (responseBytes == 0) return 1;
+    return 0;
+}
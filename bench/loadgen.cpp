@@ -0,0 +1,480 @@
+/*
+** Filename: loadgen.cpp
+** Project: Computer Networks Assignment 3
+** Description: Wire-protocol load generator.
+**              Opens N connections spread over a few threads (each thread runs its own
+**              epoll loop over non-blocking sockets) and drives a POST / GET_BOARD mix with
+**              a configurable POST batch size and pipelining depth. Closed loop (default):
+**              every connection keeps `depth` requests outstanding. Open loop (--rate):
+**              requests are due at a fixed total rate, uniformly spaced or Poisson, and
+**              latency is measured from when a request was due, not when it could be sent,
+**              so a stalled server shows up in the percentiles (no coordinated omission).
+**              Reports throughput and HDR-histogram latency percentiles per request type.
+**              Without --target the server is started in-process; server options (--io,
+**              --loops, --port, --handlers, --wal-sync, ...) are passed through to it.
+**
+** Usage:   ./build/loadgen [--target=HOST:PORT] [--connections=N] [--threads=N]
+**                          [--duration=S] [--warmup=S] [--rate=N] [--arrival=uniform|poisson]
+**                          [--depth=N] [--get-percent=N] [--get-filter=author|none]
+**                          [--batch=N] [--message-bytes=N] [--authors=N] [--format=text|csv]
+**                          [server options]
+** Example: ./build/loadgen --io=epoll --connections=64 --depth=4 --get-percent=20 --rate=50000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <netdb.h>
+#include <netinet/tcp.h>
+#include <random>
+
+#include "../server.cpp"          // Server implementation (built with -DUNIT_TEST, no main())
+#include "../latency_histogram.h"
+
+// ============================================================================
+// LOAD GENERATOR OPTIONS
+// ============================================================================
+
+/// @brief What to send, how fast and where
+struct LoadOptions {
+    std::string host = "127.0.0.1";
+    int port = 0;                   // 0 = start the server in-process on config.port
+    int connections = 8;
+    int threads = 0;                // 0 = min(connections, hardware threads)
+    double duration = 5.0;          // Measured seconds
+    double warmup = 1.0;            // Seconds of load before measuring
+    double rate = 0;                // Total requests/sec (0 = closed loop)
+    bool poisson = false;           // Open loop: exponential gaps instead of uniform ones
+    int depth = 1;                  // Requests outstanding per connection
+    int getPercent = 10;            // Share of requests that are GET_BOARD
+    bool getByAuthor = true;        // GET_BOARD filtered by one author (else the whole board)
+    int batch = 1;                  // Posts per POST request
+    int messageBytes = 64;          // Message body size
+    int authors = 100;              // Distinct authors posted and filtered on
+    bool csv = false;
+};
+
+/// @brief Current steady-clock time in nanoseconds
+static int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ============================================================================
+// PER-THREAD CONNECTION LOOP
+// ============================================================================
+
+/// @brief A request waiting for its reply (the server answers each connection in order)
+struct Outstanding {
+    int64_t due;   // When the request was due (latency is measured from here)
+    bool post;
+};
+
+/// @brief One client connection driven by a load thread
+struct LoadConnection {
+    int socket = -1;
+    MessageFramer framer{transmissionTerminator};
+    std::string out;                      // Requests not yet accepted by the kernel
+    size_t outPos = 0;
+    bool writeArmed = false;              // EPOLLOUT requested
+    std::deque<Outstanding> inflight;
+    int64_t nextDue = 0;                  // Open loop: when the next request is due
+};
+
+/// @brief Results of one load thread (merged by main)
+struct LoadResults {
+    LatencyHistogram postLatency, getLatency;
+    uint64_t posts = 0;          // Posts carried by measured POSTs
+    uint64_t errors = 0;         // POST_ERROR / INVALID_COMMAND replies and dropped connections
+    uint64_t late = 0;           // Open loop: requests still unsent when the run ended
+    uint64_t unanswered = 0;     // Measured requests without a reply at the end
+    uint64_t bytesOut = 0, bytesIn = 0;
+};
+
+/// @brief Opens a non-blocking TCP connection
+static int connect_to(const sockaddr_in& addr)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock == -1) return -1;
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(sock, (const sockaddr*)&addr, sizeof(addr)) == -1)
+    {
+        close(sock);
+        return -1;
+    }
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+    return sock;
+}
+
+/// @brief Drives a share of the connections until stopAt, recording requests due in [measureFrom, measureTo)
+static void load_thread(const LoadOptions& options, const sockaddr_in& addr, int connections, int threadIndex,
+                        int64_t measureFrom, int64_t measureTo, LoadResults& results)
+{
+    std::mt19937_64 rng(0x9E3779B97F4A7C15ull * (threadIndex + 1));
+    double perConnectionRate = options.rate / options.connections;
+    std::exponential_distribution<double> poissonGap(perConnectionRate > 0 ? perConnectionRate / 1e9 : 1.0);
+    auto gap = [&]() -> int64_t {
+        if (options.poisson) return std::max<int64_t>(1, (int64_t)poissonGap(rng));
+        return std::max<int64_t>(1, (int64_t)(1e9 / perConnectionRate));
+    };
+
+    int epfd = epoll_create1(0);
+    std::vector<LoadConnection> conns(connections);
+    for (int c = 0; c < connections; c++)
+    {
+        conns[c].socket = connect_to(addr);
+        if (conns[c].socket == -1)
+        {
+            results.errors++;
+            continue;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u32 = (uint32_t)c;
+        epoll_ctl(epfd, EPOLL_CTL_ADD, conns[c].socket, &ev);
+        // Stagger open-loop schedules so connections do not fire in lockstep
+        conns[c].nextDue = now_ns() + (perConnectionRate > 0 ? (int64_t)(rng() % (uint64_t)gap()) : 0);
+    }
+
+    const std::string body(std::max(1, options.messageBytes), 'm');
+    uint64_t sequence = 0;
+    auto enqueue = [&](LoadConnection& conn, int64_t due) {
+        bool post = (int)(rng() % 100) >= options.getPercent;
+        std::string& out = conn.out;
+        if (post)
+        {
+            out += "POST";
+            for (int b = 0; b < options.batch; b++)
+            {
+                out += b == 0 ? fieldDelimiter : messageSeperator;
+                out += "Author " + std::to_string(rng() % options.authors);
+                out += fieldDelimiter;
+                out += "Load test";
+                out += fieldDelimiter;
+                out += std::to_string(sequence++);
+                out += body;
+            }
+        }
+        else
+        {
+            out += "GET_BOARD";
+            if (options.getByAuthor) out += fieldDelimiter + "Author " + std::to_string(rng() % options.authors);
+        }
+        out += transmissionTerminator;
+        conn.inflight.push_back(Outstanding{due, post});
+    };
+    auto closeConnection = [&](LoadConnection& conn) {
+        epoll_ctl(epfd, EPOLL_CTL_DEL, conn.socket, nullptr);
+        close(conn.socket);
+        conn.socket = -1;
+        results.errors++;
+    };
+    auto flush = [&](LoadConnection& conn, uint32_t index) {
+        while (conn.outPos < conn.out.size())
+        {
+            ssize_t sent = send(conn.socket, conn.out.data() + conn.outPos, conn.out.size() - conn.outPos, MSG_NOSIGNAL);
+            if (sent > 0)
+            {
+                conn.outPos += (size_t)sent;
+                results.bytesOut += (uint64_t)sent;
+                continue;
+            }
+            if (sent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            closeConnection(conn);
+            return;
+        }
+        bool pending = conn.outPos < conn.out.size();
+        if (!pending)
+        {
+            conn.out.clear();
+            conn.outPos = 0;
+        }
+        if (pending != conn.writeArmed)
+        {
+            epoll_event ev{};
+            ev.events = pending ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+            ev.data.u32 = index;
+            epoll_ctl(epfd, EPOLL_CTL_MOD, conn.socket, &ev);
+            conn.writeArmed = pending;
+        }
+    };
+    auto receive = [&](LoadConnection& conn) {
+        while (conn.socket != -1)
+        {
+            char* buffer = conn.framer.writeBuffer(64 * 1024);
+            ssize_t received = recv(conn.socket, buffer, 64 * 1024, 0);
+            if (received == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (received <= 0)
+            {
+                closeConnection(conn);
+                break;
+            }
+            conn.framer.commit((size_t)received);
+            results.bytesIn += (uint64_t)received;
+            int64_t now = now_ns();
+            std::string_view frame;
+            while (conn.framer.next(frame) && !conn.inflight.empty())
+            {
+                Outstanding request = conn.inflight.front();
+                conn.inflight.pop_front();
+                if (request.due < measureFrom || request.due >= measureTo) continue;
+                if (frame.rfind("POST_ERROR", 0) == 0 || frame.rfind("INVALID_COMMAND", 0) == 0)
+                {
+                    results.errors++;
+                    continue;
+                }
+                if (request.post)
+                {
+                    results.postLatency.record((uint64_t)(now - request.due));
+                    results.posts += (uint64_t)options.batch;
+                }
+                else
+                {
+                    results.getLatency.record((uint64_t)(now - request.due));
+                }
+            }
+        }
+    };
+
+    std::vector<epoll_event> events(std::max(1, connections));
+    const int64_t drainUntil = measureTo + 2000000000LL;  // Replies to measured requests may still arrive
+    while (true)
+    {
+        int64_t now = now_ns();
+        bool sending = now < measureTo;
+        bool waiting = false;
+        int64_t wakeAt = now + 100000000LL;
+        for (int c = 0; c < connections; c++)
+        {
+            LoadConnection& conn = conns[c];
+            if (conn.socket == -1) continue;
+            if (sending)
+            {
+                size_t before = conn.inflight.size();
+                if (perConnectionRate <= 0)
+                {
+                    while ((int)conn.inflight.size() < options.depth) enqueue(conn, now);
+                }
+                else
+                {
+                    // Requests due while the window is full wait here; their latency keeps counting
+                    while (conn.nextDue <= now && (int)conn.inflight.size() < options.depth)
+                    {
+                        enqueue(conn, conn.nextDue);
+                        conn.nextDue += gap();
+                    }
+                    wakeAt = std::min(wakeAt, conn.nextDue);
+                }
+                if (conn.inflight.size() != before) flush(conn, (uint32_t)c);
+            }
+            if (conn.socket != -1 && !conn.inflight.empty()) waiting = true;
+        }
+        if (!sending && (!waiting || now >= drainUntil)) break;
+
+        timespec timeout{};
+        int64_t waitNs = std::max<int64_t>(0, (sending ? wakeAt : drainUntil) - now);
+        timeout.tv_sec = waitNs / 1000000000LL;
+        timeout.tv_nsec = waitNs % 1000000000LL;
+        int ready = epoll_pwait2(epfd, events.data(), (int)events.size(), &timeout, nullptr);
+        for (int i = 0; i < ready; i++)
+        {
+            LoadConnection& conn = conns[events[i].data.u32];
+            if (conn.socket == -1) continue;
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) receive(conn);
+            if (conn.socket != -1 && (events[i].events & EPOLLOUT)) flush(conn, events[i].data.u32);
+        }
+    }
+
+    for (LoadConnection& conn : conns)
+    {
+        if (perConnectionRate > 0 && conn.socket != -1)
+        {
+            // Open loop: requests that came due but never fit in the window
+            for (int64_t due = conn.nextDue; due < measureTo; due += gap()) results.late++;
+        }
+        for (const Outstanding& request : conn.inflight)
+        {
+            if (request.due >= measureFrom && request.due < measureTo) results.unanswered++;
+        }
+        if (conn.socket != -1) close(conn.socket);
+    }
+    close(epfd);
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+/// @brief Prints one latency row (microseconds)
+static void print_row(const char* name, const LatencyHistogram& h, double seconds, bool csv)
+{
+    if (csv)
+    {
+        std::printf("%s,%llu,%.0f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", name, (unsigned long long)h.count(),
+                    h.count() / seconds, h.mean() / 1e3, h.percentile(50) / 1e3, h.percentile(90) / 1e3,
+                    h.percentile(99) / 1e3, h.percentile(99.9) / 1e3, h.percentile(99.99) / 1e3, h.max() / 1e3);
+        return;
+    }
+    std::printf("  %-10s %10llu %10.0f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", name,
+                (unsigned long long)h.count(), h.count() / seconds, h.mean() / 1e3, h.percentile(50) / 1e3,
+                h.percentile(90) / 1e3, h.percentile(99) / 1e3, h.percentile(99.9) / 1e3,
+                h.percentile(99.99) / 1e3, h.max() / 1e3);
+}
+
+// ============================================================================
+// LOAD GENERATOR ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    LoadOptions options;
+    std::vector<char*> serverArgs{argv[0]};
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        auto value = [&](const char* key) { return arg.substr(std::strlen(key)); };
+        if (arg.rfind("--target=", 0) == 0)
+        {
+            std::string target = value("--target=");
+            size_t colon = target.rfind(':');
+            options.host = colon == std::string::npos ? target : target.substr(0, colon);
+            options.port = colon == std::string::npos ? 26500 : std::atoi(target.c_str() + colon + 1);
+        }
+        else if (arg.rfind("--connections=", 0) == 0)    options.connections = std::max(1, std::atoi(value("--connections=").c_str()));
+        else if (arg.rfind("--threads=", 0) == 0)        options.threads = std::max(1, std::atoi(value("--threads=").c_str()));
+        else if (arg.rfind("--duration=", 0) == 0)       options.duration = std::max(0.1, std::atof(value("--duration=").c_str()));
+        else if (arg.rfind("--warmup=", 0) == 0)         options.warmup = std::max(0.0, std::atof(value("--warmup=").c_str()));
+        else if (arg.rfind("--rate=", 0) == 0)           options.rate = std::max(0.0, std::atof(value("--rate=").c_str()));
+        else if (arg == "--arrival=uniform")             options.poisson = false;
+        else if (arg == "--arrival=poisson")             options.poisson = true;
+        else if (arg.rfind("--depth=", 0) == 0)          options.depth = std::max(1, std::atoi(value("--depth=").c_str()));
+        else if (arg.rfind("--get-percent=", 0) == 0)    options.getPercent = std::min(100, std::max(0, std::atoi(value("--get-percent=").c_str())));
+        else if (arg == "--get-filter=author")           options.getByAuthor = true;
+        else if (arg == "--get-filter=none")             options.getByAuthor = false;
+        else if (arg.rfind("--batch=", 0) == 0)          options.batch = std::max(1, std::atoi(value("--batch=").c_str()));
+        else if (arg.rfind("--message-bytes=", 0) == 0)  options.messageBytes = std::max(1, std::atoi(value("--message-bytes=").c_str()));
+        else if (arg.rfind("--authors=", 0) == 0)        options.authors = std::max(1, std::atoi(value("--authors=").c_str()));
+        else if (arg == "--format=text" || arg == "--format=csv") options.csv = (arg == "--format=csv");
+        else serverArgs.push_back(argv[i]);
+    }
+
+    // In-process server: measure request handling, not snapshots; the log syncs as configured
+    // (--wal-sync=... passes through, default none so the disk does not dominate)
+    std::string mode = "external";
+    if (options.port == 0)
+    {
+        ServerConfig& config = g_serverState.config;
+        config.postLog.durability = LogDurability::NONE;
+        config.snapshotIntervalSec = 0;
+        std::string errorDetails;
+        if (!parse_server_args((int)serverArgs.size(), serverArgs.data(), config, errorDetails))
+        {
+            std::cerr << errorDetails << std::endl;
+            std::cerr << "Load generator options: [--target=HOST:PORT] [--connections=N] [--threads=N] [--duration=S]"
+                         " [--warmup=S] [--rate=N] [--arrival=uniform|poisson] [--depth=N] [--get-percent=N]"
+                         " [--get-filter=author|none] [--batch=N] [--message-bytes=N] [--authors=N]"
+                         " [--format=text|csv]" << std::endl;
+            return 1;
+        }
+        options.port = config.port;
+        mode = config.ioMode == IoMode::EPOLL ? "in-process epoll" :
+               config.ioMode == IoMode::IO_URING ? "in-process uring" : "in-process threads";
+        std::thread(server_run_loop).detach();
+    }
+    else if (serverArgs.size() > 1)
+    {
+        std::cerr << "Server options cannot be used with --target: " << serverArgs[1] << std::endl;
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)options.port);
+    addrinfo hints{}, *resolved = nullptr;
+    hints.ai_family = AF_INET;
+    if (getaddrinfo(options.host.c_str(), nullptr, &hints, &resolved) != 0 || resolved == nullptr)
+    {
+        std::cerr << "Cannot resolve " << options.host << std::endl;
+        return 1;
+    }
+    addr.sin_addr = ((sockaddr_in*)resolved->ai_addr)->sin_addr;
+    freeaddrinfo(resolved);
+
+    // Wait for the server to accept connections
+    int probe = -1;
+    for (int attempt = 0; attempt < 100 && probe == -1; attempt++)
+    {
+        probe = connect_to(addr);
+        if (probe == -1) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    if (probe == -1)
+    {
+        std::cerr << "No server on " << options.host << ":" << options.port << std::endl;
+        return 1;
+    }
+    close(probe);
+
+    int threads = options.threads > 0 ? options.threads
+                                      : std::max(1, std::min<int>(options.connections, (int)std::thread::hardware_concurrency()));
+    threads = std::min(threads, options.connections);
+    int64_t measureFrom = now_ns() + (int64_t)(options.warmup * 1e9);
+    int64_t measureTo = measureFrom + (int64_t)(options.duration * 1e9);
+    std::vector<LoadResults> results(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        int share = options.connections / threads + (t < options.connections % threads ? 1 : 0);
+        workers.emplace_back(load_thread, std::cref(options), std::cref(addr), share, t, measureFrom, measureTo,
+                             std::ref(results[t]));
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    LoadResults total;
+    for (const LoadResults& r : results)
+    {
+        total.postLatency.merge(r.postLatency);
+        total.getLatency.merge(r.getLatency);
+        total.posts += r.posts;
+        total.errors += r.errors;
+        total.late += r.late;
+        total.unanswered += r.unanswered;
+        total.bytesOut += r.bytesOut;
+        total.bytesIn += r.bytesIn;
+    }
+    LatencyHistogram all;
+    all.merge(total.postLatency);
+    all.merge(total.getLatency);
+
+    double seconds = options.duration;
+    if (options.csv)
+    {
+        std::printf("type,count,per_sec,mean_us,p50_us,p90_us,p99_us,p999_us,p9999_us,max_us\n");
+        print_row("POST", total.postLatency, seconds, true);
+        print_row("GET_BOARD", total.getLatency, seconds, true);
+        print_row("all", all, seconds, true);
+    }
+    else
+    {
+        std::string load = options.rate <= 0 ? "closed-loop" :
+                           std::to_string((long)options.rate) + "/s " + (options.poisson ? "poisson" : "uniform");
+        std::printf("target=%s:%d (%s) connections=%d threads=%d depth=%d load=%s get=%d%% batch=%d message=%dB\n",
+                    options.host.c_str(), options.port, mode.c_str(), options.connections, threads, options.depth,
+                    load.c_str(), options.getPercent, options.batch, options.messageBytes);
+        std::printf("  %.1f s: %llu requests (%.0f req/s), %.0f posts/s, %.1f MB/s out, %.1f MB/s in\n", seconds,
+                    (unsigned long long)all.count(), all.count() / seconds, total.posts / seconds,
+                    total.bytesOut / seconds / 1e6, total.bytesIn / seconds / 1e6);
+        std::printf("  errors=%llu unanswered=%llu late=%llu\n", (unsigned long long)total.errors,
+                    (unsigned long long)total.unanswered, (unsigned long long)total.late);
+        std::printf("  %-10s %10s %10s %9s %9s %9s %9s %9s %9s %9s   (latency in us)\n", "type", "count", "req/s",
+                    "mean", "p50", "p90", "p99", "p99.9", "p99.99", "max");
+        print_row("POST", total.postLatency, seconds, false);
+        print_row("GET_BOARD", total.getLatency, seconds, false);
+        print_row("all", all, seconds, false);
+    }
+    std::fflush(stdout);
+
+    // An in-process server's detached threads are still running; skip static destructors
+    std::_Exit(total.errors == 0 ? 0 : 2);
+}
@@ -0,0 +1,484 @@
+/*
+** Filename: microbench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Microbenchmark harness for the request path, one function at a time.
+**              Times parse_message, split_fields_until, read_message_until_terminator and
+**              receive_until_message (the MessageFramer path) over a socketpair,
+**              get_board_handler, post_handler and logEvent in isolation, over a grid of
+**              message sizes, posts per batch, board sizes, filter selectivities and caller
+**              threads. Each case is calibrated to run for --min-time seconds, then
+**              repeated; the median ns/op (with min/max over the repetitions), items/s and
+**              MB/s are reported. CSV output is stable across commits, and --baseline=FILE
+**              prints the change against an earlier CSV run, so a regression shows up as a
+**              diff.
+**
+** Usage:   ./build/microbench [--filter=TEXT] [--list] [--min-time=S] [--repetitions=N]
+**                             [--message-bytes=N,...] [--batch=N,...] [--board=N,...]
+**                             [--selectivity=PCT,...] [--threads=N,...] [--format=text|csv]
+**                             [--baseline=FILE]
+** Example: ./build/microbench --format=csv > before.csv && ./build/microbench --baseline=before.csv
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// HARNESS
+// ============================================================================
+
+/// @brief Keeps the compiler from discarding a result the benchmark does not otherwise use
+template <typename T>
+static void keep(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// @brief One benchmark: a named operation and what it processes per call
+struct BenchCase {
+    std::string name;                        // "function/param:value/..." (the key --baseline matches on)
+    double items = 1;                        // Posts/messages handled per operation
+    double bytes = 0;                        // Input bytes per operation (0 = no MB/s column)
+    size_t retainedBytes = 0;                // Memory each operation keeps (caps the iteration count)
+    std::function<void()> setup;             // Untimed, before every timed repetition
+    std::function<void(uint64_t)> body;      // Runs the operation n times
+};
+
+/// @brief Result of one case (ns/op over the repetitions)
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;     // Per repetition
+    double nsMedian = 0, nsMin = 0, nsMax = 0;
+    double itemsPerSec = 0, mbPerSec = 0;
+};
+
+/// @brief Harness settings and parameter grid
+struct BenchOptions {
+    double minTime = 0.1;                    // Seconds per repetition
+    int repetitions = 5;
+    std::string filter;                      // Run only cases whose name contains this
+    bool list = false;
+    bool csv = false;
+    std::string baseline;                    // Earlier CSV output to compare against
+    size_t memoryBudget = (size_t)256 << 20; // Bytes a repetition may retain (post_handler grows the board)
+    std::vector<size_t> messageBytes{16, 256, 4096};
+    std::vector<size_t> batches{1, 10, 100};
+    std::vector<size_t> boardSizes{1000, 100000};
+    std::vector<double> selectivities{100, 10, 1};  // Percent of the board an author filter matches
+    std::vector<size_t> threads{1, 4};               // Concurrent callers (logEvent)
+};
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Calibrates, then times the case's repetitions
+static BenchResult run_case(const BenchCase& c, const BenchOptions& options)
+{
+    uint64_t limit = c.retainedBytes > 0 ? std::max<uint64_t>(1, options.memoryBudget / c.retainedBytes) : UINT64_MAX;
+
+    // Grow the iteration count until one repetition takes --min-time (or hits the memory cap)
+    uint64_t iterations = 1;
+    while (true)
+    {
+        if (c.setup) c.setup();
+        auto start = std::chrono::steady_clock::now();
+        c.body(iterations);
+        double elapsed = seconds_since(start);
+        if (elapsed >= options.minTime || iterations >= limit) break;
+        double scale = elapsed > 0 ? 1.4 * options.minTime / elapsed : 100.0;
+        iterations = std::min(limit, (uint64_t)(iterations * std::min(100.0, std::max(2.0, scale))));
+    }
+
+    std::vector<double> ns;
+    for (int r = 0; r < options.repetitions; r++)
+    {
+        if (c.setup) c.setup();
+        auto start = std::chrono::steady_clock::now();
+        c.body(iterations);
+        ns.push_back(seconds_since(start) * 1e9 / (double)iterations);
+    }
+    std::sort(ns.begin(), ns.end());
+
+    BenchResult result;
+    result.name = c.name;
+    result.iterations = iterations;
+    result.nsMedian = ns[ns.size() / 2];
+    result.nsMin = ns.front();
+    result.nsMax = ns.back();
+    result.itemsPerSec = c.items * 1e9 / result.nsMedian;
+    result.mbPerSec = c.bytes > 0 ? c.bytes * 1e3 / result.nsMedian : 0;
+    return result;
+}
+
+/// @brief name -> ns/op from an earlier --format=csv run
+static std::map<std::string, double> read_baseline(const std::string& path)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);  // Header
+    while (std::getline(in, line))
+    {
+        std::stringstream row(line);
+        std::string name, iterations, nsPerOp;
+        if (std::getline(row, name, ',') && std::getline(row, iterations, ',') && std::getline(row, nsPerOp, ','))
+        {
+            baseline[name] = std::atof(nsPerOp.c_str());
+        }
+    }
+    return baseline;
+}
+
+/// @brief Parses "a,b,c" into numbers
+template <typename T>
+static std::vector<T> parse_list(const std::string& text)
+{
+    std::vector<T> values;
+    std::stringstream list(text);
+    std::string value;
+    while (std::getline(list, value, ','))
+    {
+        if (!value.empty()) values.push_back((T)std::atof(value.c_str()));
+    }
+    return values;
+}
+
+// ============================================================================
+// INPUTS
+// ============================================================================
+
+/// @brief A POST request of batch posts with messageBytes-byte messages (terminator included)
+static std::string make_post_request(size_t batch, size_t messageBytes)
+{
+    std::string request = "POST";
+    for (size_t i = 0; i < batch; i++)
+    {
+        request += i == 0 ? fieldDelimiter : messageSeperator;
+        request += "Author " + std::to_string(i % 100);
+        request += fieldDelimiter;
+        request += "Benchmark title";
+        request += fieldDelimiter;
+        request += std::string(messageBytes, 'a' + (char)(i % 26));
+    }
+    return request + transmissionTerminator;
+}
+
+/// @brief Makes the board hold posts posts whose authors cycle through authors names
+/// Kept when the board already has that layout (other cases may have cleared it)
+static void fill_board(size_t posts, size_t authors)
+{
+    static size_t filledAuthors = 0;
+    BoardStore& board = g_serverState.messageBoard;
+    if (board.size() == posts && filledAuthors == authors) return;
+    filledAuthors = authors;
+    board.clear();
+    std::vector<Post> batch;
+    for (size_t i = 0; i < posts; i++)
+    {
+        batch.push_back(Post{"Author " + std::to_string(i % authors), "Title " + std::to_string(i % 50),
+                             std::string(64, 'm')});
+        if (batch.size() == 1024 || i + 1 == posts)
+        {
+            board.append(std::move(batch));
+            batch.clear();
+        }
+    }
+}
+
+/// @brief Writes all of data to a socket (the reader drains it in the same thread)
+static void write_all(int socket, const std::string& data)
+{
+    for (size_t sent = 0; sent < data.size();)
+    {
+        ssize_t n = send(socket, data.data() + sent, data.size() - sent, 0);
+        if (n <= 0) std::abort();
+        sent += (size_t)n;
+    }
+}
+
+// ============================================================================
+// BENCHMARK CASES
+// ============================================================================
+
+static std::vector<BenchCase> make_cases(const BenchOptions& options)
+{
+    std::vector<BenchCase> cases;
+    auto param = [](double value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%g", value);
+        return std::string(text);
+    };
+
+    // Parsing: a POST batch, with the per-connection arena the request path uses
+    for (size_t messageBytes : options.messageBytes)
+    {
+        for (size_t batch : options.batches)
+        {
+            auto request = std::make_shared<std::string>(make_post_request(batch, messageBytes));
+            auto arena = std::make_shared<RequestArena>();
+            std::string suffix = "/message_bytes:" + param((double)messageBytes) + "/batch:" + param((double)batch);
+
+            BenchCase parse;
+            parse.name = "parse_message" + suffix;
+            parse.items = (double)batch;
+            parse.bytes = (double)request->size();
+            parse.body = [request, arena](uint64_t n) {
+                for (uint64_t i = 0; i < n; i++)
+                {
+                    {
+                        ParseResult result = parse_message(*request, fieldDelimiter, messageSeperator,
+                                                           transmissionTerminator, arena->resource());
+                        keep(result.posts.size());
+                    }
+                    arena->reset();
+                }
+            };
+            cases.push_back(std::move(parse));
+
+            BenchCase split;
+            split.name = "split_fields_until" + suffix;
+            split.items = (double)batch;
+            split.bytes = (double)request->size();
+            split.body = [request](uint64_t n) {
+                size_t end = request->size() - transmissionTerminator.size();
+                for (uint64_t i = 0; i < n; i++) keep(split_fields_until(*request, fieldDelimiter, end).size());
+            };
+            cases.push_back(std::move(split));
+        }
+    }
+
+    // Framing: one request written into a socketpair and read back out (send() included)
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0)
+    {
+        auto pair = std::shared_ptr<int>(new int[2]{sockets[0], sockets[1]}, [](int* fds) {
+            close(fds[0]);
+            close(fds[1]);
+            delete[] fds;
+        });
+        for (size_t messageBytes : options.messageBytes)
+        {
+            auto request = std::make_shared<std::string>(make_post_request(1, messageBytes));
+            std::string suffix = "/message_bytes:" + param((double)messageBytes);
+
+            BenchCase legacy;
+            legacy.name = "read_message_until_terminator" + suffix;
+            legacy.bytes = (double)request->size();
+            legacy.body = [request, pair](uint64_t n) {
+                std::string buffer, message;
+                for (uint64_t i = 0; i < n; i++)
+                {
+                    write_all(pair.get()[0], *request);
+                    if (!read_message_until_terminator(pair.get()[1], buffer, transmissionTerminator, message)) std::abort();
+                    keep(message.size());
+                }
+            };
+            cases.push_back(std::move(legacy));
+
+            BenchCase framer;
+            framer.name = "receive_until_message" + suffix;
+            framer.bytes = (double)request->size();
+            framer.body = [request, pair](uint64_t n) {
+                MessageFramer messages(transmissionTerminator);
+                std::string_view message;
+                for (uint64_t i = 0; i < n; i++)
+                {
+                    write_all(pair.get()[0], *request);
+                    if (!receive_until_message(pair.get()[1], messages) || !messages.next(message)) std::abort();
+                    keep(message.size());
+                }
+            };
+            cases.push_back(std::move(framer));
+        }
+    }
+
+    // GET_BOARD: the whole board, and an author filter matching --selectivity percent of it
+    for (size_t boardSize : options.boardSizes)
+    {
+        std::string prefix = "get_board_handler/board:" + param((double)boardSize);
+        BenchCase all;
+        all.name = prefix + "/filter:none";
+        all.items = (double)boardSize;
+        all.setup = [boardSize] { fill_board(boardSize, 1); };
+        all.body = [](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++) keep(get_board_handler("", "").size());
+        };
+        cases.push_back(std::move(all));
+
+        for (double selectivity : options.selectivities)
+        {
+            size_t authors = std::max<size_t>(1, (size_t)(100.0 / selectivity + 0.5));
+            BenchCase filtered;
+            filtered.name = prefix + "/selectivity:" + param(selectivity);
+            filtered.items = (double)((boardSize + authors - 1) / authors);
+            filtered.setup = [boardSize, authors] {
+                fill_board(boardSize, authors);
+                get_board_handler("Author 0", "");  // Builds the author index outside the timing
+            };
+            filtered.body = [](uint64_t n) {
+                for (uint64_t i = 0; i < n; i++) keep(get_board_handler("Author 0", "").size());
+            };
+            cases.push_back(std::move(filtered));
+        }
+    }
+
+    // POST: a parsed batch published to the board (indexes included, post log off)
+    for (size_t messageBytes : options.messageBytes)
+    {
+        for (size_t batch : options.batches)
+        {
+            auto request = std::make_shared<std::string>(make_post_request(batch, messageBytes));
+            auto parsed = std::make_shared<ParseResult>(
+                parse_message(*request, fieldDelimiter, messageSeperator, transmissionTerminator));
+            BenchCase post;
+            post.name = "post_handler/message_bytes:" + param((double)messageBytes) + "/batch:" + param((double)batch);
+            post.items = (double)batch;
+            post.bytes = (double)request->size();
+            post.retainedBytes = batch * (2 * messageBytes + 256);  // Board copy plus index entries
+            post.setup = [] { g_serverState.messageBoard.clear(); };
+            post.body = [request, parsed](uint64_t n) {
+                std::string errorDetails;
+                for (uint64_t i = 0; i < n; i++)
+                {
+                    if (!post_handler(*parsed, errorDetails, 1)) std::abort();
+                }
+            };
+            cases.push_back(std::move(post));
+        }
+    }
+    // Event log: what every request pays to log itself (raw = the request as received), with the
+    // GUI's Event Log tab hidden (raw payload dropped) and shown (raw payload copied)
+    for (size_t messageBytes : options.messageBytes)
+    {
+        for (size_t threads : options.threads)
+        {
+            for (bool shown : {false, true})
+            {
+                auto raw = std::make_shared<std::string>(make_post_request(1, messageBytes));
+                BenchCase log;
+                log.name = "logEvent/raw_bytes:" + param((double)raw->size()) + "/threads:" + param((double)threads) +
+                           (shown ? "/raw:shown" : "/raw:hidden");
+                log.setup = [shown] { g_serverState.eventLog.setRawVisible(shown); };
+                log.body = [raw, threads](uint64_t n) {
+                    auto run = [&](uint64_t calls) {
+                        for (uint64_t i = 0; i < calls; i++)
+                        {
+                            g_serverState.logEventf("POST", "Client posted %lld message(s) (socket: %lld)", 1,
+                                                    (long long)(i % 1000), *raw);
+                        }
+                    };
+                    std::vector<std::thread> callers;
+                    for (size_t t = 1; t < threads; t++) callers.emplace_back(run, n / threads);
+                    run(n - (n / threads) * (threads - 1));
+                    for (std::thread& caller : callers) caller.join();
+                };
+                cases.push_back(std::move(log));
+            }
+        }
+    }
+    return cases;
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        auto value = [&](const char* key) { return arg.substr(std::strlen(key)); };
+        if (arg.rfind("--filter=", 0) == 0)              options.filter = value("--filter=");
+        else if (arg == "--list")                        options.list = true;
+        else if (arg.rfind("--min-time=", 0) == 0)       options.minTime = std::max(0.001, std::atof(value("--min-time=").c_str()));
+        else if (arg.rfind("--repetitions=", 0) == 0)    options.repetitions = std::max(1, std::atoi(value("--repetitions=").c_str()));
+        else if (arg.rfind("--message-bytes=", 0) == 0)  options.messageBytes = parse_list<size_t>(value("--message-bytes="));
+        else if (arg.rfind("--batch=", 0) == 0)          options.batches = parse_list<size_t>(value("--batch="));
+        else if (arg.rfind("--board=", 0) == 0)          options.boardSizes = parse_list<size_t>(value("--board="));
+        else if (arg.rfind("--selectivity=", 0) == 0)    options.selectivities = parse_list<double>(value("--selectivity="));
+        else if (arg.rfind("--threads=", 0) == 0)        options.threads = parse_list<size_t>(value("--threads="));
+        else if (arg == "--format=text" || arg == "--format=csv") options.csv = (arg == "--format=csv");
+        else if (arg.rfind("--baseline=", 0) == 0)       options.baseline = value("--baseline=");
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--filter=TEXT] [--list] [--min-time=S] [--repetitions=N]"
+                         " [--message-bytes=N,...] [--batch=N,...] [--board=N,...] [--selectivity=PCT,...]"
+                         " [--threads=N,...] [--format=text|csv] [--baseline=FILE]" << std::endl;
+            return 1;
+        }
+    }
+    for (double& selectivity : options.selectivities) selectivity = std::min(100.0, std::max(0.01, selectivity));
+
+    // Measure the handlers, not the post log
+    g_serverState.config.postLog.durability = LogDurability::NONE;
+
+    std::map<std::string, double> baseline;
+    if (!options.baseline.empty())
+    {
+        baseline = read_baseline(options.baseline);
+        if (baseline.empty())
+        {
+            std::cerr << "No results in baseline " << options.baseline << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<BenchCase> cases = make_cases(options);
+    if (options.csv)
+    {
+        std::printf("name,iterations,ns_per_op,ns_min,ns_max,items_per_sec,mb_per_sec%s\n",
+                    baseline.empty() ? "" : ",baseline_ns_per_op,change_pct");
+    }
+    else if (!options.list)
+    {
+        std::printf("%-56s %12s %12s %12s %14s %10s%s\n", "benchmark", "iterations", "ns/op", "min..max %",
+                    "items/s", "MB/s", baseline.empty() ? "" : "   baseline     change");
+    }
+    for (const BenchCase& c : cases)
+    {
+        if (!options.filter.empty() && c.name.find(options.filter) == std::string::npos) continue;
+        if (options.list)
+        {
+            std::printf("%s\n", c.name.c_str());
+            continue;
+        }
+        BenchResult r = run_case(c, options);
+        auto base = baseline.find(r.name);
+        double change = base != baseline.end() && base->second > 0 ? (r.nsMedian / base->second - 1) * 100 : 0;
+        if (options.csv)
+        {
+            std::printf("%s,%llu,%.2f,%.2f,%.2f,%.0f,%.2f", r.name.c_str(), (unsigned long long)r.iterations,
+                        r.nsMedian, r.nsMin, r.nsMax, r.itemsPerSec, r.mbPerSec);
+            if (!baseline.empty())
+            {
+                if (base != baseline.end()) std::printf(",%.2f,%.1f", base->second, change);
+                else std::printf(",,");
+            }
+            std::printf("\n");
+        }
+        else
+        {
+            char spread[32];
+            std::snprintf(spread, sizeof(spread), "-%.0f..+%.0f", (1 - r.nsMin / r.nsMedian) * 100,
+                          (r.nsMax / r.nsMedian - 1) * 100);
+            char mbPerSec[32] = "-";
+            if (r.mbPerSec > 0) std::snprintf(mbPerSec, sizeof(mbPerSec), "%.1f", r.mbPerSec);
+            std::printf("%-56s %12llu %12.1f %12s %14.0f %10s", r.name.c_str(), (unsigned long long)r.iterations,
+                        r.nsMedian, spread, r.itemsPerSec, mbPerSec);
+            if (base != baseline.end()) std::printf(" %10.1f %+9.1f%%", base->second, change);
+            std::printf("\n");
+        }
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+** Filename: parse_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Microbenchmark for parse_message on POST batches.
+**              Parses the same 1-, 10- and 1000-post POST messages with the previous
+**              two-pass parser (substr + replace every "}#{" + split_fields_until into
+**              std::string fields + copy each field into a Post) and with parse_message
+**              (one scan over both delimiters into string_views, Posts built straight from
+**              the views), and reports messages/s, MB/s and heap allocations per message.
+**              Then times the field scan alone with each delimiter scan kernel (scalar,
+**              SSE2, AVX2) the CPU supports.
+**
+** Usage:   ./build/parse_bench [--iterations=N] [--runs=N]
+** Example: ./build/parse_bench --iterations=200000
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+static std::atomic<size_t> allocations{0};
+
+// GCC flags free() on memory from a replaced operator new once both are inlined; here they match
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// ============================================================================
+// PREVIOUS PARSER (reference)
+// ============================================================================
+
+/// @brief The POST path of parse_message before fields became views
+static ParseResult legacy_parse_post(const std::string& completeMessage)
+{
+    ParseResult res{};
+    size_t termPos = completeMessage.find(transmissionTerminator);
+    std::string message = completeMessage.substr(0, termPos);
+
+    size_t replacePos = 0;
+    while ((replacePos = message.find(messageSeperator, replacePos)) != std::string::npos)
+    {
+        message.replace(replacePos, messageSeperator.length(), fieldDelimiter);
+        replacePos += fieldDelimiter.length();
+    }
+    std::vector<std::string> fields = split_fields_until(message, fieldDelimiter, message.size());
+
+    res.clientCmd = CLIENT_COMMANDS::POST;
+    for (size_t i = 1; i + 2 < fields.size(); i += 3)
+    {
+        const std::string& author  = fields[i];
+        const std::string& title   = fields[i+1];
+        const std::string& body    = fields[i+2];
+        if (body.empty()) return res;
+        res.posts.push_back(ParsedPost{std::pmr::string(author), std::pmr::string(title), std::pmr::string(body)});
+    }
+    res.ok = true;
+    return res;
+}
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Seconds for the fastest of runs calls to fn
+template <typename Fn>
+static double best_seconds(int runs, Fn&& fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < runs; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+/// @brief Builds a POST batch of count posts in wire format
+static std::string make_post_batch(size_t count)
+{
+    std::string message = "POST";
+    for (size_t i = 0; i < count; i++)
+    {
+        message += (i == 0) ? fieldDelimiter : messageSeperator;
+        message += "Author" + std::to_string(i % 50) + fieldDelimiter + "Title " + std::to_string(i % 7) +
+                   fieldDelimiter + "Message body number " + std::to_string(i) + " with some typical text";
+    }
+    return message + transmissionTerminator;
+}
+
+/// @brief Times both parsers on one batch and prints a table row
+static void run_case(size_t posts, int iterations, int runs)
+{
+    const std::string message = make_post_batch(posts);
+    int messages = std::max(1, static_cast<int>(iterations / posts));
+    size_t checksum[2] = {0, 0};
+    size_t allocs[2] = {0, 0};
+
+    auto measure = [&](int which, auto&& parse) {
+        return best_seconds(runs, [&] {
+            size_t before = allocations.load(std::memory_order_relaxed);
+            checksum[which] = 0;
+            for (int m = 0; m < messages; m++)
+            {
+                ParseResult result = parse();
+                checksum[which] += result.posts.size() + result.posts.back().message.size();
+            }
+            allocs[which] = allocations.load(std::memory_order_relaxed) - before;
+        });
+    };
+    double legacySec = measure(0, [&] { return legacy_parse_post(message); });
+    double currentSec = measure(1, [&] { return parse_message(message, fieldDelimiter, messageSeperator, transmissionTerminator); });
+    if (checksum[0] != checksum[1])
+    {
+        std::cerr << posts << " posts: parsers disagree" << std::endl;
+        std::exit(1);
+    }
+
+    double mb = static_cast<double>(message.size()) * messages / 1048576.0;
+    std::printf("  %6zu %12.0f %12.0f %9.1f %9.1f %10.1f %10.1f %8.1fx\n", posts,
+                messages / legacySec, messages / currentSec, mb / legacySec, mb / currentSec,
+                static_cast<double>(allocs[0]) / messages, static_cast<double>(allocs[1]) / messages,
+                legacySec / currentSec);
+    std::fflush(stdout);
+}
+
+/// @brief Times tokenize_fields alone on one batch with each scan kernel this CPU supports
+static void run_kernels(size_t posts, int runs)
+{
+    const std::string message = make_post_batch(posts);
+    const int passes = std::max(1, static_cast<int>(64 * 1048576 / message.size()));
+    std::vector<std::string_view> fields;
+    std::printf("  tokenize %zu-post batch:", posts);
+    for (ScanKernel kernel : {ScanKernel::SCALAR, ScanKernel::SSE2, ScanKernel::AVX2})
+    {
+        if (!scan_kernel_supported(kernel)) continue;
+        DelimiterScanner scanner(fieldDelimiter, messageSeperator, transmissionTerminator, kernel);
+        size_t count = 0;
+        double sec = best_seconds(runs, [&] {
+            for (int p = 0; p < passes; p++)
+            {
+                tokenize_fields(message, scanner, fields);
+                count += fields.size();
+            }
+        });
+        if (count == 0) std::exit(1);
+        std::printf("  %s %.0f MB/s", scan_kernel_name(kernel), message.size() * passes / 1048576.0 / sec);
+    }
+    std::printf("\n");
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    int iterations = 200000;  // Posts parsed per case per run (batches = iterations / batch size)
+    int runs = 5;             // Each case is timed this many times (best is reported)
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--iterations=", 0) == 0)  iterations = std::max(1, std::atoi(arg.c_str() + 13));
+        else if (arg.rfind("--runs=", 0) == 0)   runs = std::max(1, std::atoi(arg.c_str() + 7));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--iterations=N] [--runs=N]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::printf("  %6s %12s %12s %9s %9s %10s %10s %9s\n", "posts", "old msg/s", "new msg/s",
+                "old MB/s", "new MB/s", "old alloc", "new alloc", "speedup");
+    for (size_t posts : {1, 10, 1000}) run_case(posts, iterations, runs);
+    std::printf("\n");
+    for (size_t posts : {10, 1000}) run_kernels(posts, runs);
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+** Filename: pipeline_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Pipelined-client benchmark.
+**              Starts the server in-process, then has each client send a batch of POST
+**              requests back to back and read all the replies before sending the next
+**              batch. For each pipeline depth it reports requests/sec and the server's
+**              socket syscalls per request (and requests per syscall), which shows how
+**              well replies to pipelined requests are coalesced.
+**
+** Usage:   ./build/pipeline_bench [--io=threads|epoll|uring] [--clients=N] [--seconds=N]
+**                                 [--depths=1,10,100]
+** Example: ./build/pipeline_bench --io=threads --clients=4 --seconds=2
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Opens a blocking TCP connection to the local server
+/// @param port The port the server listens on
+/// @return Connected socket, or -1 on failure
+static int connect_local(int port)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock == -1) return -1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(sock, (sockaddr*)&addr, sizeof(addr)) == -1)
+    {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/// @brief Sum of the server's request and I/O syscall counters over all workers
+static void read_server_counters(long& requests, long& syscalls)
+{
+    requests = syscalls = 0;
+    for (int w = 0; w < g_serverState.workerCount; w++)
+    {
+        requests += g_serverState.workerStats[w].requests;
+        syscalls += g_serverState.workerStats[w].ioSyscalls;
+    }
+}
+
+/// @brief Runs clients that each send depth POSTs per batch, for the given time
+/// @return Requests answered
+static long run_depth(int port, int clients, int depth, int seconds)
+{
+    std::string batch;
+    for (int i = 0; i < depth; i++)
+    {
+        batch += "POST" + fieldDelimiter + "Bench" + fieldDelimiter + "Pipelined" + fieldDelimiter +
+                 "Request " + std::to_string(i) + transmissionTerminator;
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<long> answered{0};
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; c++)
+    {
+        threads.emplace_back([&] {
+            int sock = connect_local(port);
+            if (sock == -1) return;
+            std::string rx, reply;
+            while (!stop)
+            {
+                if (send_all_bytes(sock, batch.data(), batch.size(), MSG_NOSIGNAL) < 0) break;
+                int received = 0;
+                while (received < depth && read_message_until_terminator(sock, rx, transmissionTerminator, reply)) received++;
+                if (received < depth) break;
+                answered.fetch_add(depth, std::memory_order_relaxed);
+            }
+            close(sock);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    stop = true;
+    for (auto& t : threads) t.join();
+    return answered;
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    int clients = 4;                     // Connections sending batches concurrently
+    int seconds = 2;                     // Measurement time per depth
+    std::vector<int> depths{1, 10, 100}; // Requests per batch
+
+    // Split benchmark options from server options (--io, --loops, --port, ...)
+    std::vector<char*> serverArgs{argv[0]};
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--clients=", 0) == 0)      clients = std::max(1, std::atoi(arg.c_str() + 10));
+        else if (arg.rfind("--seconds=", 0) == 0) seconds = std::max(1, std::atoi(arg.c_str() + 10));
+        else if (arg.rfind("--depths=", 0) == 0)
+        {
+            depths.clear();
+            std::stringstream list(arg.substr(9));
+            std::string depth;
+            while (std::getline(list, depth, ',')) depths.push_back(std::max(1, std::atoi(depth.c_str())));
+        }
+        else serverArgs.push_back(argv[i]);
+    }
+
+    // Measure request handling, not the post log or snapshots
+    ServerConfig& config = g_serverState.config;
+    config.postLog.durability = LogDurability::NONE;
+    config.snapshotIntervalSec = 0;
+    std::string errorDetails;
+    if (!parse_server_args((int)serverArgs.size(), serverArgs.data(), config, errorDetails))
+    {
+        std::cerr << errorDetails << std::endl;
+        return 1;
+    }
+
+    std::thread(server_run_loop).detach();
+    int probe = -1;
+    for (int attempt = 0; attempt < 50 && probe == -1; attempt++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        probe = connect_local(config.port);
+    }
+    if (probe == -1)
+    {
+        std::cerr << "Server did not start on port " << config.port << std::endl;
+        return 1;
+    }
+    close(probe);
+
+    const char* modeName = config.ioMode == IoMode::EPOLL ? "epoll" :
+                           config.ioMode == IoMode::IO_URING ? "uring" : "threads";
+    std::printf("mode=%s clients=%d\n", modeName, clients);
+    std::printf("  %6s %14s %18s %18s\n", "depth", "requests/sec", "syscalls/request", "requests/syscall");
+    for (int depth : depths)
+    {
+        long requestsBefore, syscallsBefore, requestsAfter, syscallsAfter;
+        read_server_counters(requestsBefore, syscallsBefore);
+        long answered = run_depth(config.port, clients, depth, seconds);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Let closes settle
+        read_server_counters(requestsAfter, syscallsAfter);
+
+        double requests = (double)(requestsAfter - requestsBefore);
+        double syscalls = (double)(syscallsAfter - syscallsBefore);
+        std::printf("  %6d %14.0f %18.2f %18.2f\n", depth, answered / (double)seconds,
+                    requests > 0 ? syscalls / requests : 0.0, syscalls > 0 ? requests / syscalls : 0.0);
+        std::fflush(stdout);
+    }
+    return 0;
+}
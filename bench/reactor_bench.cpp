@@ -0,0 +1,219 @@
+/*
+** Filename: reactor_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: Connection-scalability benchmark for the server I/O modes.
+**              Starts the server in-process (thread-per-client or epoll reactor), opens a
+**              large number of idle connections, then measures request throughput from a
+**              set of active clients while the idle connections are still held open.
+**              Reports per-request latency (p50/p99) and server I/O syscalls per request.
+**
+** Usage:   ./build/reactor_bench [--io=threads|epoll|uring] [--loops=N] [--port=N] [--backlog=N]
+**                                [--idle=N] [--clients=N] [--seconds=N]
+** Example: ./build/reactor_bench --io=uring --loops=2 --idle=5000 --clients=8 --seconds=5
+*/
+
+#include <sys/resource.h>    // setrlimit for large descriptor counts
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Opens a blocking TCP connection to the local server
+/// @param port The port the server listens on
+/// @return Connected socket, or -1 on failure
+static int connect_local(int port)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock == INVALID_SOCKET) return -1;
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(sock, (struct sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
+    {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/// @brief Reads a numeric field (in kB) from /proc/self/status, e.g. "VmRSS" or "Threads"
+static long read_proc_status(const std::string& field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, field.size() + 1, field + ":") == 0)
+        {
+            return std::atol(line.c_str() + field.size() + 1);
+        }
+    }
+    return -1;
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    int idleConnections = 1000;   // Connections opened and left idle for the whole run
+    int activeClients = 4;        // Connections issuing GET_BOARD requests back-to-back
+    int seconds = 5;              // Measurement duration
+
+    // Split benchmark options from server options (--io, --loops, --port, --backlog)
+    std::vector<char*> serverArgs{argv[0]};
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--idle=", 0) == 0)         idleConnections = std::atoi(arg.c_str() + 7);
+        else if (arg.rfind("--clients=", 0) == 0) activeClients = std::atoi(arg.c_str() + 10);
+        else if (arg.rfind("--seconds=", 0) == 0) seconds = std::atoi(arg.c_str() + 10);
+        else serverArgs.push_back(argv[i]);
+    }
+
+    // Only GET_BOARD traffic here; the post log is benchmarked by wal_bench (override with --wal-sync)
+    ServerConfig& config = g_serverState.config;
+    config.postLog.durability = LogDurability::NONE;
+    config.snapshotIntervalSec = 0;
+    std::string errorDetails;
+    if (!parse_server_args((int)serverArgs.size(), serverArgs.data(), config, errorDetails))
+    {
+        std::cerr << errorDetails << std::endl;
+        return 1;
+    }
+
+    // Holding thousands of sockets on both ends needs a raised descriptor limit
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    // ====================================================================
+    // START SERVER IN-PROCESS
+    // ====================================================================
+    std::thread(server_run_loop).detach();
+    int probe = -1;
+    for (int attempt = 0; attempt < 50 && probe == -1; attempt++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        probe = connect_local(config.port);
+    }
+    if (probe == -1)
+    {
+        std::cerr << "Server did not start on port " << config.port << std::endl;
+        return 1;
+    }
+    close(probe);
+
+    long baseThreads = read_proc_status("Threads");
+    long baseRssKb = read_proc_status("VmRSS");
+
+    // ====================================================================
+    // PHASE 1: OPEN AND HOLD IDLE CONNECTIONS
+    // ====================================================================
+    std::vector<int> idleSockets;
+    auto connectStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < idleConnections; i++)
+    {
+        int sock = connect_local(config.port);
+        if (sock == -1) break;
+        idleSockets.push_back(sock);
+    }
+    double connectSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - connectStart).count();
+
+    // Let the server finish accepting everything in its backlog
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    long long connectionsHeld = g_serverState.stats.totals().activeConnections;
+    long heldThreads = read_proc_status("Threads");
+    long heldRssKb = read_proc_status("VmRSS");
+
+    // ====================================================================
+    // PHASE 2: REQUEST THROUGHPUT WHILE IDLE CONNECTIONS ARE HELD
+    // ====================================================================
+    const std::string request = "GET_BOARD" + transmissionTerminator;
+    std::atomic<bool> stop{false};
+    std::vector<std::vector<float>> latencies(activeClients);   // Microseconds, one vector per client
+    std::vector<std::thread> clients;
+
+    // Benchmark client threads never set t_ioStats, so the worker counters only see server I/O
+    long requestsBefore = 0, syscallsBefore = 0;
+    for (int w = 0; w < g_serverState.workerCount; w++)
+    {
+        requestsBefore += g_serverState.workerStats[w].requests;
+        syscallsBefore += g_serverState.workerStats[w].ioSyscalls;
+    }
+
+    for (int c = 0; c < activeClients; c++)
+    {
+        clients.emplace_back([&, c] {
+            int sock = connect_local(config.port);
+            if (sock == -1) return;
+            std::string rx, msg;
+            while (!stop)
+            {
+                auto sent = std::chrono::steady_clock::now();
+                if (send_all_bytes(sock, request.data(), request.size(), MSG_NOSIGNAL) < 0) break;
+                if (!read_message_until_terminator(sock, rx, transmissionTerminator, msg)) break;
+                latencies[c].push_back(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - sent).count());
+            }
+            close(sock);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    stop = true;
+    for (auto& t : clients) t.join();
+
+    long serverRequests = -requestsBefore, serverSyscalls = -syscallsBefore;
+    for (int w = 0; w < g_serverState.workerCount; w++)
+    {
+        serverRequests += g_serverState.workerStats[w].requests;
+        serverSyscalls += g_serverState.workerStats[w].ioSyscalls;
+    }
+
+    std::vector<float> allLatencies;
+    for (const auto& samples : latencies) allLatencies.insert(allLatencies.end(), samples.begin(), samples.end());
+    std::sort(allLatencies.begin(), allLatencies.end());
+    long completed = (long)allLatencies.size();
+    auto percentile = [&](double p) -> double {
+        if (allLatencies.empty()) return 0.0;
+        return allLatencies[std::min(allLatencies.size() - 1, (size_t)(p * allLatencies.size()))];
+    };
+
+    // ====================================================================
+    // REPORT
+    // ====================================================================
+    const char* modeName = config.ioMode == IoMode::EPOLL ? "epoll" :
+                           config.ioMode == IoMode::IO_URING ? "uring" : "threads";
+    std::printf("mode=%s loops=%d\n", modeName,
+                config.ioMode == IoMode::THREAD_PER_CLIENT ? 0 : config.loopThreads);
+    std::printf("  idle connections opened : %zu / %d (%.2f s)\n", idleSockets.size(), idleConnections, connectSeconds);
+    std::printf("  connections held        : %lld\n", connectionsHeld);
+    std::printf("  process threads         : %ld -> %ld\n", baseThreads, heldThreads);
+    std::printf("  resident memory (kB)    : %ld -> %ld\n", baseRssKb, heldRssKb);
+    std::printf("  requests completed      : %ld\n", completed);
+    std::printf("  requests/sec            : %.0f (%d active clients)\n", completed / (double)seconds, activeClients);
+    std::printf("  latency p50 / p99 (us)  : %.1f / %.1f\n", percentile(0.50), percentile(0.99));
+    std::printf("  server syscalls/request : %.2f\n", serverRequests > 0 ? serverSyscalls / (double)serverRequests : 0.0);
+    for (int w = 0; w < g_serverState.workerCount; w++)
+    {
+        const WorkerStats& stats = g_serverState.workerStats[w];
+        std::printf("  worker %-2d               : accepted %ld, active %ld, closed %ld, requests %ld, syscalls %ld\n", w,
+                    stats.accepted.load(), stats.active.load(), stats.closed.load(),
+                    stats.requests.load(), stats.ioSyscalls.load());
+    }
+    std::fflush(stdout);
+
+    // Detached server threads are still blocked in accept()/recv(); skip static destructors
+    std::_Exit(0);
+}
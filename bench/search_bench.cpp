@@ -0,0 +1,152 @@
+/*
+** Filename: search_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: SEARCH latency over a large board.
+**              Appends a synthetic board (1M posts by default) whose messages are drawn from
+**              a fixed vocabulary, builds the word/trigram search index, and reports the
+**              index build time and memory, then the latency of typical SEARCH queries
+**              (words, author/title substrings as the GUI filter sends them, message
+**              substrings) next to a full-board scan that answers the same query.
+**
+** Usage:   ./build/search_bench [--posts=N] [--limit=N]
+** Example: ./build/search_bench --posts=1000000 --limit=100
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief Resident set size of this process in bytes
+static size_t resident_bytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/// @brief Median of repeats runs of fn(), in microseconds
+template <typename Fn>
+static double median_us(int repeats, Fn&& fn)
+{
+    std::vector<double> times;
+    for (int r = 0; r < repeats; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/// @brief Newest-first full scan answering the substring parts of a query (the pre-index GUI filter)
+static size_t scan_matches(const SearchQuery& query)
+{
+    const BoardStore& board = g_serverState.messageBoard;
+    size_t found = 0;
+    for (size_t id = board.size(); id-- > 0 && found < query.limit;)
+    {
+        PostView post = board.at(id);
+        found += post.author.find(query.author) != std::string_view::npos &&
+                 post.title.find(query.title) != std::string_view::npos &&
+                 post.message.find(query.message) != std::string_view::npos;
+    }
+    return found;
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    size_t posts = 1000000;  // Board size
+    size_t limit = 100;      // SEARCH limit for the limited queries
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--posts=", 0) == 0)       posts = std::max(1L, std::atol(arg.c_str() + 8));
+        else if (arg.rfind("--limit=", 0) == 0)  limit = std::max(1L, std::atol(arg.c_str() + 8));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--posts=N] [--limit=N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // 5000-word vocabulary with a skewed (Zipf-like) choice, 8 words per message
+    std::mt19937 rng(42);
+    std::vector<std::string> vocabulary;
+    for (int i = 0; i < 5000; i++) vocabulary.push_back("word" + std::to_string(i * 7919 % 100000));
+    auto pick = [&] {
+        double u = std::uniform_real_distribution<double>(0, 1)(rng);
+        return (size_t)(std::pow(u, 3) * vocabulary.size());
+    };
+
+    BoardStore& board = g_serverState.messageBoard;
+    board.clear();
+    std::vector<Post> batch;
+    for (size_t i = 0; i < posts; i++)
+    {
+        std::string message;
+        for (int w = 0; w < 8; w++) message += (w ? " " : "") + vocabulary[pick()];
+        batch.push_back(Post{"Author number " + std::to_string(i % 1000), "Discussion topic " + std::to_string(i % 200),
+                             std::move(message)});
+        if (batch.size() == 1024 || i + 1 == posts)
+        {
+            board.append(std::move(batch));
+            batch.clear();
+        }
+    }
+
+    // First search indexes the whole board (later POSTs are indexed as they are published)
+    size_t residentBefore = resident_bytes();
+    SearchQuery first;
+    first.words = vocabulary[0];
+    auto start = std::chrono::steady_clock::now();
+    g_serverState.searchIndex.search(board, g_serverState.boardIndex, board.size(), first);
+    double buildSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("posts=%zu limit=%zu\n", posts, limit);
+    std::printf("  index build:  %.2f s (+%.1f MiB, incl. author/title index)\n", buildSec,
+                (resident_bytes() - residentBefore) / 1048576.0);
+
+    const std::string commonPair = vocabulary[0] + " " + vocabulary[1];  // Outlives the views below
+    struct Case { const char* name; SearchQuery query; bool scannable; };
+    const Case cases[] = {
+        {"word (rare)",              {vocabulary[3000], "", "", "", limit}, false},
+        {"words (2, common)",        {commonPair, "", "", "", limit}, false},
+        {"author substring",         {"", "number 42", "", "", limit}, true},
+        {"author+title substring",   {"", "number 42", "topic 2", "", limit}, true},
+        {"message substring",        {"", "", "", vocabulary[3500], limit}, true},
+        {"GUI filter (all matches)", {"", "number 42", "topic 2", "", SIZE_MAX}, true},
+    };
+    std::printf("  %-26s %12s %12s %10s\n", "query", "search (us)", "scan (us)", "matches");
+    for (const Case& c : cases)
+    {
+        size_t matches = 0;
+        double searchUs = median_us(21, [&] {
+            matches = g_serverState.searchIndex.search(board, g_serverState.boardIndex, board.size(), c.query).size();
+        });
+        if (!c.scannable)
+        {
+            std::printf("  %-26s %12.1f %12s %10zu\n", c.name, searchUs, "-", matches);
+            continue;
+        }
+        double scanUs = median_us(3, [&] { scan_matches(c.query); });
+        if (scan_matches(c.query) != matches) return 1;
+        std::printf("  %-26s %12.1f %12.1f %10zu\n", c.name, searchUs, scanUs, matches);
+        std::fflush(stdout);
+    }
+    return 0;
+}
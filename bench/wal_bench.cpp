@@ -0,0 +1,141 @@
+/*
+** Filename: wal_bench.cpp
+** Project: Computer Networks Assignment 3
+** Description: POST throughput benchmark for the post log (write-ahead log) durability levels.
+**              Runs post_handler() in-process from several client threads against a fresh
+**              log for each configuration until a fixed number of posts is accepted,
+**              and reports posts/sec, the number of group commits, and posts per commit.
+**
+** Usage:   ./build/wal_bench [--clients=N] [--posts=N] [--batch=N] [--dir=PATH]
+** Example: ./build/wal_bench --clients=16 --posts=100000 --dir=/var/tmp
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../server.cpp"     // Server implementation (built with -DUNIT_TEST, no main())
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/// @brief One durability configuration to measure
+struct WalBenchCase {
+    const char* name;
+    LogDurability durability;
+    int flushIntervalUs;
+};
+
+/// @brief Deletes every segment of the benchmark log
+static void remove_segments(const std::string& logPath)
+{
+    for (const PostLogSegment& segment : PostLog::listSegments(logPath))
+    {
+        unlink(segment.path.c_str());
+    }
+}
+
+/// @brief Runs client threads posting against a fresh log until totalPosts are accepted
+/// @return Posts accepted per second
+static double run_case(const WalBenchCase& benchCase, const std::string& logPath,
+                       int clients, long totalPosts, int postsPerBatch, uint64_t& commits)
+{
+    g_serverState.messageBoard.clear();
+    remove_segments(logPath);
+
+    ServerConfig config;
+    config.snapshotIntervalSec = 0;
+    config.postLogPath = logPath;
+    config.postLog.durability = benchCase.durability;
+    config.postLog.flushIntervalUs = benchCase.flushIntervalUs;
+    std::string errorDetails;
+    if (!start_post_log(config, errorDetails))
+    {
+        std::cerr << errorDetails << std::endl;
+        std::exit(1);
+    }
+
+    // Every client sends POST batches of postsPerBatch messages back-to-back
+    ParseResult parsed;
+    parsed.ok = true;
+    parsed.clientCmd = CLIENT_COMMANDS::POST;
+    for (int i = 0; i < postsPerBatch; i++)
+    {
+        parsed.posts.push_back(ParsedPost{"bench", "Durability", "A typical short message board post body."});
+    }
+
+    // Clients claim requests from a shared budget so every configuration does the same work
+    std::atomic<long> claimed{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < clients; c++)
+    {
+        threads.emplace_back([&, c] {
+            std::string error;
+            while (claimed.fetch_add(postsPerBatch) < totalPosts)
+            {
+                if (!post_handler(parsed, error, c))
+                {
+                    std::cerr << error << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    commits = g_serverState.postLog.commitCount();
+    stop_post_log();
+    remove_segments(logPath);
+    return g_serverState.messageBoard.size() / elapsed;
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINT
+// ============================================================================
+
+int main(int argc, char* argv[])
+{
+    int clients = 8;          // Concurrent posting clients
+    long totalPosts = 50000;  // Posts accepted per configuration
+    int postsPerBatch = 1;    // Messages per POST request
+    std::string dir = ".";    // Where the temporary log file is written (use a real disk for fsync numbers)
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--clients=", 0) == 0)      clients = std::atoi(arg.c_str() + 10);
+        else if (arg.rfind("--posts=", 0) == 0)   totalPosts = std::atol(arg.c_str() + 8);
+        else if (arg.rfind("--batch=", 0) == 0)   postsPerBatch = std::atoi(arg.c_str() + 8);
+        else if (arg.rfind("--dir=", 0) == 0)     dir = arg.substr(6);
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--clients=N] [--posts=N] [--batch=N] [--dir=PATH]" << std::endl;
+            return 1;
+        }
+    }
+    std::string logPath = dir + "/wal_bench.wal";
+
+    const WalBenchCase cases[] = {
+        {"none (memory only)",  LogDurability::NONE,  0},
+        {"write",               LogDurability::WRITE, 0},
+        {"fsync",               LogDurability::FSYNC, 0},
+        {"fsync, 500us window", LogDurability::FSYNC, 500},
+        {"fsync, 2ms window",   LogDurability::FSYNC, 2000},
+    };
+
+    std::printf("clients=%d posts/request=%d posts=%ld log=%s\n", clients, postsPerBatch, totalPosts, logPath.c_str());
+    std::printf("  %-22s %14s %12s %14s\n", "durability", "posts/sec", "commits", "posts/commit");
+    for (const WalBenchCase& benchCase : cases)
+    {
+        uint64_t commits = 0;
+        double rate = run_case(benchCase, logPath, clients, totalPosts, postsPerBatch, commits);
+        double perCommit = commits ? g_serverState.messageBoard.size() / (double)commits : 0.0;
+        std::printf("  %-22s %14.0f %12llu %14.1f\n", benchCase.name, rate,
+                    (unsigned long long)commits, perCommit);
+        std::fflush(stdout);
+    }
+    return 0;
+}
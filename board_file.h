@@ -0,0 +1,469 @@
+#pragma once
+// Binary, memory-mappable snapshot of the message board.
+// The server maps the file at startup and serves the saved posts straight from the
+// mapping (PostView), so loading a large board does not parse or copy any post text.
+// MessageBoard.txt, the older line-based text format, is converted once on first start.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "post.h"
+
+/// @brief Read-only, memory-mapped board snapshot file
+///
+/// File layout (native little-endian, version 1):
+///   header (64 bytes): "MSGBOARD" | u32 version | u32 headerBytes | u64 postCount |
+///                      u64 dataEnd | u64 indexOffset | u64 indexChecksum | u64 headerChecksum | reserved
+///   records from byte 64 to dataEnd, one per post:
+///                      i32 clientId | u32 authorLen | u32 titleLen | u32 messageLen | bytes
+///   index at indexOffset (8-byte aligned): u64 record offset per post, in board order
+/// append() adds records at dataEnd (over the old index), writes a new index after them,
+/// syncs, and only then rewrites the header. A crash before the header write leaves the old
+/// header in place; if its index was overwritten, open() rebuilds it by walking the records.
+class BoardFile {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_BYTES = 64;
+    static constexpr size_t RECORD_FIXED = 16;  // clientId + three lengths
+
+    BoardFile() = default;
+    BoardFile(const BoardFile&) = delete;
+    BoardFile& operator=(const BoardFile&) = delete;
+    ~BoardFile() { close(); }
+
+    /// @brief Maps a board file and loads its offset index
+    /// @param path Board file to map
+    /// @param error Output: description of the failure
+    /// @return False if the file is missing, of another version, or corrupt
+    bool open(const std::string& path, std::string& error) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+            error = "Failed to open board file " + path + ": " + strerror(errno);
+            if (fd >= 0) ::close(fd);
+            return false;
+        }
+        mappedBytes = (size_t)info.st_size;
+        if (mappedBytes < HEADER_BYTES) {
+            ::close(fd);
+            error = "Board file " + path + " is too short";
+            return false;
+        }
+        void* region = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);  // The mapping keeps the file alive
+        if (region == MAP_FAILED) {
+            error = "Failed to map board file " + path + ": " + strerror(errno);
+            return false;
+        }
+        mapped = static_cast<const char*>(region);
+
+        Header header;
+        if (!readHeader(mapped, header, error) || header.dataEnd > mappedBytes) {
+            if (error.empty()) error = "Board file header is out of range";
+            error = path + ": " + error;
+            close();
+            return false;
+        }
+
+        // The index is copied out of the mapping: append() may later overwrite it in the file
+        offsets.resize(header.postCount);
+        bool indexInRange = header.indexOffset >= header.dataEnd &&
+                            header.indexOffset <= mappedBytes &&
+                            (mappedBytes - header.indexOffset) / 8 >= header.postCount;
+        if (indexInRange) {
+            memcpy(offsets.data(), mapped + header.indexOffset, header.postCount * 8);
+        }
+        rebuilt = !indexInRange || checksum(mapped + header.indexOffset, header.postCount * 8) != header.indexChecksum;
+        if (rebuilt && !scanRecords(header)) {
+            error = "Board file " + path + " has corrupt records";
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Unmaps the file (views handed out earlier become invalid)
+    void close() {
+        if (mapped != nullptr) munmap(const_cast<char*>(mapped), mappedBytes);
+        mapped = nullptr;
+        mappedBytes = 0;
+        offsets.clear();
+        rebuilt = false;
+    }
+
+    /// @brief Number of posts in the file
+    size_t size() const { return offsets.size(); }
+
+    /// @brief True if open() had to rebuild the index from the records (interrupted append)
+    bool indexRebuilt() const { return rebuilt; }
+
+    /// @brief Returns a view of post i that points into the mapping
+    PostView view(size_t index) const {
+        const char* record = mapped + offsets[index];
+        int32_t clientId;
+        uint32_t lengths[3];
+        memcpy(&clientId, record, 4);
+        memcpy(lengths, record + 4, 12);
+        const char* text = record + RECORD_FIXED;
+        return PostView(std::string_view(text, lengths[0]),
+                        std::string_view(text + lengths[0], lengths[1]),
+                        std::string_view(text + lengths[0] + lengths[1], lengths[2]),
+                        clientId);
+    }
+
+    // ========================================================================
+    // WRITING
+    // ========================================================================
+
+    /// @brief Writes posts [0, count) as a new board file (temporary file + rename)
+    /// @param viewAt Called as viewAt(i) and returns the PostView of post i
+    /// @return False (with error set) if the file could not be written and synced
+    template <typename ViewAt>
+    static bool write(const std::string& path, size_t count, ViewAt&& viewAt, std::string& error) {
+        std::string tmpPath = path + ".tmp";
+        int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            error = "Failed to create " + tmpPath + ": " + strerror(errno);
+            return false;
+        }
+
+        Header header;
+        std::vector<uint64_t> index;
+        header.dataEnd = HEADER_BYTES;
+        bool ok = writeRecords(fd, 0, count, viewAt, header.dataEnd, index) &&
+                  writeIndexAndHeader(fd, index, header);
+        if (!ok) error = "Failed to write " + tmpPath + ": " + strerror(errno);
+        ::close(fd);
+        if (ok && rename(tmpPath.c_str(), path.c_str()) != 0) {
+            error = "Failed to replace " + path + ": " + strerror(errno);
+            ok = false;
+        }
+        if (!ok) {
+            unlink(tmpPath.c_str());
+            return false;
+        }
+        syncDirectory(path);
+        return true;
+    }
+
+    /// @brief Appends posts [oldCount, newCount) to an existing board file in place
+    /// Only the new records, the index and the header are written
+    /// @param viewAt Called as viewAt(i) and returns the PostView of post i
+    /// @return False if the file on disk does not hold exactly oldCount posts with an intact index,
+    ///         or on a write error (write() the whole board instead)
+    template <typename ViewAt>
+    static bool append(const std::string& path, size_t oldCount, size_t newCount, ViewAt&& viewAt,
+                       std::string& error) {
+        int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            error = "Failed to open " + path + ": " + strerror(errno);
+            return false;
+        }
+
+        char raw[HEADER_BYTES];
+        Header header;
+        std::vector<uint64_t> index(oldCount);
+        bool ok = pread(fd, raw, HEADER_BYTES, 0) == (ssize_t)HEADER_BYTES && readHeader(raw, header, error) &&
+                  header.postCount == oldCount &&
+                  pread(fd, index.data(), oldCount * 8, (off_t)header.indexOffset) == (ssize_t)(oldCount * 8) &&
+                  checksum(reinterpret_cast<const char*>(index.data()), oldCount * 8) == header.indexChecksum;
+        if (!ok) {
+            ::close(fd);
+            if (error.empty()) error = path + " does not match the saved board";
+            return false;
+        }
+
+        ok = writeRecords(fd, oldCount, newCount, viewAt, header.dataEnd, index) &&
+             writeIndexAndHeader(fd, index, header);
+        if (!ok) error = "Failed to append to " + path + ": " + strerror(errno);
+        ::close(fd);
+        return ok;
+    }
+
+    // ========================================================================
+    // LEGACY TEXT FORMAT (MessageBoard.txt)
+    // ========================================================================
+    // One post per line: AUTHOR|TITLE|MESSAGE|CLIENTID. The original server wrote the
+    // fields raw, so its files are read the way it read them: split on '|', no unescaping.
+    // Files written here start with TEXT_ESCAPED_HEADER and backslash-escape '\', '|' and
+    // newlines inside fields.
+
+    static constexpr const char* TEXT_ESCAPED_HEADER = "#escaped-fields";
+
+    /// @brief Starts a text-format file whose lines are written by appendTextLine
+    static void appendTextHeader(std::string& out) {
+        out += TEXT_ESCAPED_HEADER;
+        out += '\n';
+    }
+
+    /// @brief Appends one post to out as an escaped text-format line (after appendTextHeader)
+    static void appendTextLine(const PostView& post, std::string& out) {
+        for (std::string_view field : {post.author, post.title, post.message}) {
+            for (char c : field) {
+                if (c == '\\' || c == '|') {
+                    out += '\\';
+                    out += c;
+                } else if (c == '\n') {
+                    out += "\\n";
+                } else {
+                    out += c;
+                }
+            }
+            out += '|';
+        }
+        out += std::to_string(post.clientId);
+        out += '\n';
+    }
+
+    /// @brief Reads a text-format board file
+    /// Malformed lines and a torn final line (no trailing newline) are skipped
+    /// @param posts Output: the posts, in file order
+    /// @return False if the file cannot be opened
+    static bool readText(const std::string& path, std::vector<Post>& posts, std::string& error) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            error = "Failed to open " + path;
+            return false;
+        }
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        size_t lineStart = 0;
+        size_t headerLength = strlen(TEXT_ESCAPED_HEADER);
+        bool escaped = data.compare(0, headerLength + 1, std::string(TEXT_ESCAPED_HEADER) + '\n') == 0;
+        if (escaped) lineStart = headerLength + 1;
+        for (size_t end; (end = data.find('\n', lineStart)) != std::string::npos; lineStart = end + 1) {
+            Post post;
+            const char* line = data.data() + lineStart;
+            size_t length = end - lineStart;
+            if (length > 0 && (escaped ? parseTextLine(line, length, post) : parseLegacyTextLine(line, length, post))) {
+                posts.push_back(std::move(post));
+            }
+        }
+        return true;
+    }
+
+    /// @brief One-time conversion of a text-format board file to the binary format
+    /// @param converted Output: number of posts written
+    /// @return False if the text file cannot be read or the board file cannot be written
+    static bool convertText(const std::string& textPath, const std::string& path, size_t& converted,
+                            std::string& error) {
+        std::vector<Post> posts;
+        if (!readText(textPath, posts, error)) return false;
+        converted = posts.size();
+        return write(path, posts.size(), [&](size_t i) { return PostView(posts[i]); }, error);
+    }
+
+private:
+    /// @brief Decoded file header
+    struct Header {
+        uint64_t postCount = 0;
+        uint64_t dataEnd = HEADER_BYTES;
+        uint64_t indexOffset = HEADER_BYTES;
+        uint64_t indexChecksum = 0;
+    };
+
+    static constexpr char MAGIC[8] = {'M', 'S', 'G', 'B', 'O', 'A', 'R', 'D'};
+    static constexpr size_t WRITE_CHUNK_BYTES = 1 << 20;  // Records are written in chunks of this size
+
+    /// @brief FNV-1a over 64-bit words (plus any tail bytes)
+    static uint64_t checksum(const char* data, size_t length) {
+        uint64_t hash = 14695981039346656037ull;
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            hash ^= word;
+            hash *= 1099511628211ull;
+        }
+        for (; i < length; i++) {
+            hash ^= (unsigned char)data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /// @brief Validates and decodes the 64-byte header
+    static bool readHeader(const char* raw, Header& header, std::string& error) {
+        uint32_t version, headerBytes;
+        uint64_t headerChecksum;
+        memcpy(&version, raw + 8, 4);
+        memcpy(&headerBytes, raw + 12, 4);
+        memcpy(&header.postCount, raw + 16, 8);
+        memcpy(&header.dataEnd, raw + 24, 8);
+        memcpy(&header.indexOffset, raw + 32, 8);
+        memcpy(&header.indexChecksum, raw + 40, 8);
+        memcpy(&headerChecksum, raw + 48, 8);
+
+        if (memcmp(raw, MAGIC, 8) != 0) {
+            error = "not a board file";
+        } else if (version != VERSION || headerBytes != HEADER_BYTES) {
+            error = "unsupported board file version " + std::to_string(version);
+        } else if (checksum(raw, 48) != headerChecksum || header.dataEnd < HEADER_BYTES) {
+            error = "corrupt board file header";
+        } else {
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Rebuilds the offset index by walking the records (after an interrupted append)
+    bool scanRecords(const Header& header) {
+        uint64_t offset = HEADER_BYTES;
+        for (size_t i = 0; i < header.postCount; i++) {
+            if (header.dataEnd - offset < RECORD_FIXED) return false;
+            uint32_t lengths[3];
+            memcpy(lengths, mapped + offset + 4, 12);
+            uint64_t recordBytes = RECORD_FIXED + (uint64_t)lengths[0] + lengths[1] + lengths[2];
+            if (header.dataEnd - offset < recordBytes) return false;
+            offsets[i] = offset;
+            offset += recordBytes;
+        }
+        return true;
+    }
+
+    /// @brief pwrite() the whole buffer, retrying short writes
+    static bool writeAt(int fd, const std::string& data, uint64_t offset) {
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t n = pwrite(fd, data.data() + written, data.size() - written, (off_t)(offset + written));
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) return false;
+            written += (size_t)n;
+        }
+        return true;
+    }
+
+    /// @brief Writes the records of posts [first, last) at dataEnd, advancing it and extending index
+    template <typename ViewAt>
+    static bool writeRecords(int fd, size_t first, size_t last, ViewAt& viewAt, uint64_t& dataEnd,
+                             std::vector<uint64_t>& index) {
+        std::string chunk;
+        uint64_t chunkStart = dataEnd;
+        for (size_t i = first; i < last; i++) {
+            PostView post = viewAt(i);
+            index.push_back(dataEnd);
+
+            int32_t clientId = post.clientId;
+            uint32_t lengths[3] = {(uint32_t)post.author.size(), (uint32_t)post.title.size(),
+                                   (uint32_t)post.message.size()};
+            chunk.append(reinterpret_cast<const char*>(&clientId), 4);
+            chunk.append(reinterpret_cast<const char*>(lengths), 12);
+            chunk.append(post.author);
+            chunk.append(post.title);
+            chunk.append(post.message);
+            dataEnd += RECORD_FIXED + post.author.size() + post.title.size() + post.message.size();
+
+            if (chunk.size() >= WRITE_CHUNK_BYTES) {
+                if (!writeAt(fd, chunk, chunkStart)) return false;
+                chunk.clear();
+                chunkStart = dataEnd;
+            }
+        }
+        return writeAt(fd, chunk, chunkStart);
+    }
+
+    /// @brief Writes the index after the records, syncs, then commits the header and syncs again
+    static bool writeIndexAndHeader(int fd, const std::vector<uint64_t>& index, Header& header) {
+        header.postCount = index.size();
+        header.indexOffset = (header.dataEnd + 7) & ~uint64_t(7);
+        std::string indexBytes(reinterpret_cast<const char*>(index.data()), index.size() * 8);
+        header.indexChecksum = checksum(indexBytes.data(), indexBytes.size());
+        if (!writeAt(fd, indexBytes, header.indexOffset) ||
+            ftruncate(fd, (off_t)(header.indexOffset + indexBytes.size())) != 0 ||
+            fdatasync(fd) != 0) {
+            return false;
+        }
+
+        std::string raw(HEADER_BYTES, '\0');
+        uint32_t version = VERSION, headerBytes = HEADER_BYTES;
+        memcpy(&raw[0], MAGIC, 8);
+        memcpy(&raw[8], &version, 4);
+        memcpy(&raw[12], &headerBytes, 4);
+        memcpy(&raw[16], &header.postCount, 8);
+        memcpy(&raw[24], &header.dataEnd, 8);
+        memcpy(&raw[32], &header.indexOffset, 8);
+        memcpy(&raw[40], &header.indexChecksum, 8);
+        uint64_t headerChecksum = checksum(raw.data(), 48);
+        memcpy(&raw[48], &headerChecksum, 8);
+        return writeAt(fd, raw, 0) && fdatasync(fd) == 0;
+    }
+
+    /// @brief Makes a renamed file's directory entry durable
+    static void syncDirectory(const std::string& path) {
+        size_t slash = path.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+        int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+
+    /// @brief Parses one line of a file the original server wrote: fields are raw, a '|'
+    /// always separates, anything after the client ID field is ignored and the ID only
+    /// needs to start with a number (as std::stoi accepted)
+    /// @return False if the line is malformed
+    static bool parseLegacyTextLine(const char* line, size_t length, Post& post) {
+        std::string_view rest(line, length);
+        std::string_view fields[4];
+        for (int field = 0; field < 4; field++) {
+            size_t bar = rest.find('|');
+            if (field < 3 && bar == std::string_view::npos) return false;
+            fields[field] = rest.substr(0, bar);
+            rest = bar == std::string_view::npos ? std::string_view() : rest.substr(bar + 1);
+        }
+        std::string clientIdText(fields[3]);
+        char* end = nullptr;
+        long clientId = strtol(clientIdText.c_str(), &end, 10);
+        if (end == clientIdText.c_str()) return false;
+        post.author = std::string(fields[0]);
+        post.title = std::string(fields[1]);
+        post.message = std::string(fields[2]);
+        post.clientId = (int)clientId;
+        return true;
+    }
+
+    /// @brief Parses one escaped text-format line (see appendTextLine)
+    /// @return False if the line is malformed
+    static bool parseTextLine(const char* line, size_t length, Post& post) {
+        std::string fields[4];
+        int field = 0;
+        for (size_t i = 0; i < length; i++) {
+            char c = line[i];
+            if (c == '|') {
+                if (++field == 4) return false;
+            } else if (c == '\\' && i + 1 < length) {
+                c = line[++i];
+                fields[field] += (c == 'n') ? '\n' : c;
+            } else {
+                fields[field] += c;
+            }
+        }
+        if (field != 3 || fields[3].empty()) return false;
+
+        char* end = nullptr;
+        long clientId = strtol(fields[3].c_str(), &end, 10);
+        if (*end != '\0') return false;
+        post.author = std::move(fields[0]);
+        post.title = std::move(fields[1]);
+        post.message = std::move(fields[2]);
+        post.clientId = (int)clientId;
+        return true;
+    }
+
+    const char* mapped = nullptr;      // Read-only mapping of the whole file
+    size_t mappedBytes = 0;
+    std::vector<uint64_t> offsets;     // Record offset of each post
+    bool rebuilt = false;
+};
@@ -0,0 +1,177 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "board_store.h"
+
+/// @brief Secondary author -> post ids and title -> post ids indexes for filtered GET_BOARD
+///
+/// Each posting list holds board indexes in ascending order, so a filtered GET_BOARD
+/// costs time proportional to the number of matches instead of the board size, and the
+/// author+title case is a sorted-list intersection. publish_posts() indexes every batch
+/// from the board store's pre-publish hook; posts that reach the board another way
+/// (snapshot load, log recovery, tests) are picked up by the catch-up in lookup().
+/// Lists are kept per interned name id (BoardStore::names()), so indexing a post is two
+/// array appends, and a filter is resolved to its id once per lookup.
+class BoardIndex {
+public:
+    /// @brief Indexes board posts [first, first + count) and any earlier posts not yet indexed
+    /// Call in board order (BoardStore::append's pre-publish hook guarantees this)
+    void add(const BoardStore& board, size_t first, size_t count) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        indexUpTo(board, first + count);
+    }
+
+    /// @brief Collects the ids of published posts matching the exact-match filters
+    /// @param board The indexed board
+    /// @param count Number of published posts the caller observed (board.size())
+    /// @param authorFilter Required author (empty = any)
+    /// @param titleFilter Required title (empty = any); at least one filter must be set
+    /// @param first Only return ids at or above this one (to extend an earlier result)
+    /// @param limit Return at most this many ids (the oldest ones)
+    /// @return Matching board indexes in [first, count), oldest first
+    std::vector<uint32_t> lookup(const BoardStore& board, size_t count,
+                                 std::string_view authorFilter, std::string_view titleFilter,
+                                 size_t first = 0, size_t limit = SIZE_MAX) {
+        std::shared_lock<std::shared_mutex> shared(mutex);
+        catchUp(board, count, shared);
+
+        if (first >= count || limit == 0) return {};
+        const std::vector<uint32_t>* byAuthor = authorFilter.empty() ? nullptr : find(board, byAuthorLists, authorFilter);
+        const std::vector<uint32_t>* byTitle = titleFilter.empty() ? nullptr : find(board, byTitleLists, titleFilter);
+        std::vector<uint32_t> ids;
+        if ((!authorFilter.empty() && byAuthor == nullptr) || (!titleFilter.empty() && byTitle == nullptr)) {
+            return ids;
+        }
+
+        if (byAuthor != nullptr && byTitle != nullptr) {
+            // Walk the shorter list, binary-searching the longer one
+            const std::vector<uint32_t>& shorter = byAuthor->size() <= byTitle->size() ? *byAuthor : *byTitle;
+            const std::vector<uint32_t>& longer = &shorter == byAuthor ? *byTitle : *byAuthor;
+            auto from = longer.begin();
+            for (auto it = std::lower_bound(shorter.begin(), shorter.end(), (uint32_t)first); it != shorter.end(); ++it) {
+                uint32_t id = *it;
+                if (id >= count) break;
+                from = std::lower_bound(from, longer.end(), id);
+                if (from == longer.end()) break;
+                if (*from == id) {
+                    ids.push_back(id);
+                    if (ids.size() == limit) break;
+                }
+            }
+        } else {
+            // Ids past count belong to batches published after the caller sampled the board
+            const std::vector<uint32_t>& list = byAuthor != nullptr ? *byAuthor : *byTitle;
+            auto begin = std::lower_bound(list.begin(), list.end(), (uint32_t)first);
+            auto end = std::lower_bound(begin, list.end(), (uint32_t)count);
+            if ((size_t)(end - begin) > limit) end = begin + limit;
+            ids.assign(begin, end);
+        }
+        return ids;
+    }
+
+    /// @brief Number of posts whose author (or title) is any of the given names (may count unpublished ones)
+    /// @param titles False to match authors, true to match titles
+    /// @param nameIds Name ids (BoardStore::names()), each at most once
+    size_t countNames(const BoardStore& board, size_t count, bool titles, const std::vector<uint32_t>& nameIds) {
+        std::shared_lock<std::shared_mutex> shared(mutex);
+        catchUp(board, count, shared);
+        const PostingLists& lists = titles ? byTitleLists : byAuthorLists;
+        size_t total = 0;
+        for (uint32_t nameId : nameIds) {
+            if (nameId < lists.size()) total += lists[nameId].size();
+        }
+        return total;
+    }
+
+    /// @brief Calls fn(id) for published posts whose author (or title) is any of the given names,
+    /// newest first, until fn returns false
+    /// The posting lists are merged lazily, so stopping early costs only the posts visited
+    template <typename Fn>
+    void walkNames(const BoardStore& board, size_t count, bool titles, const std::vector<uint32_t>& nameIds, Fn&& fn) {
+        std::shared_lock<std::shared_mutex> shared(mutex);
+        catchUp(board, count, shared);
+        const PostingLists& lists = titles ? byTitleLists : byAuthorLists;
+        // Max-heap of cursors, one per list, each starting at its newest post below count
+        struct Cursor {
+            const uint32_t* begin;  // Oldest entry of the list
+            const uint32_t* at;     // Next entry to return
+        };
+        std::vector<Cursor> heads;
+        for (uint32_t nameId : nameIds) {
+            if (nameId >= lists.size()) continue;
+            const std::vector<uint32_t>& list = lists[nameId];
+            auto end = std::lower_bound(list.begin(), list.end(), (uint32_t)std::min<size_t>(count, UINT32_MAX));
+            if (end != list.begin()) heads.push_back(Cursor{list.data(), list.data() + (end - list.begin()) - 1});
+        }
+        auto older = [](const Cursor& a, const Cursor& b) { return *a.at < *b.at; };
+        std::make_heap(heads.begin(), heads.end(), older);
+        while (!heads.empty()) {
+            std::pop_heap(heads.begin(), heads.end(), older);
+            Cursor& newest = heads.back();
+            if (!fn(*newest.at)) return;
+            if (newest.at == newest.begin) {
+                heads.pop_back();
+            } else {
+                newest.at--;
+                std::push_heap(heads.begin(), heads.end(), older);
+            }
+        }
+    }
+
+private:
+    using PostingLists = std::vector<std::vector<uint32_t>>;  // Indexed by name id
+
+    /// @brief The posting list for a filter (find() only: client filters are never interned)
+    static const std::vector<uint32_t>* find(const BoardStore& board, const PostingLists& lists, std::string_view key) {
+        uint32_t id = board.names().find(key);
+        return id < lists.size() && !lists[id].empty() ? &lists[id] : nullptr;
+    }
+
+    static void addTo(PostingLists& lists, uint32_t id, size_t index) {
+        if (id >= lists.size()) lists.resize((size_t)id + 1);
+        lists[id].push_back((uint32_t)index);
+    }
+
+    /// @brief Indexes posts appended without publish_posts (or after a clear) before a read
+    /// @param shared The caller's shared lock (dropped while catching up, held again on return)
+    void catchUp(const BoardStore& board, size_t count, std::shared_lock<std::shared_mutex>& shared) {
+        if (generation == board.generation() && indexed >= count) return;
+        shared.unlock();
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            indexUpTo(board, count);
+        }
+        shared.lock();
+    }
+
+    /// @brief Indexes posts up to (not including) end; caller holds the exclusive lock
+    void indexUpTo(const BoardStore& board, size_t end) {
+        if (generation != board.generation()) {
+            byAuthorLists.clear();
+            byTitleLists.clear();
+            indexed = 0;
+            generation = board.generation();
+        }
+        if (indexed >= end) return;
+        // Streams the id columns only; mapped posts get their names interned by the scan
+        board.scanNames(indexed, end, [&](size_t first, size_t count, const uint32_t* authors, const uint32_t* titles) {
+            for (size_t i = 0; i < count; i++) {
+                addTo(byAuthorLists, authors[i], first + i);
+                addTo(byTitleLists, titles[i], first + i);
+            }
+        });
+        indexed = end;
+    }
+
+    std::shared_mutex mutex;    // Writers: publish hook and catch-up; readers: lookup()
+    PostingLists byAuthorLists; // author id -> ascending board indexes
+    PostingLists byTitleLists;  // title id -> ascending board indexes
+    size_t indexed = 0;         // Posts [0, indexed) are in both lists
+    uint64_t generation = 0;    // BoardStore::generation() the lists were built for
+};
@@ -0,0 +1,329 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "board_file.h"
+#include "post.h"
+
+/// @brief Append-only message board storage that readers can walk without locking
+///
+/// Posts live in fixed-size segments that are never moved or freed while the server
+/// runs, so a reference to a published post stays valid. Writers serialize on a
+/// private mutex, fill the next free slots, and then publish them by storing the new
+/// length with release ordering. Readers load the published length with acquire
+/// ordering and may read every post below it, even while a writer is appending.
+/// A long GET_BOARD therefore never blocks a POST (and vice versa).
+///
+/// The posts loaded at startup stay in the memory-mapped board file (attachFile) and are
+/// read through PostViews into the mapping; only posts appended later live in segments.
+///
+/// Authors and titles repeat heavily, so appended posts keep them as ids into a StringPool
+/// (names()). Ids are interned before the writer lock is taken, so concurrent POSTs share
+/// the intern work instead of queueing behind it.
+///
+/// Segments are columnar: author ids, title ids, client ids and message lengths/pointers are
+/// separate arrays, and message bytes are packed back to back into large blob chunks. A
+/// filter scan (scanNames(), select()) streams only the two dense id columns and touches a
+/// message only for the rows it returns; a post costs 24 bytes of columns plus its text.
+///
+/// Segments are found through a two-level directory: a small fixed table of pointers to
+/// directory blocks, each listing DIRECTORY_SIZE segments. Blocks are allocated as the board
+/// grows, so an empty store costs 8 KiB of directory and the board can reach MAX_POSTS
+/// (the limit of the 32-bit post ids used by the indexes). setCapacity() sets a lower limit;
+/// tryAppend() reports a batch that would pass it instead of appending.
+class BoardStore {
+public:
+    static constexpr size_t SEGMENT_SHIFT = 10;
+    static constexpr size_t SEGMENT_SIZE = size_t(1) << SEGMENT_SHIFT;     // Posts per segment
+    static constexpr size_t DIRECTORY_SHIFT = 12;
+    static constexpr size_t DIRECTORY_SIZE = size_t(1) << DIRECTORY_SHIFT; // Segments per directory block
+    static constexpr size_t MAX_DIRECTORIES = 1024;
+    static constexpr size_t MAX_POSTS = SEGMENT_SIZE * DIRECTORY_SIZE * MAX_DIRECTORIES;  // 2^32
+    static constexpr size_t BLOB_CHUNK = size_t(1) << 20;                  // Message bytes per blob chunk
+
+    BoardStore() = default;
+    BoardStore(const BoardStore&) = delete;
+    BoardStore& operator=(const BoardStore&) = delete;
+    ~BoardStore() { clear(); }
+
+    /// @brief Number of published posts (safe to call from any thread)
+    size_t size() const { return published.load(std::memory_order_acquire); }
+
+    /// @brief True if no posts have been published
+    bool empty() const { return size() == 0; }
+
+    /// @brief Returns a view of a published post by index
+    /// @param index Position in posting order; must be below a size() the caller observed
+    PostView at(size_t index) const {
+        if (index < fileCount) return file->view(index);
+        const Segment& segment = segmentAt(index >> SEGMENT_SHIFT);
+        size_t row = index & (SEGMENT_SIZE - 1);
+        uint32_t author = segment.author[row];
+        uint32_t title = segment.title[row];
+        return PostView(namePool.view(author), namePool.view(title),
+                        std::string_view(segment.message[row], segment.messageLength[row]),
+                        segment.clientId[row], author, title);
+    }
+
+    /// @brief Intern table for authors and titles (PostView::authorId/titleId index it)
+    /// Indexes may intern the names of mapped posts too; client filters should only find()
+    StringPool& names() const { return namePool; }
+
+    /// @brief Changes every time clear() runs (lets derived indexes notice a reset board)
+    uint64_t generation() const { return clears.load(std::memory_order_acquire); }
+
+    /// @brief Number of leading posts served from the mapped board file
+    size_t mappedCount() const { return fileCount; }
+
+    /// @brief Most posts the board may hold; tryAppend() rejects batches that would pass it
+    size_t capacity() const { return limit.load(std::memory_order_relaxed); }
+
+    /// @brief Sets capacity() (capped at MAX_POSTS; posts already stored are kept)
+    void setCapacity(size_t maxPosts) { limit.store(std::min(maxPosts, MAX_POSTS), std::memory_order_relaxed); }
+
+    /// @brief Serves a loaded board file as the first posts of an empty store
+    /// Not safe while other threads use the store (startup only)
+    /// @param boardFile Opened board file; the store keeps it mapped until clear()
+    void attachFile(std::unique_ptr<BoardFile> boardFile) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (published.load(std::memory_order_relaxed) != 0) {
+            throw std::logic_error("board file must be attached to an empty store");
+        }
+        file = std::move(boardFile);
+        fileCount = file->size();
+        if (fileCount > MAX_POSTS) {
+            throw std::length_error("message board is full");
+        }
+        published.store(fileCount, std::memory_order_release);
+    }
+
+    /// @brief Calls fn(PostView) for every post published when the walk starts (oldest first)
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        size_t count = size();
+        for (size_t i = 0; i < count; i++) {
+            fn(at(i));
+        }
+    }
+
+    /// @brief Streams the author and title id columns of posts [begin, end) in runs
+    /// Calls fn(first, count, authorIds, titleIds) with up to SEGMENT_SIZE posts per call.
+    /// Mapped posts have no columns; their names are interned into a scratch run instead.
+    /// @param end Must not exceed a size() the caller observed (or the batch an append hook is publishing)
+    template <typename Fn>
+    void scanNames(size_t begin, size_t end, Fn&& fn) const {
+        size_t index = begin;
+        if (index < std::min(end, fileCount)) {
+            std::vector<uint32_t> authors, titles;
+            while (index < std::min(end, fileCount)) {
+                size_t count = std::min(SEGMENT_SIZE, std::min(end, fileCount) - index);
+                authors.resize(count);
+                titles.resize(count);
+                for (size_t i = 0; i < count; i++) {
+                    PostView post = file->view(index + i);
+                    authors[i] = namePool.intern(post.author);
+                    titles[i] = namePool.intern(post.title);
+                }
+                fn(index, count, authors.data(), titles.data());
+                index += count;
+            }
+        }
+        while (index < end) {
+            const Segment& segment = segmentAt(index >> SEGMENT_SHIFT);
+            size_t row = index & (SEGMENT_SIZE - 1);
+            size_t count = std::min(SEGMENT_SIZE - row, end - index);
+            fn(index, count, segment.author + row, segment.title + row);
+            index += count;
+        }
+    }
+
+    /// @brief Indexes of posts [begin, end) whose author and title pass the predicates (ascending)
+    /// Each predicate runs once per distinct name (authorOk(std::string_view) -> bool), then
+    /// only the id columns are streamed, so a substring filter costs two array loads per post.
+    template <typename AuthorOk, typename TitleOk>
+    std::vector<uint32_t> select(size_t begin, size_t end, AuthorOk&& authorOk, TitleOk&& titleOk) const {
+        // Per name id: 0 = not evaluated yet, 1 = fails, 2 = passes
+        std::vector<uint8_t> authorPass, titlePass;
+        auto passes = [&](std::vector<uint8_t>& cache, uint32_t id, auto& predicate) {
+            if (id >= cache.size()) cache.resize(std::max<size_t>(namePool.size(), (size_t)id + 1), 0);
+            if (cache[id] == 0) cache[id] = predicate(namePool.view(id)) ? 2 : 1;
+            return cache[id] == 2;
+        };
+        std::vector<uint32_t> rows;
+        scanNames(begin, end, [&](size_t first, size_t count, const uint32_t* authors, const uint32_t* titles) {
+            for (size_t i = 0; i < count; i++) {
+                if (passes(authorPass, authors[i], authorOk) && passes(titlePass, titles[i], titleOk)) {
+                    rows.push_back((uint32_t)(first + i));
+                }
+            }
+        });
+        return rows;
+    }
+
+    /// @brief Appends a single post and publishes it
+    /// @return Index assigned to the post
+    size_t append(Post post) {
+        std::vector<Post> batch;
+        batch.push_back(std::move(post));
+        return append(std::move(batch));
+    }
+
+    /// @brief Appends a batch of posts; readers see either none or all of them
+    /// Throws std::length_error past capacity() (startup and tests; POSTs use tryAppend)
+    /// @param posts The posts to append (moved from)
+    /// @return Index assigned to the first post of the batch
+    size_t append(std::vector<Post>&& posts) {
+        size_t first = 0;
+        std::string errorDetails;
+        if (!tryAppend(std::move(posts), [&](size_t index, size_t) { first = index; return true; }, errorDetails)) {
+            throw std::length_error(errorDetails);
+        }
+        return first;
+    }
+
+    /// @brief Appends a batch and calls beforePublish(first, count) just before it becomes visible
+    /// The hook runs under the writer lock, so hooks observe batches in board order
+    /// (the post log relies on this to number its records by board index). If the hook returns
+    /// false the batch is dropped unpublished (the hook sets errorDetails); its slots are reused.
+    /// @param posts The posts to append (moved from only if appended)
+    /// @param errorDetails Output: set if nothing was appended
+    /// @return False if the batch would take the board past capacity(), a message is too long,
+    ///         the name pool is full or the hook refused it
+    template <typename Hook>
+    bool tryAppend(std::vector<Post>&& posts, Hook&& beforePublish, std::string& errorDetails) {
+        std::vector<uint32_t> nameIds(posts.size() * 2);
+        try {
+            for (size_t i = 0; i < posts.size(); i++) {
+                if (posts[i].message.size() > UINT32_MAX) throw std::length_error("message too long");
+                nameIds[2 * i] = namePool.intern(posts[i].author);
+                nameIds[2 * i + 1] = namePool.intern(posts[i].title);
+            }
+        } catch (const std::length_error& error) {
+            errorDetails = error.what();  // Too long, or the name pool is full
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(writerMutex);
+        size_t first = published.load(std::memory_order_relaxed);
+        if (first + posts.size() > capacity()) {
+            errorDetails = "message board is full (" + std::to_string(capacity()) + " posts)";
+            return false;
+        }
+
+        for (size_t i = 0; i < posts.size(); i++) {
+            size_t index = first + i;
+            Segment* segment = &segmentFor(index >> SEGMENT_SHIFT);
+            size_t row = index & (SEGMENT_SIZE - 1);
+            segment->author[row] = nameIds[2 * i];
+            segment->title[row] = nameIds[2 * i + 1];
+            segment->clientId[row] = posts[i].clientId;
+            segment->messageLength[row] = (uint32_t)posts[i].message.size();
+            segment->message[row] = storeMessage(posts[i].message);
+        }
+
+        if (!beforePublish(first, posts.size())) return false;
+
+        // Publish: every slot written above happens-before a reader that sees the new length
+        published.store(first + posts.size(), std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Removes every post, releases the segments and unmaps the board file
+    /// Not safe while other threads read the store (used at startup and in tests)
+    void clear() {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        published.store(0, std::memory_order_release);
+        for (auto& slot : directories) {
+            Directory* directory = slot.exchange(nullptr, std::memory_order_acq_rel);
+            if (directory == nullptr) continue;
+            for (auto& segment : directory->segments) delete segment.load(std::memory_order_relaxed);
+            delete directory;
+        }
+        blobChunks.clear();
+        blobUsed = blobCapacity = 0;
+        file.reset();
+        fileCount = 0;
+        namePool.clear();
+        clears.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+private:
+    /// @brief SEGMENT_SIZE appended posts, one array per field
+    struct Segment {
+        uint32_t author[SEGMENT_SIZE];         // names() id
+        uint32_t title[SEGMENT_SIZE];          // names() id
+        int clientId[SEGMENT_SIZE];
+        uint32_t messageLength[SEGMENT_SIZE];
+        const char* message[SEGMENT_SIZE];     // Into a blob chunk (never moved or freed before clear())
+    };
+
+    /// @brief DIRECTORY_SIZE segment pointers (second level of the directory)
+    struct Directory {
+        std::atomic<Segment*> segments[DIRECTORY_SIZE] = {};
+    };
+
+    /// @brief A segment holding published posts (readers; the caller saw them in size())
+    const Segment& segmentAt(size_t segmentIndex) const {
+        const Directory& directory = *directories[segmentIndex >> DIRECTORY_SHIFT].load(std::memory_order_acquire);
+        return *directory.segments[segmentIndex & (DIRECTORY_SIZE - 1)].load(std::memory_order_acquire);
+    }
+
+    /// @brief The segment to write, allocating it and its directory block on first use; caller holds writerMutex
+    Segment& segmentFor(size_t segmentIndex) {
+        auto& directorySlot = directories[segmentIndex >> DIRECTORY_SHIFT];
+        Directory* directory = directorySlot.load(std::memory_order_relaxed);
+        if (directory == nullptr) {
+            directory = new Directory;
+            directorySlot.store(directory, std::memory_order_release);
+        }
+        auto& segmentSlot = directory->segments[segmentIndex & (DIRECTORY_SIZE - 1)];
+        Segment* segment = segmentSlot.load(std::memory_order_relaxed);
+        if (segment == nullptr) {
+            segment = new Segment;
+            segmentSlot.store(segment, std::memory_order_release);
+        }
+        return *segment;
+    }
+
+    /// @brief Copies a message into the blob; caller holds writerMutex
+    const char* storeMessage(const std::string& message) {
+        if (message.empty()) return "";
+        if (message.size() > BLOB_CHUNK / 4) {
+            // Long messages get a chunk of their own, kept in front so the open chunk stays last
+            auto own = std::make_unique<char[]>(message.size());
+            std::memcpy(own.get(), message.data(), message.size());
+            const char* out = own.get();
+            blobChunks.insert(blobChunks.end() - (blobChunks.empty() ? 0 : 1), std::move(own));
+            return out;
+        }
+        if (blobChunks.empty() || blobCapacity - blobUsed < message.size()) {
+            blobChunks.push_back(std::make_unique<char[]>(BLOB_CHUNK));
+            blobCapacity = BLOB_CHUNK;
+            blobUsed = 0;
+        }
+        char* out = blobChunks.back().get() + blobUsed;
+        std::memcpy(out, message.data(), message.size());
+        blobUsed += message.size();
+        return out;
+    }
+
+    std::unique_ptr<BoardFile> file;                 // Mapped posts [0, fileCount) (set at startup)
+    size_t fileCount = 0;
+    std::atomic<uint64_t> clears{0};                 // See generation()
+    std::mutex writerMutex;                          // Serializes appends (readers never take it)
+    std::atomic<size_t> published{0};                // Posts visible to readers
+    std::atomic<size_t> limit{MAX_POSTS};            // See capacity()
+    std::atomic<Directory*> directories[MAX_DIRECTORIES] = {};  // Segment directory blocks, filled on demand
+    mutable StringPool namePool;                     // Authors and titles of appended posts
+    std::vector<std::unique_ptr<char[]>> blobChunks; // Message bytes (writer only; readers hold pointers)
+    size_t blobUsed = 0;                             // Bytes used in blobChunks.back()
+    size_t blobCapacity = 0;                         // Size of blobChunks.back() (0 = none open)
+};
@@ -15,7 +15,9 @@
 #   server  - Build the server executable only (default)
 #   gui     - Build GUI standalone (experimental)
 #   tests   - Build and run the unit test suite
-#   all     - Build server, GUI, and tests
+#   bench   - Build the benchmark executables
+#   loadgen - Build the wire-protocol load generator
+#   all     - Build server, GUI, tests, benchmarks, and the load generator
 #   clean   - Remove all build artifacts and compiled binaries
 #   help    - Display this help message
 #
@@ -23,7 +25,9 @@
 #   ./build.sh                    # Build server executable
 #   ./build.sh gui                # Compile and test GUI (experimental)
 #   ./build.sh tests              # Compile and run all unit tests
-#   ./build.sh all                # Build server, GUI, and tests
+#   ./build.sh bench              # Compile benchmarks into build/
+#   ./build.sh loadgen            # Compile the load generator into build/
+#   ./build.sh all                # Build server, GUI, tests, benchmarks, and the load generator
 #   ./build.sh clean              # Remove build directory
 #
 # REQUIREMENTS:
@@ -35,11 +39,15 @@
 #   - Server executable: build/server
 #   - GUI executable:    build/server_gui (experimental)
 #   - Test executable:  build/server_tests
+#   - Benchmarks:       build/reactor_bench, build/wal_bench, build/board_load_bench, build/framer_bench,
+#                       build/parse_bench, build/pipeline_bench, build/alloc_bench, build/intern_bench,
+#                       build/column_bench, build/search_bench, build/microbench
+#   - Load generator:   build/loadgen
 #   - Colored status messages for easy visibility
 #
 # NOTES:
 #   - All build artifacts are placed in the ./build/ directory
-#   - Tests are compiled with -DUNIT_TEST flag to exclude main() from server.cpp
+#   - Tests and benchmarks are compiled with -DUNIT_TEST flag to exclude main() from server.cpp
 #   - Script exits immediately on any compilation error
 #
 ################################################################################
@@ -138,6 +146,85 @@ build_tests() {
     fi
 }
 
+# Build benchmark executables
+build_bench() {
+    print_status "Building benchmarks..."
+    cd "${PROJECT_DIR}"
+    
+    # Benchmarks include server.cpp directly (like the tests), so build with -DUNIT_TEST
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/reactor_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/reactor_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/wal_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/wal_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/board_load_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/board_load_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/framer_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/framer_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/parse_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/parse_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/pipeline_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/pipeline_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/alloc_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/alloc_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/intern_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/intern_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/column_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/column_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/search_bench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/search_bench" && \
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/microbench.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/microbench"
+    
+    if [ $? -eq 0 ]; then
+        print_success "Benchmarks built successfully: ${BUILD_DIR}/reactor_bench, ${BUILD_DIR}/wal_bench, ${BUILD_DIR}/board_load_bench, ${BUILD_DIR}/framer_bench, ${BUILD_DIR}/parse_bench, ${BUILD_DIR}/pipeline_bench, ${BUILD_DIR}/alloc_bench, ${BUILD_DIR}/intern_bench, ${BUILD_DIR}/column_bench, ${BUILD_DIR}/search_bench, ${BUILD_DIR}/microbench"
+        print_status "Example: ${BUILD_DIR}/reactor_bench --io=epoll --loops=2 --idle=5000 --clients=8"
+        print_status "Example: ${BUILD_DIR}/wal_bench --clients=16 --posts=100000"
+        print_status "Example: ${BUILD_DIR}/board_load_bench --posts=1000000"
+        print_status "Example: ${BUILD_DIR}/framer_bench --chunk=4096"
+        print_status "Example: ${BUILD_DIR}/parse_bench --iterations=200000"
+        print_status "Example: ${BUILD_DIR}/pipeline_bench --io=threads --clients=4"
+        print_status "Example: ${BUILD_DIR}/alloc_bench --arena-bytes=0"
+        print_status "Example: ${BUILD_DIR}/intern_bench --posts=10000000"
+        print_status "Example: ${BUILD_DIR}/column_bench --posts=10000000"
+        print_status "Example: ${BUILD_DIR}/search_bench --posts=1000000 --limit=100"
+        print_status "Example: ${BUILD_DIR}/microbench --format=csv > before.csv; ${BUILD_DIR}/microbench --baseline=before.csv"
+    else
+        print_error "Failed to build benchmarks"
+        exit 1
+    fi
+}
+
+# Build the wire-protocol load generator
+build_loadgen() {
+    print_status "Building load generator..."
+    cd "${PROJECT_DIR}"
+    
+    # Starts the server in-process unless --target is given, so it also builds with -DUNIT_TEST
+    g++ -std=c++17 -O2 -Wall -Wextra -pthread bench/loadgen.cpp \
+        -DUNIT_TEST \
+        -o "${BUILD_DIR}/loadgen"
+    
+    if [ $? -eq 0 ]; then
+        print_success "Load generator built successfully: ${BUILD_DIR}/loadgen"
+        print_status "Example: ${BUILD_DIR}/loadgen --io=epoll --connections=64 --depth=4 --get-percent=20"
+        print_status "Example: ${BUILD_DIR}/loadgen --target=127.0.0.1:26500 --rate=20000 --arrival=poisson"
+    else
+        print_error "Failed to build load generator"
+        exit 1
+    fi
+}
+
 # Clean build artifacts
 clean() {
     print_status "Cleaning build artifacts..."
@@ -152,14 +239,18 @@ show_usage() {
     echo "  server  - Build server executable (default)"
     echo "  gui     - Build GUI standalone (experimental)"
     echo "  tests   - Build and run unit tests"
-    echo "  all     - Build server, GUI, and tests"
+    echo "  bench   - Build benchmarks"
+    echo "  loadgen - Build the load generator"
+    echo "  all     - Build server, GUI, tests, benchmarks, and the load generator"
     echo "  clean   - Remove all build artifacts"
     echo ""
     echo "Examples:"
     echo "  ./build.sh           # Build server"
     echo "  ./build.sh gui       # Build GUI (experimental)"
     echo "  ./build.sh tests     # Build and run tests"
-    echo "  ./build.sh all       # Build server, GUI, and tests"
+    echo "  ./build.sh bench     # Build benchmarks"
+    echo "  ./build.sh loadgen   # Build the load generator"
+    echo "  ./build.sh all       # Build server, GUI, tests, benchmarks, and the load generator"
 }
 
 # Main logic
@@ -173,10 +264,18 @@ case "${1:-server}" in
     tests)
         build_tests
         ;;
+    bench)
+        build_bench
+        ;;
+    loadgen)
+        build_loadgen
+        ;;
     all)
         build_server
         build_gui
         build_tests
+        build_bench
+        build_loadgen
         ;;
     clean)
         clean
@@ -0,0 +1,246 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DELIMITER_SCAN_X86 1
+#endif
+
+/// @brief Which protocol delimiter DelimiterScanner::next() found
+enum class DelimiterKind {
+    FIELD,      // "}+{" between fields
+    POST,       // "}#{" between posts
+    TERMINATOR  // "}}&{{" at the end of a message
+};
+
+/// @brief Block kernel used to find delimiter candidates
+enum class ScanKernel {
+    SCALAR,  // One byte at a time (any CPU)
+    SSE2,    // 16-byte blocks (every x86-64 CPU)
+    AVX2     // 32-byte blocks (selected at runtime when CPUID reports AVX2)
+};
+
+/// @brief Name of a kernel for logs and benchmark output
+inline const char* scan_kernel_name(ScanKernel kernel) {
+    switch (kernel) {
+        case ScanKernel::SSE2: return "sse2";
+        case ScanKernel::AVX2: return "avx2";
+        default:               return "scalar";
+    }
+}
+
+/// @brief True if this CPU (and build) can run kernel
+inline bool scan_kernel_supported(ScanKernel kernel) {
+#ifdef DELIMITER_SCAN_X86
+    if (kernel == ScanKernel::AVX2) {
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+    }
+    return true;
+#else
+    return kernel == ScanKernel::SCALAR;
+#endif
+}
+
+/// @brief Fastest kernel this CPU supports (checked once)
+inline ScanKernel best_scan_kernel() {
+    if (scan_kernel_supported(ScanKernel::AVX2)) return ScanKernel::AVX2;
+    if (scan_kernel_supported(ScanKernel::SSE2)) return ScanKernel::SSE2;
+    return ScanKernel::SCALAR;
+}
+
+namespace delimiter_scan_detail {
+
+/// @brief The delimiters being searched for (empty = not searched)
+struct Delimiters {
+    std::string field;
+    std::string post;
+    std::string terminator;
+    char lead = '\0';  // First byte shared by every non-empty delimiter
+};
+
+inline bool starts_with(std::string_view text, size_t pos, const std::string& delimiter) {
+    return !delimiter.empty() && text.size() - pos >= delimiter.size() &&
+           std::memcmp(text.data() + pos, delimiter.data(), delimiter.size()) == 0;
+}
+
+/// @brief Decides which delimiter (if any) starts at a lead-byte candidate
+inline bool classify(std::string_view text, size_t pos, const Delimiters& d, DelimiterKind& kind, size_t& length) {
+    if (starts_with(text, pos, d.terminator)) { kind = DelimiterKind::TERMINATOR; length = d.terminator.size(); return true; }
+    if (starts_with(text, pos, d.field))      { kind = DelimiterKind::FIELD;      length = d.field.size();      return true; }
+    if (starts_with(text, pos, d.post))       { kind = DelimiterKind::POST;       length = d.post.size();       return true; }
+    return false;
+}
+
+/// @brief Classifies a candidate and reports it unless it lies inside the previous delimiter
+/// @return False once onDelimiter asks to stop
+template <typename OnDelimiter>
+__attribute__((always_inline)) inline bool visit(std::string_view text, size_t at, const Delimiters& d,
+                                                 size_t& skipUntil, OnDelimiter& onDelimiter) {
+    DelimiterKind kind;
+    size_t length;
+    if (at < skipUntil || !classify(text, at, d, kind, length)) return true;
+    skipUntil = at + length;
+    return onDelimiter(at, kind);
+}
+
+template <typename OnDelimiter>
+inline void scan_scalar(std::string_view text, size_t pos, size_t skipUntil, const Delimiters& d,
+                        OnDelimiter& onDelimiter) {
+    for (; pos < text.size(); pos++) {
+        if (text[pos] == d.lead && !visit(text, pos, d, skipUntil, onDelimiter)) return;
+    }
+}
+
+#ifdef DELIMITER_SCAN_X86
+
+/// @brief Walks text in Block::WIDTH blocks; each block yields a bitmask of lead-byte
+/// positions, and every set bit is classified before the next block is loaded, so one
+/// pass both finds and identifies delimiters. The short tail goes through the scalar loop.
+template <typename Block, typename OnDelimiter>
+__attribute__((always_inline)) inline void scan_blocks(std::string_view text, size_t pos, const Delimiters& d,
+                                                       OnDelimiter& onDelimiter) {
+    const char* data = text.data();
+    size_t skipUntil = pos;
+    while (pos + Block::WIDTH <= text.size()) {
+        uint32_t mask = Block::mask(data + pos, d.lead);
+        while (mask != 0) {
+            size_t at = pos + static_cast<size_t>(__builtin_ctz(mask));
+            if (!visit(text, at, d, skipUntil, onDelimiter)) return;
+            mask &= mask - 1;
+        }
+        pos += Block::WIDTH;
+    }
+    scan_scalar(text, pos, skipUntil, d, onDelimiter);
+}
+
+struct Sse2Block {
+    static constexpr size_t WIDTH = 16;
+    __attribute__((always_inline)) static inline uint32_t mask(const char* p, char lead) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(lead))));
+    }
+};
+
+struct Avx2Block {
+    static constexpr size_t WIDTH = 32;
+    __attribute__((target("avx2"))) static inline uint32_t mask(const char* p, char lead) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(lead))));
+    }
+};
+
+template <typename OnDelimiter>
+inline void scan_sse2(std::string_view text, size_t pos, const Delimiters& d, OnDelimiter& onDelimiter) {
+    scan_blocks<Sse2Block>(text, pos, d, onDelimiter);
+}
+
+template <typename OnDelimiter>
+__attribute__((target("avx2"))) inline void scan_avx2(std::string_view text, size_t pos, const Delimiters& d,
+                                                      OnDelimiter& onDelimiter) {
+    scan_blocks<Avx2Block>(text, pos, d, onDelimiter);
+}
+
+#endif
+
+}  // namespace delimiter_scan_detail
+
+/// @brief Finds the protocol delimiters in one left-to-right pass
+///
+/// All three wire delimiters start with '}', so the scanner looks only for that byte,
+/// 16 or 32 bytes per instruction on x86-64 (kernel picked once from CPUID), and
+/// classifies each candidate as field, post separator or terminator where it stands.
+/// Delimiters without a common first byte (custom ones) fall back to std::string_view::find.
+/// Where two delimiters start at the same byte the terminator wins, then the field delimiter.
+class DelimiterScanner {
+public:
+    /// @param field Field delimiter ("" = do not look for it)
+    /// @param post Post separator ("" = do not look for it)
+    /// @param terminator Message terminator ("" = do not look for it)
+    /// @param kernel Block kernel; falls back to SCALAR if this CPU cannot run it
+    DelimiterScanner(std::string_view field, std::string_view post, std::string_view terminator,
+                     ScanKernel kernel = best_scan_kernel()) {
+        delimiters.field = std::string(field);
+        delimiters.post = std::string(post);
+        delimiters.terminator = std::string(terminator);
+        sharedLead = true;
+        bool first = true;
+        for (std::string_view delimiter : {field, post, terminator}) {
+            if (delimiter.empty()) continue;
+            if (first) delimiters.lead = delimiter[0];
+            else if (delimiter[0] != delimiters.lead) sharedLead = false;
+            first = false;
+        }
+        if (first) sharedLead = false;  // Nothing to look for
+        activeKernel = scan_kernel_supported(kernel) ? kernel : ScanKernel::SCALAR;
+    }
+
+    /// @brief Calls onDelimiter(position, kind) for each delimiter at or after from, left to
+    /// right and non-overlapping (scanning resumes after the reported delimiter)
+    /// @param onDelimiter Returns false to stop the scan
+    template <typename OnDelimiter>
+    void scan(std::string_view text, size_t from, OnDelimiter&& onDelimiter) const {
+        if (from >= text.size()) return;
+        if (!sharedLead) return scanGeneric(text, from, onDelimiter);
+#ifdef DELIMITER_SCAN_X86
+        if (activeKernel == ScanKernel::AVX2) return delimiter_scan_detail::scan_avx2(text, from, delimiters, onDelimiter);
+        if (activeKernel == ScanKernel::SSE2) return delimiter_scan_detail::scan_sse2(text, from, delimiters, onDelimiter);
+#endif
+        delimiter_scan_detail::scan_scalar(text, from, from, delimiters, onDelimiter);
+    }
+
+    /// @brief Finds the first delimiter starting at or after from
+    /// @param kind Output: which delimiter was found
+    /// @return Its position, or std::string_view::npos
+    size_t next(std::string_view text, size_t from, DelimiterKind& kind) const {
+        size_t found = std::string_view::npos;
+        scan(text, from, [&](size_t position, DelimiterKind foundKind) {
+            found = position;
+            kind = foundKind;
+            return false;
+        });
+        return found;
+    }
+
+    /// @brief Length of a delimiter kind in bytes
+    size_t length(DelimiterKind kind) const {
+        switch (kind) {
+            case DelimiterKind::FIELD: return delimiters.field.size();
+            case DelimiterKind::POST:  return delimiters.post.size();
+            default:                   return delimiters.terminator.size();
+        }
+    }
+
+    /// @brief The kernel next() uses
+    ScanKernel kernel() const { return activeKernel; }
+
+private:
+    template <typename OnDelimiter>
+    void scanGeneric(std::string_view text, size_t from, OnDelimiter& onDelimiter) const {
+        while (true) {
+            size_t best = std::string_view::npos;
+            DelimiterKind kind = DelimiterKind::TERMINATOR;
+            auto consider = [&](const std::string& delimiter, DelimiterKind candidate) {
+                if (delimiter.empty()) return;
+                size_t found = text.find(delimiter, from);
+                if (found < best) {
+                    best = found;
+                    kind = candidate;
+                }
+            };
+            consider(delimiters.terminator, DelimiterKind::TERMINATOR);
+            consider(delimiters.field, DelimiterKind::FIELD);
+            consider(delimiters.post, DelimiterKind::POST);
+            if (best == std::string_view::npos || !onDelimiter(best, kind)) return;
+            from = best + length(kind);
+        }
+    }
+
+    delimiter_scan_detail::Delimiters delimiters;
+    bool sharedLead = false;
+    ScanKernel activeKernel = ScanKernel::SCALAR;
+};
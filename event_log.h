@@ -0,0 +1,213 @@
+#pragma once
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// @brief Represents a server event log entry (a copy taken by EventLog::snapshot)
+struct ServerEvent {
+    std::string timestamp;
+    std::string event_type;  // "CONNECT", "DISCONNECT", "POST", "GET_BOARD", "ERROR"
+    std::string message;     // Human-readable description
+    std::string raw_message; // Raw wire format message (optional)
+};
+
+/// @brief Fixed-capacity, multi-producer event ring that keeps the newest CAPACITY events
+///
+/// Every slot is preallocated and cache-line aligned. A producer takes a ticket with one
+/// fetch_add and copies the event into that ticket's slot, so logging never takes a lock,
+/// allocates, or waits for the GUI. Text is stored truncated to fixed per-field sizes, and the
+/// timestamp is a coarse monotonic clock reading (a few ns to read, ms resolution, ample for a
+/// log shown to the second). It only becomes a wall-clock "HH:MM:SS" string when snapshot()
+/// copies the event out.
+///
+/// Per-request events are cheaper still. pushFormat() stores a pointer to a format literal and
+/// two integers, and the reader formats them. The raw payload (the request or the start of the
+/// reply) is only copied while someone is looking at it (setRawVisible, the GUI's Event Log
+/// tab) or for one event in N (setRawSampling). Otherwise the event is a handful of stores.
+///
+/// Each slot is a seqlock: its state is odd while a producer writes and even once the event is
+/// committed, and a reader keeps a copy only if the state was the same committed value before
+/// and after it read the slot. The text is stored as relaxed atomic words, so a torn read is
+/// detected and dropped, never undefined behaviour. When the ring wraps, the newer event
+/// replaces the older one. A producer only waits in the rare case that a slow producer from
+/// CAPACITY events earlier is still writing that slot.
+class EventLog {
+public:
+    static constexpr size_t CAPACITY = 128;      // Power of two
+    static constexpr size_t TYPE_BYTES = 24;
+    static constexpr size_t MESSAGE_BYTES = 184;
+    static constexpr size_t RAW_BYTES = 128;
+
+    EventLog() : wallAnchor(std::chrono::system_clock::now()), monotonicAnchor(monotonicNow()) {}
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    /// @brief Records an event (text longer than its field is cut and ends in "...")
+    void push(std::string_view type, std::string_view message, std::string_view raw = {}) {
+        write(type, nullptr, message, 0, 0, raw);
+    }
+
+    /// @brief Records an event whose message is format (a string literal taking two long long
+    /// arguments, e.g. "Client #%lld connected (socket: %lld)") applied to a and b by the reader
+    void pushFormat(std::string_view type, const char* format, long long a, long long b = 0, std::string_view raw = {}) {
+        write(type, format, {}, a, b, raw);
+    }
+
+    /// @brief Copy raw payloads of every event while true (the GUI sets it while the Event Log tab is shown)
+    void setRawVisible(bool visible) { rawVisible.store(visible, std::memory_order_relaxed); }
+
+    /// @brief Also copy the raw payload of one event in every (0 = only while visible)
+    void setRawSampling(uint32_t every) { rawSampleEvery.store(every, std::memory_order_relaxed); }
+
+    /// @brief Events logged since startup (including those the ring no longer holds)
+    uint64_t total() const { return next.load(std::memory_order_acquire); }
+
+    /// @brief Number of events the ring currently holds
+    size_t size() const { return (size_t)std::min<uint64_t>(total(), CAPACITY); }
+
+    /// @brief Copies up to maxEvents of the newest events, newest first
+    /// Events still being written (or overwritten while being copied) are left out
+    std::vector<ServerEvent> snapshot(size_t maxEvents = CAPACITY) const {
+        std::vector<ServerEvent> events;
+        uint64_t end = total();
+        uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+        char text[MESSAGE_BYTES];
+        for (uint64_t ticket = end; ticket-- > begin && events.size() < maxEvents;) {
+            const Slot& slot = slots[ticket & (CAPACITY - 1)];
+            uint64_t committed = 2 * ticket + 2;
+            if (slot.state.load(std::memory_order_acquire) != committed) continue;
+
+            ServerEvent event;
+            int64_t time = slot.time.load(std::memory_order_relaxed);
+            const char* format = slot.format.load(std::memory_order_relaxed);
+            long long a = slot.args[0].load(std::memory_order_relaxed);
+            long long b = slot.args[1].load(std::memory_order_relaxed);
+            uint64_t lengths = slot.lengths.load(std::memory_order_relaxed);
+            event.event_type.assign(text, loadText(slot.type, lengths & 0xFFFF, text));
+            event.message.assign(text, loadText(slot.message, lengths >> 16 & 0xFFFF, text));
+            event.raw_message.assign(text, loadText(slot.raw, lengths >> 32 & 0xFFFF, text));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.state.load(std::memory_order_relaxed) != committed) continue;  // Torn: overwritten meanwhile
+
+            if (format != nullptr) {
+                int length = std::snprintf(text, sizeof(text), format, a, b);
+                event.message.assign(text, (size_t)std::max(0, std::min(length, (int)sizeof(text) - 1)));
+            }
+            event.timestamp = formatTime(time);
+            events.push_back(std::move(event));
+        }
+        return events;
+    }
+
+private:
+    /// @brief Claims the ticket's slot and copies the event in (see the class comment)
+    void write(std::string_view type, const char* format, std::string_view message, long long a, long long b,
+               std::string_view raw) {
+        int64_t now = monotonicNow();
+        uint64_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots[ticket & (CAPACITY - 1)];
+
+        // Claim the slot unless a newer event already has it (then this one is already overwritten)
+        uint64_t writing = 2 * ticket + 1;
+        uint64_t state = slot.state.load(std::memory_order_relaxed);
+        while (true) {
+            if (state >= writing) return;
+            if (state & 1) {
+                std::this_thread::yield();  // Producer from a lap ago still copying
+                state = slot.state.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (slot.state.compare_exchange_weak(state, writing, std::memory_order_relaxed)) break;
+        }
+        std::atomic_thread_fence(std::memory_order_release);  // Readers see the odd state before any new text
+
+        if (!raw.empty() && !rawVisible.load(std::memory_order_relaxed)) {
+            uint32_t every = rawSampleEvery.load(std::memory_order_relaxed);
+            if (every == 0 || ticket % every != 0) raw = {};
+        }
+        slot.time.store(now, std::memory_order_relaxed);
+        slot.format.store(format, std::memory_order_relaxed);
+        slot.args[0].store(a, std::memory_order_relaxed);
+        slot.args[1].store(b, std::memory_order_relaxed);
+        uint64_t typeLength = storeText(slot.type, TYPE_BYTES, type);
+        uint64_t messageLength = storeText(slot.message, MESSAGE_BYTES, message);
+        uint64_t rawLength = storeText(slot.raw, RAW_BYTES, raw);
+        slot.lengths.store(typeLength | messageLength << 16 | rawLength << 32, std::memory_order_relaxed);
+        slot.state.store(writing + 1, std::memory_order_release);
+    }
+
+    template <size_t BYTES>
+    using Words = std::atomic<uint64_t>[BYTES / 8];
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> state{0};    // 0 = never written, 2t+1 = event t being written, 2t+2 = event t committed
+        std::atomic<int64_t> time{0};      // monotonicNow() when logged
+        std::atomic<uint64_t> lengths{0};  // Type, message and raw lengths (16 bits each)
+        std::atomic<const char*> format{nullptr};  // pushFormat() literal (nullptr = message is text)
+        std::atomic<long long> args[2]{};          // pushFormat() arguments
+        Words<TYPE_BYTES> type{};
+        Words<MESSAGE_BYTES> message{};
+        Words<RAW_BYTES> raw{};
+    };
+
+    /// @brief Stores text (cut to capacity) into words; returns the stored length
+    static uint64_t storeText(std::atomic<uint64_t>* words, size_t capacity, std::string_view text) {
+        char buffer[MESSAGE_BYTES];
+        size_t length = std::min(text.size(), capacity);
+        std::memcpy(buffer, text.data(), length);
+        if (text.size() > capacity) std::memcpy(buffer + capacity - 3, "...", 3);
+        std::memset(buffer + length, 0, (8 - length % 8) % 8);
+        for (size_t w = 0; w * 8 < length; w++) {
+            uint64_t word;
+            std::memcpy(&word, buffer + w * 8, 8);
+            words[w].store(word, std::memory_order_relaxed);
+        }
+        return length;
+    }
+
+    /// @brief Loads length bytes of text from words into buffer; returns length
+    static size_t loadText(const std::atomic<uint64_t>* words, size_t length, char* buffer) {
+        for (size_t w = 0; w * 8 < length; w++) {
+            uint64_t word = words[w].load(std::memory_order_relaxed);
+            std::memcpy(buffer + w * 8, &word, std::min<size_t>(8, length - w * 8));
+        }
+        return length;
+    }
+
+    /// @brief CLOCK_MONOTONIC_COARSE in nanoseconds
+    static int64_t monotonicNow() {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+        return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+    }
+
+    /// @brief Local wall-clock "HH:MM:SS" of a monotonicNow() reading
+    std::string formatTime(int64_t monotonicNs) const {
+        auto since = std::chrono::nanoseconds(monotonicNs - monotonicAnchor);
+        time_t wall = std::chrono::system_clock::to_time_t(
+            wallAnchor + std::chrono::duration_cast<std::chrono::system_clock::duration>(since));
+        struct tm local;
+        localtime_r(&wall, &local);
+        char buffer[20];
+        strftime(buffer, sizeof(buffer), "%H:%M:%S", &local);
+        return buffer;
+    }
+
+    Slot slots[CAPACITY];
+    alignas(64) std::atomic<uint64_t> next{0};   // Next ticket (events logged so far)
+    std::atomic<bool> rawVisible{false};
+    std::atomic<uint32_t> rawSampleEvery{0};
+    const std::chrono::system_clock::time_point wallAnchor;  // Same instant on both clocks,
+    const int64_t monotonicAnchor;                           // so monotonic readings map to wall time
+};
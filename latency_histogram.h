@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief HDR-style latency histogram: fixed memory, 3 significant digits, mergeable
+///
+/// Values below 2048 get a bucket each; above that every power-of-two range is split into
+/// 1024 equal buckets, so any recorded value is reported within 0.1% of its true value no
+/// matter how large it is. Recording is an index computation and an increment, so a load
+/// generator thread can record every request and histograms from several threads are
+/// merged afterwards. Values are unitless (the load generator records nanoseconds).
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 11;                             // 2048 sub-buckets
+    static constexpr uint64_t SUB_COUNT = uint64_t(1) << SUB_BITS;
+    static constexpr uint64_t HALF_COUNT = SUB_COUNT / 2;
+    static constexpr int MAX_SHIFT = 40;                            // Values up to ~2^51 (26 days in ns)
+
+    LatencyHistogram() : counts(SUB_COUNT + (size_t)MAX_SHIFT * HALF_COUNT, 0) {}
+
+    /// @brief Adds one observation (values past the trackable range are clamped)
+    void record(uint64_t value) {
+        counts[indexOf(value)]++;
+        total++;
+        sum += value;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    /// @brief Adds every observation of other
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < counts.size(); i++) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+
+    void reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = sum = maxValue = 0;
+        minValue = UINT64_MAX;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? minValue : 0; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total ? (double)sum / (double)total : 0.0; }
+
+    /// @brief Smallest value that at least percentile% of the observations do not exceed
+    /// Reported as the top of its bucket (never below the true value), capped at max()
+    uint64_t percentile(double percentile) const {
+        if (total == 0) return 0;
+        uint64_t rank = (uint64_t)(percentile / 100.0 * (double)total + 0.5);
+        rank = std::max<uint64_t>(1, std::min(rank, total));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen < rank) continue;
+            // The last bucket also holds the clamped values, so its top is only known from max()
+            return i + 1 == counts.size() ? maxValue : std::min(highestInBucket(i), maxValue);
+        }
+        return maxValue;
+    }
+
+private:
+    static size_t indexOf(uint64_t value) {
+        if (value < SUB_COUNT) return (size_t)value;
+        int shift = (63 - __builtin_clzll(value)) - (SUB_BITS - 1);  // >= 1: value >> shift is in [HALF, SUB)
+        if (shift > MAX_SHIFT) return SUB_COUNT + (size_t)MAX_SHIFT * HALF_COUNT - 1;
+        return (size_t)shift * HALF_COUNT + (size_t)(value >> shift);
+    }
+
+    static uint64_t highestInBucket(size_t index) {
+        if (index < SUB_COUNT) return index;
+        uint64_t shift = index / HALF_COUNT - 1;
+        uint64_t sub = index - shift * HALF_COUNT;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "delimiter_scan.h"
+
+/// @brief Splits a received byte stream into terminator-delimited frames without copying them
+///
+/// Received bytes go into one contiguous buffer (recv() can write straight into it via
+/// writeBuffer()/commit()). Frames are handed out as string_views into that buffer, and the
+/// terminator search resumes where the previous search stopped, so a message that arrives
+/// over many recv() calls is scanned once in total instead of once per call. Consumed bytes
+/// are not erased per frame; the unread tail is moved to the front only when space is needed.
+/// The search itself is DelimiterScanner's block scan (SSE2/AVX2 where available).
+/// Frames stay valid until the next append(), writeBuffer() or clear().
+class MessageFramer {
+public:
+    explicit MessageFramer(std::string_view terminator)
+        : scanner("", "", terminator), terminatorSize(terminator.size()) {}
+
+    /// @brief Returns space for at least minBytes more received bytes (call commit() after writing)
+    char* writeBuffer(size_t minBytes) {
+        if (buffer.size() - writePos < minBytes) makeRoom(minBytes);
+        return buffer.data() + writePos;
+    }
+
+    /// @brief Marks bytes written into writeBuffer() as received
+    void commit(size_t bytes) { writePos += bytes; }
+
+    /// @brief Copies received bytes in (for sources that own their buffer, e.g. io_uring)
+    void append(const char* data, size_t bytes) {
+        std::memcpy(writeBuffer(bytes), data, bytes);
+        commit(bytes);
+    }
+
+    /// @brief True if a complete frame is buffered (the search result is kept for next())
+    bool hasFrame() { return findTerminator(); }
+
+    /// @brief Takes the next complete frame (without its terminator)
+    /// @param frame Output: view into the buffer, valid until the next append/writeBuffer/clear
+    /// @return False if only a partial frame (or nothing) is buffered
+    bool next(std::string_view& frame) {
+        if (!findTerminator()) return false;
+        frame = std::string_view(buffer.data() + readPos, frameEnd - readPos);
+        readPos = frameEnd + terminatorSize;
+        if (readPos == writePos) readPos = writePos = 0;  // Drained: reuse from the front (frame stays valid)
+        scanPos = readPos;
+        frameEnd = NO_FRAME;
+        return true;
+    }
+
+    /// @brief Bytes received but not yet returned as frames
+    size_t buffered() const { return writePos - readPos; }
+
+    /// @brief Drops everything buffered
+    void clear() {
+        readPos = writePos = scanPos = 0;
+        frameEnd = NO_FRAME;
+    }
+
+private:
+    static constexpr size_t NO_FRAME = static_cast<size_t>(-1);
+    static constexpr size_t MIN_CAPACITY = 4096;
+
+    /// @brief Finds the terminator after readPos, scanning only bytes not searched before
+    bool findTerminator() {
+        if (frameEnd != NO_FRAME) return true;
+        std::string_view unread(buffer.data() + scanPos, writePos - scanPos);
+        DelimiterKind kind;
+        size_t found = scanner.next(unread, 0, kind);
+        if (found == std::string_view::npos) {
+            // A terminator split across recv() calls starts in the last size-1 bytes
+            size_t keep = std::min(unread.size(), terminatorSize - 1);
+            scanPos = writePos - keep;
+            return false;
+        }
+        frameEnd = scanPos + found;
+        return true;
+    }
+
+    /// @brief Ensures minBytes of free space after writePos
+    void makeRoom(size_t minBytes) {
+        // Slide the unread tail to the front first; grow only if that is not enough
+        if (readPos > 0) {
+            size_t unread = writePos - readPos;
+            std::memmove(buffer.data(), buffer.data() + readPos, unread);
+            scanPos -= readPos;
+            if (frameEnd != NO_FRAME) frameEnd -= readPos;
+            writePos = unread;
+            readPos = 0;
+        }
+        if (buffer.size() - writePos < minBytes) {
+            buffer.resize(std::max({MIN_CAPACITY, buffer.size() * 2, writePos + minBytes}));
+        }
+    }
+
+    DelimiterScanner scanner;    // Looks for the terminator only
+    size_t terminatorSize;
+    std::vector<char> buffer;    // Capacity in use; [readPos, writePos) holds unread bytes
+    size_t readPos = 0;          // Start of the first unreturned frame
+    size_t writePos = 0;         // End of received data
+    size_t scanPos = 0;          // Terminator search resumes here
+    size_t frameEnd = NO_FRAME;  // Terminator position found by the last search
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "string_pool.h"
+
+/// @brief Represents a message board post
+struct Post {
+    std::string author;
+    std::string title;
+    std::string message;
+    int clientId = 0;  // Which client posted this (socket ID or client number)
+};
+
+/// @brief Read-only view of a post, either held by the board store or inside a mapped board file
+/// Valid for as long as the board it came from (board posts are never moved or freed while it runs)
+/// Posts held by the board store also carry the interned ids of their author and title
+/// (see BoardStore::names()); posts from the mapped file or outside the board carry NO_STRING_ID.
+struct PostView {
+    std::string_view author;
+    std::string_view title;
+    std::string_view message;
+    int clientId = 0;
+    uint32_t authorId = NO_STRING_ID;  // Interned author (equal ids <=> equal authors)
+    uint32_t titleId = NO_STRING_ID;   // Interned title
+
+    PostView() = default;
+    PostView(std::string_view author, std::string_view title, std::string_view message, int clientId,
+             uint32_t authorId = NO_STRING_ID, uint32_t titleId = NO_STRING_ID)
+        : author(author), title(title), message(message), clientId(clientId), authorId(authorId), titleId(titleId) {}
+    PostView(const Post& post)
+        : author(post.author), title(post.title), message(post.message), clientId(post.clientId) {}
+
+    /// @brief Copies the viewed fields into an owning Post
+    Post toPost() const {
+        return Post{std::string(author), std::string(title), std::string(message), clientId};
+    }
+};
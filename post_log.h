@@ -0,0 +1,484 @@
+#pragma once
+// Append-only write-ahead log for message board posts.
+// Every accepted POST batch is encoded into length-prefixed binary records and
+// appended to the log before POST_OK is sent. A single flusher thread performs the
+// write() (and fdatasync()) for everything queued since its last flush, so concurrent
+// clients share one disk sync (group commit). Blocking callers wait in waitDurable();
+// event loops call settle() instead and are woken through an eventfd.
+// The log is split into segment files named <base>.<first sequence>; once a snapshot
+// covers every record of a segment, compact() deletes it.
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_store.h"
+
+/// @brief How far a POST must reach before POST_OK is sent
+enum class LogDurability {
+    NONE,   // No log: posts only live in memory until saveToFile()
+    WRITE,  // Log write() completed: survives a server crash, not a power loss
+    FSYNC   // Log fdatasync() completed: survives a power loss
+};
+
+/// @brief Group-commit tuning for the post log
+struct PostLogOptions {
+    LogDurability durability = LogDurability::FSYNC;
+    int flushIntervalUs = 0;   // Extra time the flusher waits for more batches (0 = flush immediately)
+    int maxBatchRecords = 256; // Flush early once this many posts are queued
+    size_t segmentBytes = 64u << 20;  // Start a new segment file once the current one reaches this size
+};
+
+/// @brief Where a post log ticket stands (see PostLog::settle)
+enum class TicketState {
+    PENDING,  // Not durable yet
+    DURABLE,  // Reached the configured durability
+    FAILED    // The log failed first
+};
+
+/// @brief One segment file of the post log
+struct PostLogSegment {
+    uint64_t firstSequence;  // Sequence number of the segment's first record
+    std::string path;
+};
+
+/// @brief Append-only post log with a background group-commit flusher
+///
+/// Record layout (native little-endian):
+///   u32 bodyLength | u32 checksum (FNV-1a of body) |
+///   body = u64 sequence | i32 clientId | u32 authorLen | u32 titleLen | u32 messageLen | bytes
+/// The sequence number is the post's index on the message board, so a snapshot of the
+/// first N posts (MessageBoard.board) plus the log records with sequence >= N rebuilds it.
+/// Segments are named <base>.<first sequence, 20 digits> so they sort in log order.
+class PostLog {
+public:
+    PostLog() = default;
+    PostLog(const PostLog&) = delete;
+    PostLog& operator=(const PostLog&) = delete;
+    ~PostLog() { close(); }
+
+    /// @brief Appends the encoded record for one post to out
+    static void encodeRecord(uint64_t sequence, const PostView& post, std::string& out) {
+        uint32_t bodyLength = (uint32_t)(BODY_FIXED + post.author.size() + post.title.size() + post.message.size());
+        size_t start = out.size();
+        out.resize(start + RECORD_HEADER + bodyLength);
+        char* body = &out[start + RECORD_HEADER];
+
+        int32_t clientId = post.clientId;
+        uint32_t lengths[3] = {(uint32_t)post.author.size(), (uint32_t)post.title.size(), (uint32_t)post.message.size()};
+        memcpy(body, &sequence, 8);
+        memcpy(body + 8, &clientId, 4);
+        memcpy(body + 12, lengths, 12);
+        char* text = body + BODY_FIXED;
+        memcpy(text, post.author.data(), lengths[0]);
+        memcpy(text + lengths[0], post.title.data(), lengths[1]);
+        memcpy(text + lengths[0] + lengths[1], post.message.data(), lengths[2]);
+
+        uint32_t checksum = fnv1a(body, bodyLength);
+        memcpy(&out[start], &bodyLength, 4);
+        memcpy(&out[start + 4], &checksum, 4);
+    }
+
+    /// @brief File name of the segment whose first record has this sequence number
+    static std::string segmentPath(const std::string& basePath, uint64_t firstSequence) {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), ".%020llu", (unsigned long long)firstSequence);
+        return basePath + suffix;
+    }
+
+    /// @brief Lists the segment files of a log, oldest first
+    static std::vector<PostLogSegment> listSegments(const std::string& basePath) {
+        size_t slash = basePath.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : basePath.substr(0, slash + 1);
+        std::string prefix = (slash == std::string::npos ? basePath : basePath.substr(slash + 1)) + ".";
+
+        std::vector<PostLogSegment> segments;
+        DIR* handle = opendir(dir.c_str());
+        if (handle == nullptr) return segments;
+        while (struct dirent* entry = readdir(handle)) {
+            std::string name = entry->d_name;
+            if (name.size() != prefix.size() + 20 || name.compare(0, prefix.size(), prefix) != 0) continue;
+            std::string digits = name.substr(prefix.size());
+            if (digits.find_first_not_of("0123456789") != std::string::npos) continue;
+            segments.push_back({std::stoull(digits), segmentPath(basePath, std::stoull(digits))});
+        }
+        closedir(handle);
+        std::sort(segments.begin(), segments.end(),
+                  [](const PostLogSegment& a, const PostLogSegment& b) { return a.firstSequence < b.firstSequence; });
+        return segments;
+    }
+
+    /// @brief Reads every intact record of the log, oldest first
+    /// A torn or corrupt tail in the newest segment (a crash mid-write) ends the replay and is
+    /// cut off so new records follow the intact prefix; damage in an older segment is an error
+    /// @param basePath Log base path (no segments yet is an empty log)
+    /// @param fn Called as fn(sequence, Post&&) for each record
+    /// @param error Output: description of the failure
+    /// @return False if a segment cannot be read or repaired
+    static bool replay(const std::string& basePath, const std::function<void(uint64_t, Post&&)>& fn,
+                       std::string& error) {
+        std::vector<PostLogSegment> segments = listSegments(basePath);
+        for (size_t s = 0; s < segments.size(); s++) {
+            std::ifstream file(segments[s].path, std::ios::binary);
+            if (!file.is_open()) {
+                error = "Failed to open post log segment " + segments[s].path;
+                return false;
+            }
+            std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            size_t validBytes = replayBuffer(data, fn);
+            if (validBytes == data.size()) continue;
+
+            if (s + 1 < segments.size()) {
+                error = "Corrupt record in post log segment " + segments[s].path;
+                return false;
+            }
+            if (truncate(segments[s].path.c_str(), (off_t)validBytes) != 0) {
+                error = "Failed to cut torn tail of " + segments[s].path + ": " + strerror(errno);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Opens the log for appending and starts the flusher thread
+    /// Appends to the newest segment, or starts one at nextSequence if there is none
+    /// (call replay() first so a torn tail has been cut off)
+    /// @param basePath Log base path
+    /// @param nextSequence Sequence number the next record will carry (the board size)
+    /// @param options Durability and group-commit settings (NONE leaves the log closed)
+    /// @param error Output: description of the failure
+    /// @return True on success
+    bool open(const std::string& basePath, uint64_t nextSequence, const PostLogOptions& options, std::string& error) {
+        close();
+        settings = options;
+        base = basePath;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = false;
+        }
+        if (settings.durability == LogDurability::NONE) return true;
+
+        std::vector<PostLogSegment> segments = listSegments(basePath);
+        std::string path = segments.empty() ? segmentPath(basePath, nextSequence) : segments.back().path;
+        if (!openSegment(path, error)) return false;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        accepting = true;
+        stopping = false;
+        failed = false;
+        queuedTicket = durableTicket = 0;
+        commits.store(0, std::memory_order_relaxed);
+        flusher = std::thread(&PostLog::flushLoop, this);
+        return true;
+    }
+
+    /// @brief Deletes segments whose records all precede coveredSequence (already in a snapshot)
+    /// The newest segment is never deleted, so the flusher's open file is safe
+    /// @param coveredSequence Number of board posts the latest durable snapshot holds
+    /// @return Number of segment files removed
+    size_t compact(uint64_t coveredSequence) {
+        if (base.empty()) return 0;
+        std::vector<PostLogSegment> segments = listSegments(base);
+        size_t removed = 0;
+        for (size_t s = 0; s + 1 < segments.size(); s++) {
+            // Segment s ends right before the next segment's first record
+            if (segments[s + 1].firstSequence > coveredSequence) break;
+            if (unlink(segments[s].path.c_str()) == 0) removed++;
+        }
+        return removed;
+    }
+
+    /// @brief Flushes everything queued, stops the flusher and closes the file
+    /// From then on enqueue() refuses new records until the log is opened again
+    void close() {
+        if (flusher.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                accepting = false;
+                closed = true;
+                stopping = true;
+            }
+            workCv.notify_one();
+            flusher.join();
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    /// @brief True while the log accepts records
+    bool isOpen() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return accepting;
+    }
+
+    /// @brief Queues the records for board posts [first, first + count) for the next group commit
+    /// Must be called in board order (BoardStore::tryAppend's pre-publish hook guarantees this)
+    /// @param ticket Output: ticket to pass to waitDurable() (0 = not logged, nothing to wait for)
+    /// @param error Output: set if the log has been closed or has failed
+    /// @return False once close() has run or a write/sync failed: the posts cannot be made
+    ///         durable, so must not be published or acknowledged
+    bool enqueue(const BoardStore& board, size_t first, size_t count, uint64_t& ticket, std::string& error) {
+        std::unique_lock<std::mutex> lock(mutex);
+        ticket = 0;
+        if (closed) {
+            error = "post log is closed";
+            return false;
+        }
+        if (failed) {
+            error = "post log failed earlier (" + failure + "), not accepting posts";
+            return false;
+        }
+        if (!accepting) return true;  // Never opened or --wal-sync=none: posts live in memory only
+        bool startsGroup = pending.empty();
+        if (startsGroup) pendingFirstSequence = first;
+        for (size_t i = 0; i < count; i++) {
+            encodeRecord(first + i, board.at(first + i), pending);
+        }
+        pendingRecords += count;
+        ticket = ++queuedTicket;
+
+        // Wake the flusher to open a new group, or to cut the window short once it is full
+        bool wake = startsGroup || pendingRecords >= (size_t)settings.maxBatchRecords;
+        lock.unlock();
+        if (wake) workCv.notify_one();
+        return true;
+    }
+
+    /// @brief Blocks until the batch with this ticket reached the configured durability
+    /// @param error Output: the write/sync error if the log has failed
+    /// @return False if the log failed before the batch became durable
+    bool waitDurable(uint64_t ticket, std::string& error) {
+        if (ticket == 0) return true;
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCv.wait(lock, [&] { return durableTicket >= ticket || failed; });
+        if (durableTicket >= ticket) return true;
+        error = failure;
+        return false;
+    }
+
+    /// @brief Checks a ticket without blocking (for event loops, which must not wait in waitDurable)
+    /// If it is still pending and eventFd >= 0, the flusher writes 1 to eventFd once the ticket
+    /// is durable or the log fails. A loop passes its doorbell once per ticket and calls
+    /// settle() again when the doorbell rings.
+    /// @param ticket Ticket from enqueue() (0 is always durable)
+    /// @param eventFd eventfd to ring on settlement (-1 = only check)
+    /// @param error Output: the write/sync error if FAILED
+    TicketState settle(uint64_t ticket, int eventFd, std::string& error) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (durableTicket >= ticket) return TicketState::DURABLE;
+        if (failed) {
+            error = failure;
+            return TicketState::FAILED;
+        }
+        if (eventFd >= 0) watchers.push_back({ticket, eventFd});
+        return TicketState::PENDING;
+    }
+
+    /// @brief Forgets every settle() registration for eventFd (call before closing it)
+    void cancelWatch(int eventFd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        watchers.erase(std::remove_if(watchers.begin(), watchers.end(),
+                                      [&](const Watcher& watcher) { return watcher.eventFd == eventFd; }),
+                       watchers.end());
+    }
+
+    /// @brief Group commits performed so far (one write + optional sync each)
+    uint64_t commitCount() const { return commits.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t RECORD_HEADER = 8;   // bodyLength + checksum
+    static constexpr size_t BODY_FIXED = 24;     // sequence + clientId + three lengths
+
+    /// @brief Calls fn for each intact record at the start of data
+    /// @return Length of the intact prefix (a torn or corrupt record ends the scan)
+    static size_t replayBuffer(const std::string& data, const std::function<void(uint64_t, Post&&)>& fn) {
+        size_t offset = 0;
+        while (data.size() - offset >= RECORD_HEADER) {
+            uint32_t bodyLength, checksum;
+            memcpy(&bodyLength, &data[offset], 4);
+            memcpy(&checksum, &data[offset + 4], 4);
+            if (bodyLength < BODY_FIXED || data.size() - offset - RECORD_HEADER < bodyLength) break;
+
+            const char* body = &data[offset + RECORD_HEADER];
+            if (fnv1a(body, bodyLength) != checksum) break;
+
+            uint64_t sequence;
+            int32_t clientId;
+            uint32_t lengths[3];
+            memcpy(&sequence, body, 8);
+            memcpy(&clientId, body + 8, 4);
+            memcpy(lengths, body + 12, 12);
+            if ((uint64_t)lengths[0] + lengths[1] + lengths[2] != bodyLength - BODY_FIXED) break;
+
+            const char* text = body + BODY_FIXED;
+            Post post;
+            post.author.assign(text, lengths[0]);
+            post.title.assign(text + lengths[0], lengths[1]);
+            post.message.assign(text + lengths[0] + lengths[1], lengths[2]);
+            post.clientId = clientId;
+            fn(sequence, std::move(post));
+
+            offset += RECORD_HEADER + bodyLength;
+        }
+        return offset;
+    }
+
+    static uint32_t fnv1a(const char* data, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= (unsigned char)data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /// @brief Flusher thread: writes and syncs queued records in groups
+    void flushLoop() {
+        std::string batch;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            workCv.wait(lock, [&] { return stopping || !pending.empty(); });
+            if (pending.empty()) break;  // Stopping with nothing left to flush
+
+            // Group commit window: let more clients join this flush unless the batch is full
+            if (settings.flushIntervalUs > 0 && !stopping) {
+                workCv.wait_for(lock, std::chrono::microseconds(settings.flushIntervalUs), [&] {
+                    return stopping || pendingRecords >= (size_t)settings.maxBatchRecords;
+                });
+            }
+
+            batch.swap(pending);
+            pending.clear();
+            pendingRecords = 0;
+            uint64_t target = queuedTicket;
+            uint64_t batchFirstSequence = pendingFirstSequence;
+
+            // Failure is sticky: after a failed write or sync the file may end in a torn record
+            // (replay stops there) and the kernel may have dropped dirty pages, so retrying on
+            // this fd could acknowledge posts a restart would not find. Groups queued before the
+            // failure was noticed are dropped unwritten; their waiters already see failed.
+            if (failed) continue;
+            lock.unlock();
+
+            // Roll over to a new segment (named by its first record) once the current one is full
+            std::string writeError;
+            if (segmentSize > 0 && segmentSize + batch.size() > settings.segmentBytes) {
+                ::close(fd);
+                fd = -1;
+                openSegment(segmentPath(base, batchFirstSequence), writeError);
+            }
+            if (writeError.empty()) writeError = writeBatch(batch);
+
+            lock.lock();
+            commits.fetch_add(1, std::memory_order_relaxed);
+            if (writeError.empty()) {
+                durableTicket = target;  // Every earlier group succeeded too (failure is sticky)
+            } else {
+                failed = true;
+                failure = writeError;
+            }
+            doneCv.notify_all();
+
+            // Ring the event loops whose tickets just settled. The write happens under the lock,
+            // so once cancelWatch() returns the eventfd is never written again. (Loop doorbells
+            // are non-blocking eventfds, so this never waits.)
+            int lastRung = -1;
+            auto settled = std::remove_if(watchers.begin(), watchers.end(), [&](const Watcher& watcher) {
+                if (watcher.ticket > durableTicket && !failed) return false;
+                if (watcher.eventFd != lastRung) {
+                    uint64_t one = 1;
+                    while (::write(watcher.eventFd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+                    lastRung = watcher.eventFd;
+                }
+                return true;
+            });
+            watchers.erase(settled, watchers.end());
+        }
+    }
+
+    /// @brief Writes one group to the file (and syncs it for FSYNC durability)
+    /// @return Empty on success, otherwise the error description
+    std::string writeBatch(const std::string& batch) {
+        size_t written = 0;
+        while (written < batch.size()) {
+            ssize_t n = ::write(fd, batch.data() + written, batch.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) return std::string("post log write failed: ") + strerror(errno);
+            written += (size_t)n;
+            segmentSize += (size_t)n;
+        }
+        if (settings.durability == LogDurability::FSYNC && fdatasync(fd) != 0) {
+            return std::string("post log fdatasync failed: ") + strerror(errno);
+        }
+        return "";
+    }
+
+    /// @brief Opens (or creates) a segment file for appending
+    bool openSegment(const std::string& path, std::string& error) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+            error = "Failed to open post log segment " + path + ": " + strerror(errno);
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+            return false;
+        }
+        segmentSize = (size_t)info.st_size;
+
+        // Make the new directory entry durable too, or a power loss could drop the whole segment
+        if (settings.durability == LogDurability::FSYNC && segmentSize == 0) {
+            size_t slash = path.find_last_of('/');
+            std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+            int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dirFd >= 0) {
+                fsync(dirFd);
+                ::close(dirFd);
+            }
+        }
+        return true;
+    }
+
+    PostLogOptions settings;
+    std::string base;                   // Log base path (segments are <base>.<first sequence>)
+    int fd = -1;                        // Current (newest) segment, written only by the flusher
+    size_t segmentSize = 0;             // Bytes in the current segment
+    std::thread flusher;
+
+    std::mutex mutex;                   // Guards everything below
+    std::condition_variable workCv;     // Wakes the flusher
+    std::condition_variable doneCv;     // Wakes clients waiting in waitDurable()
+    struct Watcher {
+        uint64_t ticket;
+        int eventFd;
+    };
+    std::vector<Watcher> watchers;      // settle() registrations not yet rung
+    bool accepting = false;             // Between open() and close() (durability != NONE)
+    bool closed = false;                // close() ran on an open log (enqueue() fails until open())
+    std::string pending;                // Encoded records not yet handed to the flusher
+    size_t pendingRecords = 0;
+    uint64_t pendingFirstSequence = 0;  // Sequence of the first record in pending
+    uint64_t queuedTicket = 0;          // Last ticket handed out by enqueue()
+    uint64_t durableTicket = 0;         // Every ticket up to this one is durable
+    bool stopping = false;
+    bool failed = false;
+    std::string failure;
+    std::atomic<uint64_t> commits{0};
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+/// @brief Per-connection scratch memory for parsing one request and building its reply
+///
+/// A std::pmr::monotonic_buffer_resource over one block that the connection keeps for its
+/// whole life: allocations are a pointer bump, deallocation is a no-op, and reset() after
+/// each request rewinds to the start of the block. Requests that need more than the block
+/// (e.g. a large POST batch) get further blocks from the upstream resource, which reset()
+/// returns. The block is allocated on the first request, so idle connections cost nothing.
+/// Anything that must outlive the request (board posts, queued replies, log entries) is
+/// still copied to the regular heap.
+class RequestArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK = 4096;
+
+    /// @param blockSize Bytes kept for the connection (0 = every allocation goes upstream)
+    /// @param upstream Where the block and any overflow come from
+    explicit RequestArena(size_t blockSize = DEFAULT_BLOCK,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : blockSize(blockSize), upstream(upstream) {}
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    ~RequestArena() {
+        arena.reset();
+        if (block != nullptr) upstream->deallocate(block, blockSize);
+    }
+
+    /// @brief Memory resource for the current request
+    std::pmr::memory_resource* resource() {
+        if (blockSize == 0) return upstream;
+        if (!arena) {
+            block = upstream->allocate(blockSize);
+            arena.emplace(block, blockSize, upstream);
+        }
+        return &*arena;
+    }
+
+    /// @brief Frees everything allocated for the last request (objects using it must be gone)
+    void reset() {
+        if (arena) arena->release();
+    }
+
+private:
+    size_t blockSize;
+    std::pmr::memory_resource* upstream;
+    void* block = nullptr;
+    std::optional<std::pmr::monotonic_buffer_resource> arena;
+};
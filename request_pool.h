@@ -0,0 +1,251 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// @brief Handler pool tuning (see --handlers, --handler-queue and --max-connections)
+struct RequestPoolOptions {
+    int threads = -1;              // Handler threads (-1 = one per CPU core, 0 = requests run on the connection's own thread)
+    size_t queueLimit = 1024;      // Requests waiting for a handler before submitters are held back
+    size_t maxConnections = 1024;  // Live connection threads before accepts are held back (0 = no cap)
+};
+
+/// @brief Fixed set of threads that execute client requests handed over by the I/O layer
+///
+/// Each handler thread owns a deque; submissions are spread over the deques round-robin,
+/// a handler takes work from the front of its own deque and, when that is empty, steals
+/// from the back of the others, so one slow request does not strand the work queued
+/// behind it. Admission is bounded: once queueLimit requests are waiting, run() holds
+/// the submitting connection back until a handler frees a slot, which pushes overload
+/// back to TCP instead of growing the number of busy threads or queued requests.
+/// Connections are admitted the same way: admitConnection() holds the accept loop back
+/// while maxConnections connection threads are live, so new clients wait in the listen
+/// backlog instead of each getting a thread.
+/// Counters (queue length, wait time, throttled submissions and accepts) are shown in the Stats tab.
+class RequestPool {
+public:
+    std::atomic<long> executed{0};      // Requests run by a handler thread
+    std::atomic<long> stolen{0};        // ... of which taken from another handler's deque
+    std::atomic<long> throttled{0};     // Submissions that had to wait for a queue slot
+    std::atomic<long> waitUsTotal{0};   // Sum of submit-to-start times (microseconds)
+    std::atomic<long> waitUsMax{0};     // Longest submit-to-start time (microseconds)
+    std::atomic<long> peakQueued{0};    // Highest queue length seen
+    std::atomic<long> acceptsThrottled{0};  // Accepts that had to wait for a connection slot
+    std::atomic<long> peakConnections{0};   // Most connection threads live at once
+
+    RequestPool() = default;
+    RequestPool(const RequestPool&) = delete;
+    RequestPool& operator=(const RequestPool&) = delete;
+    ~RequestPool() { stop(); }
+
+    /// @brief Starts the handler threads (none for options.threads == 0) and sets the connection cap
+    /// @param onThreadStart Called first on every handler thread (e.g. to set thread-locals)
+    void start(const RequestPoolOptions& newOptions, std::function<void()> onThreadStart = nullptr) {
+        stop();
+        {
+            std::lock_guard<std::mutex> lock(connectionMutex);
+            maxConnections = newOptions.maxConnections;
+        }
+        options = newOptions;
+        if (options.threads < 0) options.threads = (int)std::max(1u, std::thread::hardware_concurrency());
+        if (options.threads == 0) return;
+        options.queueLimit = std::max<size_t>(1, options.queueLimit);
+        queues.clear();
+        for (int i = 0; i < options.threads; i++) queues.push_back(std::make_unique<Queue>());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = false;
+            accepting = true;
+        }
+        for (int i = 0; i < options.threads; i++) {
+            threads.emplace_back([this, i, onThreadStart] {
+                if (onThreadStart) onThreadStart();
+                handlerLoop((size_t)i);
+            });
+        }
+    }
+
+    /// @brief Finishes every queued request, then joins the handler threads
+    /// Requests submitted afterwards run on the submitting thread
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            accepting = false;
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        spaceAvailable.notify_all();
+        for (std::thread& t : threads) t.join();
+        threads.clear();
+    }
+
+    /// @brief Number of handler threads (0 when not running)
+    int size() const { return (int)threads.size(); }
+
+    /// @brief Requests currently waiting for a handler
+    size_t queued() const { return pending.load(std::memory_order_relaxed); }
+
+    /// @brief Connection threads currently admitted
+    size_t connections() const { return liveConnections.load(std::memory_order_relaxed); }
+
+    /// @brief Connection thread cap set by start() (0 = no cap)
+    size_t connectionLimit() const { return maxConnections; }
+
+    /// @brief Waits for a connection slot, then takes it (pair with releaseConnection())
+    /// Called by the accept loop before accept(), so at the cap clients queue in the listen backlog
+    /// @param cancelled Polled every 100 ms while waiting (e.g. the server is shutting down)
+    /// @return False if cancelled before a slot freed up
+    template <typename Cancelled>
+    bool admitConnection(Cancelled&& cancelled) {
+        std::unique_lock<std::mutex> lock(connectionMutex);
+        if (maxConnections > 0 && liveConnections.load(std::memory_order_relaxed) >= maxConnections) {
+            acceptsThrottled.fetch_add(1, std::memory_order_relaxed);
+            while (liveConnections.load(std::memory_order_relaxed) >= maxConnections) {
+                if (cancelled()) return false;
+                connectionFreed.wait_for(lock, std::chrono::milliseconds(100));
+            }
+        }
+        long live = (long)liveConnections.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (live > peakConnections.load(std::memory_order_relaxed)) peakConnections.store(live, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// @brief Gives back a slot taken by admitConnection() (the connection thread is finishing)
+    void releaseConnection() {
+        {
+            std::lock_guard<std::mutex> lock(connectionMutex);
+            liveConnections.fetch_sub(1, std::memory_order_relaxed);
+        }
+        connectionFreed.notify_one();
+    }
+
+    /// @brief Runs fn on a handler thread and waits for it to return
+    /// Waits for a queue slot first if queueLimit requests are already waiting. Without
+    /// handler threads fn runs here, as before the pool existed.
+    template <typename Fn>
+    void run(Fn&& fn) {
+        Task task;
+        task.invoke = [](void* context) { (*static_cast<std::remove_reference_t<Fn>*>(context))(); };
+        task.context = static_cast<void*>(std::addressof(fn));
+        task.queuedAt = std::chrono::steady_clock::now();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (accepting && pending.load(std::memory_order_relaxed) >= options.queueLimit) {
+                throttled.fetch_add(1, std::memory_order_relaxed);
+                spaceAvailable.wait(lock, [&] {
+                    return !accepting || pending.load(std::memory_order_relaxed) < options.queueLimit;
+                });
+            }
+            if (!accepting) {
+                lock.unlock();
+                fn();
+                return;
+            }
+            long length = (long)pending.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (length > peakQueued.load(std::memory_order_relaxed)) peakQueued.store(length, std::memory_order_relaxed);
+
+            // Pushed while holding the pool mutex, so stop() cannot finish before it is queued
+            Queue& queue = *queues[nextQueue++ % queues.size()];
+            std::lock_guard<std::mutex> queueLock(queue.mutex);
+            queue.tasks.push_back(&task);
+        }
+        workAvailable.notify_one();
+
+        std::unique_lock<std::mutex> lock(task.mutex);
+        task.finished.wait(lock, [&] { return task.done; });
+    }
+
+private:
+    /// @brief One submitted request; lives on the submitter's stack until done
+    struct Task {
+        void (*invoke)(void*) = nullptr;
+        void* context = nullptr;
+        std::chrono::steady_clock::time_point queuedAt;
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done = false;
+    };
+
+    /// @brief A handler's deque (own end: front, thieves: back)
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task*> tasks;
+    };
+
+    /// @brief Takes a task from handler self's deque, or steals one from another handler
+    Task* take(size_t self) {
+        for (size_t i = 0; i < queues.size(); i++) {
+            Queue& queue = *queues[(self + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            Task* task;
+            if (i == 0) {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            } else {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+                stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+        return nullptr;
+    }
+
+    void handlerLoop(size_t self) {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workAvailable.wait(lock, [&] { return pending.load(std::memory_order_relaxed) > 0 || stopping; });
+                if (pending.load(std::memory_order_relaxed) == 0) return;  // Stopping and drained
+            }
+            Task* task = take(self);
+            if (task == nullptr) {
+                std::this_thread::yield();  // Another handler took it first
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending.fetch_sub(1, std::memory_order_relaxed);
+            }
+            spaceAvailable.notify_one();
+
+            long waitUs = (long)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - task->queuedAt).count();
+            waitUsTotal.fetch_add(waitUs, std::memory_order_relaxed);
+            if (waitUs > waitUsMax.load(std::memory_order_relaxed)) waitUsMax.store(waitUs, std::memory_order_relaxed);
+
+            task->invoke(task->context);
+            executed.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(task->mutex);
+                task->done = true;
+                task->finished.notify_one();  // Under the lock: the task is gone once its owner wakes
+            }
+        }
+    }
+
+    RequestPoolOptions options;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex mutex;                        // Guards admission, stopping and handler sleep
+    std::condition_variable workAvailable;   // Handlers wait here for pending > 0
+    std::condition_variable spaceAvailable;  // Throttled submitters wait here for a slot
+    std::atomic<size_t> pending{0};          // Queued, not yet taken by a handler
+    size_t nextQueue = 0;                    // Round-robin submission target (guarded by mutex)
+    bool accepting = false;
+    bool stopping = false;
+
+    std::mutex connectionMutex;                // Guards connection admission
+    std::condition_variable connectionFreed;   // The accept loop waits here at the cap
+    std::atomic<size_t> liveConnections{0};    // Admitted connection threads still running
+    std::atomic<size_t> maxConnections{0};     // From options (0 = no cap)
+};
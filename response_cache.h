@@ -0,0 +1,180 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Immutable block of response bytes, shared between the cache and every send queue
+using ResponseChunk = std::shared_ptr<const std::string>;
+
+/// @brief A response ready for the send path: one or more shared, immutable chunks
+/// Small responses are a single chunk that owns its string; cached GET_BOARD responses
+/// reuse the cache's chunks, so sending them copies nothing
+struct WireResponse {
+    std::vector<ResponseChunk> chunks;
+
+    WireResponse() = default;
+    WireResponse(std::string bytes) {
+        if (!bytes.empty()) chunks.push_back(std::make_shared<const std::string>(std::move(bytes)));
+    }
+    WireResponse(const char* bytes) : WireResponse(std::string(bytes)) {}
+
+    /// @brief Total number of bytes
+    size_t size() const {
+        size_t total = 0;
+        for (const ResponseChunk& chunk : chunks) total += chunk->size();
+        return total;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /// @brief The first chunk, without copying (the event log keeps at most its first bytes)
+    std::string_view front() const { return chunks.empty() ? std::string_view() : std::string_view(*chunks.front()); }
+
+    /// @brief Copies the first maxBytes bytes (for logging)
+    std::string head(size_t maxBytes) const {
+        std::string out;
+        for (const ResponseChunk& chunk : chunks) {
+            if (out.size() >= maxBytes) break;
+            out.append(*chunk, 0, maxBytes - out.size());
+        }
+        return out;
+    }
+
+    /// @brief Copies every chunk into one string (tests and diagnostics)
+    std::string flatten() const { return head(size()); }
+};
+
+/// @brief Cache of serialized GET_BOARD responses, extended in place as posts are appended
+///
+/// One entry per filter key (the unfiltered board plus the most recently used filters).
+/// An entry remembers how many board posts it covers; when the board has grown it asks the
+/// caller to serialize only the new posts as a new chunk and publishes a new WireResponse that
+/// shares all earlier chunks, so an extension copies nothing already cached. Once more than
+/// MERGE_CHUNKS small chunks trail the body they are merged into one, which keeps the chunk
+/// count (and the iovecs per send) bounded. The board is append-only, so cached bytes never go
+/// stale; a cleared board (new BoardStore generation) drops every entry.
+class ResponseCache {
+public:
+    static constexpr size_t CHUNK_BYTES = 64 * 1024;  // Chunks smaller than this count as small
+    static constexpr size_t MERGE_CHUNKS = 32;        // Merge the trailing small chunks once there are more
+    static constexpr size_t MAX_FILTER_ENTRIES = 256; // Filtered responses kept (least recently used is evicted)
+
+    std::atomic<long> hits{0};        // Served as cached (board unchanged since the entry was built)
+    std::atomic<long> extensions{0};  // Served after serializing only the posts added since
+    std::atomic<long> misses{0};      // Built from the whole board (new key, or evicted)
+
+    /// @brief Returns the response for a filter key covering at least the first count posts
+    /// @param key Filter key (see filterKey); the unfiltered board is filterKey("", "")
+    /// @param count Number of published board posts the caller observed
+    /// @param generation BoardStore::generation() the count was read under
+    /// @param head Bytes before the first post (e.g. "GET_BOARD")
+    /// @param tail Bytes after the last post (the transmission terminator)
+    /// @param extend Called as extend(out, first, last, needSeparator): appends the serialized
+    ///               matching posts among board posts [first, last) to out and returns how many
+    template <typename Extend>
+    std::shared_ptr<const WireResponse> get(const std::string& key, size_t count, uint64_t generation,
+                                            std::string_view head, std::string_view tail, Extend&& extend) {
+        std::shared_ptr<Entry> entry = findOrCreate(key, generation, head, tail);
+
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        if (entry->response != nullptr && entry->covered >= count) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->response;
+        }
+        (entry->response == nullptr ? misses : extensions).fetch_add(1, std::memory_order_relaxed);
+
+        // The new posts become their own chunk; earlier chunks are shared, never copied
+        std::string fresh;
+        entry->posts += extend(fresh, entry->covered, count, entry->posts > 0);
+        entry->covered = count;
+        if (!fresh.empty()) {
+            entry->smallTail = (fresh.size() < CHUNK_BYTES) ? entry->smallTail + 1 : 0;
+            entry->body.push_back(std::make_shared<const std::string>(std::move(fresh)));
+        }
+        if (entry->smallTail > MERGE_CHUNKS) mergeSmallTail(*entry);
+
+        auto response = std::make_shared<WireResponse>();
+        response->chunks.reserve(entry->body.size() + 2);
+        response->chunks.push_back(entry->head);
+        response->chunks.insert(response->chunks.end(), entry->body.begin(), entry->body.end());
+        response->chunks.push_back(entry->tail);
+        entry->response = response;
+        return response;
+    }
+
+    /// @brief Cache key for a pair of exact-match filters
+    static std::string filterKey(std::string_view authorFilter, std::string_view titleFilter) {
+        std::string key = std::to_string(authorFilter.size()) + ':';
+        key += authorFilter;
+        key += titleFilter;
+        return key;
+    }
+
+private:
+    struct Entry {
+        std::mutex mutex;                           // Serializes building/extending this entry
+        ResponseChunk head, tail;
+        std::vector<ResponseChunk> body;            // Serialized posts, in board order
+        size_t covered = 0;                         // Board posts [0, covered) are serialized
+        size_t posts = 0;                           // How many of them matched the filter
+        size_t smallTail = 0;                       // Trailing body chunks under CHUNK_BYTES
+        std::shared_ptr<const WireResponse> response;  // head + body + tail, shared with senders
+        uint64_t lastUsed = 0;
+    };
+
+    /// @brief Replaces an entry's trailing small chunks with one chunk holding the same bytes
+    /// The merged chunk stays mergeable until it reaches CHUNK_BYTES, so each byte is copied a
+    /// bounded number of times instead of once per extension
+    static void mergeSmallTail(Entry& entry) {
+        size_t first = entry.body.size() - entry.smallTail;
+        size_t bytes = 0;
+        for (size_t i = first; i < entry.body.size(); i++) bytes += entry.body[i]->size();
+        std::string merged;
+        merged.reserve(bytes);
+        for (size_t i = first; i < entry.body.size(); i++) merged += *entry.body[i];
+        entry.body.resize(first);
+        entry.body.push_back(std::make_shared<const std::string>(std::move(merged)));
+        entry.smallTail = (bytes < CHUNK_BYTES) ? 1 : 0;
+    }
+
+    /// @brief Looks up (or inserts) the entry for a key, dropping everything on a new generation
+    std::shared_ptr<Entry> findOrCreate(const std::string& key, uint64_t generation,
+                                        std::string_view head, std::string_view tail) {
+        std::lock_guard<std::mutex> lock(mapMutex);
+        if (generation != cachedGeneration) {
+            entries.clear();
+            cachedGeneration = generation;
+        }
+
+        std::shared_ptr<Entry>& slot = entries[key];
+        if (slot == nullptr) {
+            if (entries.size() > MAX_FILTER_ENTRIES + 1) evictOldest(key);
+            slot = std::make_shared<Entry>();
+            slot->head = std::make_shared<const std::string>(head);
+            slot->tail = std::make_shared<const std::string>(tail);
+        }
+        slot->lastUsed = ++useClock;
+        return slot;
+    }
+
+    /// @brief Drops the least recently used filtered entry (never the unfiltered board or keep)
+    void evictOldest(const std::string& keep) {
+        static const std::string unfiltered = filterKey("", "");
+        auto oldest = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->first == keep || it->first == unfiltered || it->second == nullptr) continue;
+            if (oldest == entries.end() || it->second->lastUsed < oldest->second->lastUsed) oldest = it;
+        }
+        if (oldest != entries.end()) entries.erase(oldest);
+    }
+
+    std::mutex mapMutex;  // Guards the map, useClock and cachedGeneration (never held while serializing)
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+    uint64_t cachedGeneration = 0;
+    uint64_t useClock = 0;
+};
@@ -0,0 +1,354 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "board_index.h"
+#include "board_store.h"
+
+/// @brief What a SEARCH asks for; every non-empty part must match
+struct SearchQuery {
+    std::string_view words;    // Words that must all occur in the author, title or message (any case)
+    std::string_view author;   // Substring of the author (exact case, like the GUI filter)
+    std::string_view title;    // Substring of the title
+    std::string_view message;  // Substring of the message
+    size_t limit = SIZE_MAX;   // Return at most this many posts (the newest ones)
+};
+
+/// @brief Ascending post ids, stored as varint-encoded gaps (about 1-2 bytes per id)
+/// Ids must be pushed in increasing order; the list is read newest first
+class PostingList {
+public:
+    /// @brief Appends id (ignored if it equals the last id, so a post is listed once)
+    void push(uint32_t id) {
+        if (count > 0 && id == last) return;
+        uint32_t gap = count > 0 ? id - last : id;
+        while (gap >= 0x80) {
+            bytes.push_back((uint8_t)(gap | 0x80));
+            gap >>= 7;
+        }
+        bytes.push_back((uint8_t)gap);
+        last = id;
+        count++;
+    }
+
+    size_t size() const { return count; }
+
+    /// @brief Where a newest-first walk stopped; stays valid as ids are appended
+    struct Cursor {
+        uint32_t id = 0;   // Next id to return
+        size_t end = 0;    // One past the varint that encodes id's gap
+        bool started = false;
+        bool done = false;
+    };
+
+    /// @brief Calls fn(id) from the cursor's id down until fn returns false (that id is consumed)
+    /// A fresh cursor starts at the newest id; call again with the same cursor to resume
+    template <typename Fn>
+    void walkNewestFirst(Cursor& at, Fn&& fn) const {
+        if (!at.started) {
+            at.started = true;
+            at.done = count == 0;
+            at.id = last;
+            at.end = bytes.size();
+        }
+        while (!at.done) {
+            bool more = fn(at.id);
+            // Only the last byte of a varint has the high bit clear
+            size_t begin = at.end - 1;
+            while (begin > 0 && (bytes[begin - 1] & 0x80)) begin--;
+            if (begin == 0) {
+                at.done = true;  // id was the first entry
+            } else {
+                uint32_t gap = 0;
+                for (size_t i = at.end; i-- > begin;) gap = gap << 7 | (bytes[i] & 0x7F);
+                at.id -= gap;
+                at.end = begin;
+            }
+            if (!more) return;
+        }
+    }
+
+private:
+    std::vector<uint8_t> bytes;
+    uint32_t last = 0;
+    size_t count = 0;
+};
+
+/// @brief Full-text and substring search over the board
+///
+/// Three indexes, built incrementally as posts are published:
+///  - words: each lowercased word of a post's author, title and message -> post ids
+///  - message trigrams: every 3-byte sequence of a message -> post ids
+///  - name trigrams: every 3-byte sequence of a distinct author/title -> its names() id
+/// Authors and titles repeat, so a name substring is matched against the distinct names
+/// first and then expanded to posts through BoardIndex's per-name posting lists.
+/// The indexes only propose candidates: a query walks its shortest candidate list (the
+/// rarest word or trigram, or the posts of the matching names) newest first and checks
+/// every part of the query against the post's text, so a query with a limit stops as soon
+/// as it has enough posts. Candidates are gathered in batches under the index locks and
+/// checked after releasing them, so searches never hold up publishing. Substrings shorter
+/// than a trigram have no list and are checked on the candidates; when nothing else narrows
+/// the search, only the newest UNINDEXED_SCAN_LIMIT posts are checked.
+class SearchIndex {
+public:
+    /// @brief Indexes board posts [first, first + count) and any earlier posts not yet indexed
+    /// Safe from any thread after the posts are published; concurrent callers index in board order
+    void add(const BoardStore& board, size_t first, size_t count) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        indexUpTo(board, first + count);
+    }
+
+    /// @brief Runs a query against the first count posts
+    /// Candidates are collected in batches under the index locks and checked against the
+    /// (lock-free) board after the locks are released, so a slow query never stalls add()
+    /// @param board The indexed board
+    /// @param names The board's author/title index (turns matching names into posts)
+    /// @param count Number of published posts the caller observed (board.size())
+    /// @return Matching board indexes, newest first
+    std::vector<uint32_t> search(const BoardStore& board, BoardIndex& names, size_t count, const SearchQuery& query) {
+        std::vector<uint32_t> ids;
+        if (query.limit == 0) return ids;
+        std::vector<std::string> queryWords;
+        std::string word;
+        forEachWord(query.words, word, [&](const std::string& w) { queryWords.push_back(w); });
+
+        // Plan under the shared lock: pick the shortest candidate list; a part with nothing
+        // indexed matches no post
+        const PostingList* driver = nullptr;
+        std::vector<uint32_t> authorNames, titleNames;
+        size_t driverPosts = SIZE_MAX, authorPosts = SIZE_MAX, titlePosts = SIZE_MAX;
+        uint64_t plannedFor = 0;
+        {
+            std::shared_lock<std::shared_mutex> shared(mutex);
+            if (generation != board.generation() || indexed < count) {
+                // Catch up on posts not indexed yet (published by another path, or a cleared board)
+                shared.unlock();
+                {
+                    std::unique_lock<std::shared_mutex> lock(mutex);
+                    indexUpTo(board, count);
+                }
+                shared.lock();
+            }
+            plannedFor = generation;
+            for (const std::string& w : queryWords) {
+                auto it = words.find(w);
+                if (it == words.end()) return ids;
+                if (driver == nullptr || it->second.size() < driver->size()) driver = &it->second;
+            }
+            if (query.message.size() >= 3) {
+                const PostingList* list = rarestGram(messageGrams, query.message);
+                if (list == nullptr) return ids;
+                if (driver == nullptr || list->size() < driver->size()) driver = list;
+            }
+            if (driver != nullptr) driverPosts = driver->size();
+            if (!query.author.empty()) authorNames = matchingNames(board, query.author);
+            if (!query.title.empty()) titleNames = matchingNames(board, query.title);
+        }
+        if (!query.author.empty()) {
+            authorPosts = names.countNames(board, count, false, authorNames);
+            if (authorPosts == 0) return ids;
+        }
+        if (!query.title.empty()) {
+            titlePosts = names.countNames(board, count, true, titleNames);
+            if (titlePosts == 0) return ids;
+        }
+
+        // Check one batch of candidates outside the locks; false once the limit is reached
+        std::vector<uint32_t> candidates;
+        std::vector<char> found;
+        auto check = [&]() {
+            for (uint32_t id : candidates) {
+                if (matches(board.at(id), query, queryWords, found, word)) ids.push_back(id);
+                if (ids.size() >= query.limit) return false;
+            }
+            return true;
+        };
+        auto collect = [&](uint32_t id) {
+            if (id < count) candidates.push_back(id);  // Ids past count: batch still being published
+            return candidates.size() < CANDIDATE_BATCH;
+        };
+        if (authorPosts <= titlePosts && authorPosts < driverPosts) {
+            walkNameBatches(board, names, count, false, authorNames, candidates, collect, check);
+        } else if (titlePosts < driverPosts) {
+            walkNameBatches(board, names, count, true, titleNames, candidates, collect, check);
+        } else if (driver != nullptr) {
+            PostingList::Cursor at;
+            do {
+                candidates.clear();
+                std::shared_lock<std::shared_mutex> shared(mutex);
+                if (generation != plannedFor) break;  // driver was freed by a board clear
+                driver->walkNewestFirst(at, collect);
+                shared.unlock();
+                if (!check()) break;
+            } while (!at.done);
+        } else {
+            // Only short message substrings: nothing to narrow with, so check the newest posts
+            // (the board is lock-free) up to a fixed budget rather than the whole board
+            size_t oldest = count > UNINDEXED_SCAN_LIMIT ? count - UNINDEXED_SCAN_LIMIT : 0;
+            for (size_t id = count; id-- > oldest;) {
+                if (matches(board.at((uint32_t)id), query, queryWords, found, word)) ids.push_back((uint32_t)id);
+                if (ids.size() >= query.limit) break;
+            }
+        }
+        return ids;
+    }
+
+    static constexpr size_t CANDIDATE_BATCH = 1024;           // Candidates collected per lock hold
+    static constexpr size_t UNINDEXED_SCAN_LIMIT = 1 << 17;   // Newest posts checked when nothing narrows a query
+
+    /// @brief Splits text into lowercased words (runs of ASCII letters/digits and non-ASCII bytes)
+    /// @param scratch Reused buffer for the current word
+    /// @param fn Called with each word
+    template <typename Fn>
+    static void forEachWord(std::string_view text, std::string& scratch, Fn&& fn) {
+        scratch.clear();
+        for (size_t i = 0; i <= text.size(); i++) {
+            unsigned char c = i < text.size() ? (unsigned char)text[i] : ' ';
+            bool wordChar = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+            if (wordChar) {
+                scratch += (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : (char)c;
+            } else if (!scratch.empty()) {
+                fn(scratch);
+                scratch.clear();
+            }
+        }
+    }
+
+private:
+    using Grams = std::unordered_map<uint32_t, PostingList>;
+
+    static uint32_t gramAt(std::string_view text, size_t i) {
+        return (uint32_t)(unsigned char)text[i] << 16 | (uint32_t)(unsigned char)text[i + 1] << 8 |
+               (uint32_t)(unsigned char)text[i + 2];
+    }
+
+    /// @brief The shortest trigram list of needle (size >= 3), or nullptr if a trigram is unused
+    template <typename Map>
+    static const typename Map::mapped_type* rarestGram(const Map& grams, std::string_view needle) {
+        const typename Map::mapped_type* rarest = nullptr;
+        for (size_t i = 0; i + 3 <= needle.size(); i++) {
+            auto it = grams.find(gramAt(needle, i));
+            if (it == grams.end()) return nullptr;
+            if (rarest == nullptr || it->second.size() < rarest->size()) rarest = &it->second;
+        }
+        return rarest;
+    }
+
+    /// @brief Whether a post satisfies every part of the query (checked on its text)
+    /// @param found Scratch flags, one per query word
+    /// @param word Scratch word buffer
+    static bool matches(const PostView& post, const SearchQuery& query, const std::vector<std::string>& queryWords,
+                        std::vector<char>& found, std::string& word) {
+        if (post.author.find(query.author) == std::string_view::npos ||
+            post.title.find(query.title) == std::string_view::npos ||
+            post.message.find(query.message) == std::string_view::npos) {
+            return false;
+        }
+        if (queryWords.empty()) return true;
+        found.assign(queryWords.size(), 0);
+        size_t missing = queryWords.size();
+        auto check = [&](const std::string& w) {
+            for (size_t k = 0; k < queryWords.size(); k++) {
+                if (!found[k] && queryWords[k] == w) {
+                    found[k] = 1;
+                    missing--;
+                }
+            }
+        };
+        forEachWord(post.author, word, check);
+        forEachWord(post.title, word, check);
+        forEachWord(post.message, word, check);
+        return missing == 0;
+    }
+
+    /// @brief Walks the posts of the given names in batches, each collected under BoardIndex's
+    /// lock and then passed to check() after the lock is released
+    template <typename Collect, typename Check>
+    static void walkNameBatches(const BoardStore& board, BoardIndex& names, size_t count, bool titles,
+                                const std::vector<uint32_t>& nameIds, std::vector<uint32_t>& candidates,
+                                Collect& collect, Check& check) {
+        size_t below = count;
+        while (below > 0) {
+            candidates.clear();
+            names.walkNames(board, below, titles, nameIds, collect);
+            if (candidates.empty() || !check() || candidates.size() < CANDIDATE_BATCH) return;
+            below = candidates.back();  // Resume below the oldest post of this batch
+        }
+    }
+
+    /// @brief names() ids of indexed authors/titles containing needle
+    std::vector<uint32_t> matchingNames(const BoardStore& board, std::string_view needle) const {
+        std::vector<uint32_t> ids;
+        auto keep = [&](uint32_t id) {
+            if (board.names().view(id).find(needle) != std::string_view::npos) ids.push_back(id);
+            return true;
+        };
+        if (needle.size() >= 3) {
+            if (const std::vector<uint32_t>* list = rarestGram(nameGramIds, needle)) {
+                for (uint32_t id : *list) keep(id);
+            }
+        } else {
+            for (uint32_t id = 0; id < nameIndexed.size(); id++) {
+                if (nameIndexed[id]) keep(id);
+            }
+        }
+        return ids;
+    }
+
+    /// @brief Indexes a name's trigrams the first time a post uses it
+    void addName(const BoardStore& board, uint32_t id) {
+        if (id >= nameIndexed.size()) nameIndexed.resize((size_t)id + 1, false);
+        if (nameIndexed[id]) return;
+        nameIndexed[id] = true;
+        // Names arrive in first-use order, not id order, so these lists are keyed by insertion
+        std::string_view name = board.names().view(id);
+        for (size_t i = 0; i + 3 <= name.size(); i++) {
+            std::vector<uint32_t>& list = nameGramIds[gramAt(name, i)];
+            if (list.empty() || list.back() != id) list.push_back(id);
+        }
+    }
+
+    /// @brief Indexes posts up to (not including) end; caller holds the exclusive lock
+    void indexUpTo(const BoardStore& board, size_t end) {
+        if (generation != board.generation()) {
+            words.clear();
+            messageGrams.clear();
+            nameGramIds.clear();
+            nameIndexed.clear();
+            indexed = 0;
+            generation = board.generation();
+        }
+        if (indexed >= end) return;
+        // Name ids come from the id columns (mapped posts get theirs interned by the scan)
+        board.scanNames(indexed, end, [&](size_t first, size_t count, const uint32_t* authors, const uint32_t* titles) {
+            for (size_t i = 0; i < count; i++) {
+                uint32_t id = (uint32_t)(first + i);
+                PostView post = board.at(id);
+                addName(board, authors[i]);
+                addName(board, titles[i]);
+                auto addWord = [&](const std::string& w) { words[w].push(id); };
+                forEachWord(post.author, scratch, addWord);
+                forEachWord(post.title, scratch, addWord);
+                forEachWord(post.message, scratch, addWord);
+                for (size_t g = 0; g + 3 <= post.message.size(); g++) messageGrams[gramAt(post.message, g)].push(id);
+            }
+        });
+        indexed = end;
+    }
+
+    std::shared_mutex mutex;     // Writers: add() and catch-up; readers: search()
+    std::unordered_map<std::string, PostingList> words;  // Lowercased word -> post ids
+    Grams messageGrams;          // Message trigram -> post ids
+    std::unordered_map<uint32_t, std::vector<uint32_t>> nameGramIds;  // Author/title trigram -> names() ids
+    std::vector<bool> nameIndexed;  // Per names() id: its trigrams are in nameGramIds
+    std::string scratch;         // Word buffer for indexing (guarded by the exclusive lock)
+    size_t indexed = 0;          // Posts [0, indexed) are in every index
+    uint64_t generation = 0;     // BoardStore::generation() the indexes were built for
+};
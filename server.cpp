@@ -29,14 +29,38 @@
 #include <vector>            // Dynamic arrays
 #include <algorithm>         // Standard algorithms (find, etc.)
 #include <unordered_map>     // Hash map for command lookups
+#include <unordered_set>     // Event-loop connections holding a POST reply
 #include <string_view>       // Non-owning string references
 #include <thread>            // Thread spawning and management
 #include <mutex>             // Mutual exclusion locks
 #include <fstream>           // File stream for file operations
 #include <sstream>           // String stream for string manipulations
+#include <atomic>            // Atomic flags shared between loop threads
+#include <memory>            // Smart pointers for per-connection state
+#include <memory_resource>   // pmr strings/vectors for parsed requests
+#include <deque>             // Per-connection send queues
+#include <sys/uio.h>         // iovec for gathered sends
+
+// Event loop headers (epoll reactor mode)
+#include <sys/epoll.h>       // epoll_create1, epoll_ctl, epoll_wait
+#include <fcntl.h>           // fcntl for non-blocking sockets
+#include <sys/stat.h>        // stat for the pre-segmentation post log file
+#include <poll.h>            // poll for subscribed thread-per-client connections
+
+// Completion-based I/O (io_uring mode) - only when the kernel headers know multishot recv
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_RECV_MULTISHOT)
+#define SERVER_HAVE_IO_URING 1
+#include "uring.h"           // Minimal raw-syscall io_uring wrapper
+#endif
+#endif
 
 // Project-specific headers
 #include "shared_state.h"    // Global shared server state
+#include "message_framer.h"  // Zero-copy splitting of received bytes into messages
+#include "delimiter_scan.h"  // SIMD scan for }+{, }#{ and }}&{{ (kernel chosen by CPUID)
+#include "request_arena.h"   // Per-connection pmr arena for request parsing
 
 using namespace std;
 
@@ -79,6 +103,9 @@ enum class CLIENT_COMMANDS
 {
     GET_BOARD,          // Client requests all messages (with optional filters)
     POST,               // Client posts one or more new messages
+    SUBSCRIBE,          // Client asks for new posts to be pushed (with optional filters)
+    UNSUBSCRIBE,        // Client stops the pushes
+    SEARCH,             // Client searches posts by words and/or author/title/message substrings
     INVALID_COMMAND,    // Unknown command received from client
     QUIT                // Client gracefully closes connection
 };
@@ -88,6 +115,9 @@ enum class CLIENT_COMMANDS
 const std::unordered_map<std::string_view, CLIENT_COMMANDS> kCmdFromStr{
   {"GET_BOARD", CLIENT_COMMANDS::GET_BOARD},
   {"POST",      CLIENT_COMMANDS::POST},
+  {"SUBSCRIBE", CLIENT_COMMANDS::SUBSCRIBE},
+  {"UNSUBSCRIBE", CLIENT_COMMANDS::UNSUBSCRIBE},
+  {"SEARCH",    CLIENT_COMMANDS::SEARCH},
   {"INVALID_COMMAND", CLIENT_COMMANDS::INVALID_COMMAND},
   {"QUIT",      CLIENT_COMMANDS::QUIT},
 };
@@ -100,9 +130,15 @@ const std::unordered_map<std::string_view, CLIENT_COMMANDS> kCmdFromStr{
 enum class SERVER_RESPONSES
 {
     GET_BOARD,          // Server responds with message board data
+    GET_BOARD_PAGE,     // Server responds with one window of the board plus a continuation token
     POST_OK,            // Server confirms post was successful
     POST_ERROR,         // Server reports post failed with error
     GET_BOARD_ERROR,    // Server reports get_board failed with error
+    SUBSCRIBE_OK,       // Server confirms a subscription (and the first post id it will push)
+    UNSUBSCRIBE_OK,     // Server confirms the pushes stopped
+    NEW_POST,           // Server pushes one newly accepted post to a subscriber
+    SUBSCRIBE_LAGGED,   // Server skipped posts for a slow subscriber (from the given id on)
+    SEARCH_RESULT,      // Server responds with the posts matching a SEARCH (newest first)
     INVALID_COMMAND     // Server reports unrecognized command
 };
 
@@ -112,7 +148,13 @@ const std::unordered_map<SERVER_RESPONSES, std::string_view> kCmdToStr{
     {SERVER_RESPONSES::POST_OK,    "POST_OK"},
     {SERVER_RESPONSES::POST_ERROR, "POST_ERROR"},
     {SERVER_RESPONSES::GET_BOARD,  "GET_BOARD"},
+    {SERVER_RESPONSES::GET_BOARD_PAGE, "GET_BOARD_PAGE"},
     {SERVER_RESPONSES::GET_BOARD_ERROR, "GET_BOARD_ERROR"},
+    {SERVER_RESPONSES::SUBSCRIBE_OK, "SUBSCRIBE_OK"},
+    {SERVER_RESPONSES::UNSUBSCRIBE_OK, "UNSUBSCRIBE_OK"},
+    {SERVER_RESPONSES::NEW_POST, "NEW_POST"},
+    {SERVER_RESPONSES::SUBSCRIBE_LAGGED, "SUBSCRIBE_LAGGED"},
+    {SERVER_RESPONSES::SEARCH_RESULT, "SEARCH_RESULT"},
     {SERVER_RESPONSES::INVALID_COMMAND, "INVALID_COMMAND"},
 };
 
@@ -120,18 +162,215 @@ const std::unordered_map<SERVER_RESPONSES, std::string_view> kCmdToStr{
 // PARSE RESULT STRUCTURE
 // ============================================================================
 
+/// @brief One (author, title, message) triple of a parsed POST, held in the request's memory
+struct ParsedPost {
+    std::pmr::string author;
+    std::pmr::string title;
+    std::pmr::string message;
+};
+
 /// @brief Represents the result of parsing a client message.
 /// Contains either the parsed command and associated data, or an error message.
 /// This acts as a "variant" to hold either success data or failure details.
+/// Strings and the post array come from the memory resource it was built with (the
+/// connection's RequestArena on the request path, the heap by default).
 struct ParseResult {
-    bool ok;                                    // True if parsing succeeded, false if error occurred
-    std::string error;                          // Non-empty string only on failure; describes the parse error
+    bool ok = false;                            // True if parsing succeeded, false if error occurred
+    std::pmr::string error;                     // Non-empty string only on failure; describes the parse error
     CLIENT_COMMANDS clientCmd = CLIENT_COMMANDS::INVALID_COMMAND;  // The parsed command type
-    std::vector<Post> posts;                    // For POST command: array of (author, title, message) triples
-    std::string filter_author;                  // For GET_BOARD command: optional author filter
-    std::string filter_title;                   // For GET_BOARD command: optional title filter
+    std::pmr::vector<ParsedPost> posts;         // For POST command: array of (author, title, message) triples
+    std::pmr::string filter_author;             // For GET_BOARD/SUBSCRIBE commands: optional author filter (SEARCH: substring)
+    std::pmr::string filter_title;              // For GET_BOARD/SUBSCRIBE commands: optional title filter (SEARCH: substring)
+    std::pmr::string search_words;              // For SEARCH command: words that must all occur
+    std::pmr::string search_message;            // For SEARCH command: message substring
+    bool paged = false;                         // For GET_BOARD command: start/limit fields were sent
+    size_t page_start = 0;                      // For paged GET_BOARD: first post id to consider
+    size_t page_limit = 0;                      // For paged GET_BOARD and SEARCH: max posts returned (0 = no limit)
+
+    ParseResult() = default;
+    explicit ParseResult(std::pmr::memory_resource* memory)
+        : error(memory), posts(memory), filter_author(memory), filter_title(memory),
+          search_words(memory), search_message(memory) {}
 };
 
+// ============================================================================
+// POST LOG (WRITE-AHEAD LOG FOR ACCEPTED POSTS)
+// ============================================================================
+// Board order and log order are the same: the log records are queued from the
+// board store's pre-publish hook, and each record's sequence number is the post's
+// board index. The board file (MessageBoard.board, binary and mmap'd at startup) holds the
+// first N posts, so startup replays only the log records with sequence >= N. A background
+// thread appends new posts to MessageBoard.board every --snapshot-s seconds and then deletes
+// the log segments it covers.
+
+static std::thread g_snapshotThread;           // Periodic saveToFile() (see snapshot_loop)
+static std::atomic<bool> g_stopSnapshots{false};
+
+/// @brief Snapshot thread: saves new posts and compacts the log every intervalSec seconds
+/// saveToFile() walks the board without locks, so POSTs are never blocked by a snapshot
+/// @param intervalSec Seconds between snapshots
+void snapshot_loop(int intervalSec)
+{
+    auto next = std::chrono::steady_clock::now() + std::chrono::seconds(intervalSec);
+    while (!g_stopSnapshots)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (std::chrono::steady_clock::now() < next) continue;
+        g_serverState.saveToFile();
+        next = std::chrono::steady_clock::now() + std::chrono::seconds(intervalSec);
+    }
+}
+
+/// @brief Serializes one post as a subscription push: "NEW_POST}+{id}+{author}+{title}+{message}}&{{"
+/// @param post The newly published post
+/// @param id Its board index (the GET_BOARD paging start that would return it)
+std::string encode_pushed_post(const PostView& post, uint64_t id)
+{
+    std::string out(kCmdToStr.at(SERVER_RESPONSES::NEW_POST));
+    out += fieldDelimiter;
+    out += std::to_string(id);
+    out += fieldDelimiter;
+    out += post.author;
+    out += fieldDelimiter;
+    out += post.title;
+    out += fieldDelimiter;
+    out += post.message;
+    out += transmissionTerminator;
+    return out;
+}
+
+/// @brief Appends a batch of posts to the board and waits until it is durable in the post log
+/// Shared by post_handler and the GUI's test-post button so every board append is logged,
+/// indexed by author and title and for SEARCH, and pushed to matching subscribers (in board order)
+/// @param batch The posts to publish (moved from)
+/// @param errorDetails Output: set if the board is full (--max-posts), or the log is closed or could not persist the batch
+/// @param durableTicket If set, return without waiting and store the post log ticket here instead
+///        (0 = nothing to wait for); event loops hold the reply until PostLog::settle() reports it
+/// @return True once the batch reached the configured durability level (or was queued, with durableTicket)
+bool publish_posts(std::vector<Post>&& batch, std::string& errorDetails, uint64_t* durableTicket = nullptr)
+{
+    uint64_t ticket = 0;
+    size_t published = 0;
+    bool appended = g_serverState.messageBoard.tryAppend(std::move(batch), [&](size_t first, size_t count) {
+        // A closed log (shutting down) cannot make the batch durable: drop it rather than acknowledge it
+        if (!g_serverState.postLog.enqueue(g_serverState.messageBoard, first, count, ticket, errorDetails)) return false;
+        published = first + count;
+        g_serverState.boardIndex.add(g_serverState.messageBoard, first, count);
+        g_serverState.subscriptions.publish(first, count,
+            [](size_t id) { return g_serverState.messageBoard.at(id); }, encode_pushed_post);
+        return true;
+    }, errorDetails);
+    if (!appended)
+    {
+        errorDetails = "Failed to post: " + errorDetails;
+        return false;
+    }
+
+    // Word/trigram indexing is the costly part, so it runs outside the board's writer lock
+    // (overlapping the log flush); it indexes every earlier post not yet indexed, in board order
+    g_serverState.searchIndex.add(g_serverState.messageBoard, published, 0);
+
+    if (durableTicket != nullptr)
+    {
+        *durableTicket = ticket;
+        return true;
+    }
+
+    // Group commit: concurrent callers wait here for the flusher's shared write/sync
+    if (!g_serverState.postLog.waitDurable(ticket, errorDetails))
+    {
+        errorDetails = "Failed to persist post: " + errorDetails;
+        return false;
+    }
+    return true;
+}
+
+/// @brief Replays the post log onto the board and opens it for appending (see start_post_log)
+bool open_post_log(const ServerConfig& config, std::string& errorDetails)
+{
+    // A single-file log from before segmentation becomes the first segment
+    struct stat legacy;
+    if (stat(config.postLogPath.c_str(), &legacy) == 0 && S_ISREG(legacy.st_mode) &&
+        rename(config.postLogPath.c_str(), PostLog::segmentPath(config.postLogPath, 0).c_str()) != 0)
+    {
+        errorDetails = "Failed to rename post log " + config.postLogPath + ": " + strerror(errno);
+        return false;
+    }
+
+    // ====================================================================
+    // REPLAY: restore posts accepted after the last MessageBoard.board save
+    // ====================================================================
+    std::vector<Post> recovered;
+    size_t nextSequence = g_serverState.messageBoard.size();
+    bool gap = false;
+    bool ok = PostLog::replay(config.postLogPath, [&](uint64_t sequence, Post&& post) {
+        if (sequence < nextSequence) return;  // Already in the snapshot (or replayed)
+        if (sequence > nextSequence) { gap = true; return; }
+        recovered.push_back(std::move(post));
+        nextSequence++;
+    }, errorDetails);
+    if (!ok) return false;
+    if (gap)
+    {
+        errorDetails = "Post log " + config.postLogPath + " does not continue " + g_serverState.config.snapshotPath +
+                       " (missing posts before sequence " + std::to_string(nextSequence) + ")";
+        return false;
+    }
+
+    if (!recovered.empty())
+    {
+        size_t count = recovered.size();
+        g_serverState.messageBoard.append(std::move(recovered));
+        g_serverState.logEvent("SYSTEM", "Recovered " + std::to_string(count) + " posts from " + config.postLogPath);
+    }
+
+    // ====================================================================
+    // OPEN FOR APPENDING (starts the group-commit flusher)
+    // ====================================================================
+    if (!g_serverState.postLog.open(config.postLogPath, nextSequence, config.postLog, errorDetails)) return false;
+    g_serverState.logEvent("SYSTEM", "Post log " + config.postLogPath + " open (" +
+                           (config.postLog.durability == LogDurability::FSYNC ? "fsync" : "write") + " durability)");
+    return true;
+}
+
+/// @brief Replays the post log onto the board, opens it for appending and starts periodic snapshots
+/// Records already covered by the loaded MessageBoard.board (sequence < board size) are skipped;
+/// a torn tail from a crash mid-write is cut off
+/// @param config Server configuration (log path, durability and snapshot options)
+/// @param errorDetails Output: description of the failure
+/// @return True if the log is ready (or disabled with --wal-sync=none)
+bool start_post_log(const ServerConfig& config, std::string& errorDetails)
+{
+    if (config.postLog.durability == LogDurability::NONE)
+    {
+        // No log file, but the log must forget an earlier close() so POSTs are accepted again
+        if (!g_serverState.postLog.open(config.postLogPath, g_serverState.messageBoard.size(), config.postLog, errorDetails)) return false;
+    }
+    else if (!open_post_log(config, errorDetails))
+    {
+        return false;
+    }
+
+    if (config.snapshotIntervalSec > 0 && !g_snapshotThread.joinable())
+    {
+        g_stopSnapshots = false;
+        g_snapshotThread = std::thread(snapshot_loop, config.snapshotIntervalSec);
+    }
+    return true;
+}
+
+/// @brief Stops the snapshot thread, then flushes and closes the post log
+/// (posts published afterwards are not logged; saveToFile() still captures them)
+void stop_post_log()
+{
+    if (g_snapshotThread.joinable())
+    {
+        g_stopSnapshots = true;
+        g_snapshotThread.join();
+    }
+    g_serverState.postLog.close();
+}
+
 // ============================================================================
 // POST COMMAND HANDLER
 // ============================================================================
@@ -140,8 +379,9 @@ struct ParseResult {
 /// @param parsed The ParseResult containing POST data (array of Post objects)
 /// @param errorDetails Output parameter: set to error message if operation fails
 /// @param clientId The unique ID of the client posting these messages
+/// @param durableTicket If set, do not wait for the post log (see publish_posts)
 /// @return True if all posts were added successfully; false if an error occurred
-bool post_handler(const ParseResult& parsed, std::string& errorDetails, int clientId)
+bool post_handler(const ParseResult& parsed, std::string& errorDetails, int clientId, uint64_t* durableTicket = nullptr)
 {
     // DEBUG: Print what's being posted
     // std::cout << "\n=== POST_HANDLER DEBUG ===" << std::endl;
@@ -155,14 +395,13 @@ bool post_handler(const ParseResult& parsed, std::string& errorDetails, int clie
             return false; // No posts to add
         }
 
-        // Acquire exclusive lock to safely modify the shared message board
-        // All threads will wait for this lock before modifying messageBoard
-        std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
-
-        // Add each post from the parsed array to the shared message board
+        // Copy each post out of the request's memory into board-owned strings, tagged with the posting client
+        std::vector<Post> batch;
+        batch.reserve(parsed.posts.size());
         for (size_t i = 0; i < parsed.posts.size(); i++)
         {
-            Post p = parsed.posts[i];
+            const ParsedPost& parsedPost = parsed.posts[i];
+            Post p{std::string(parsedPost.author), std::string(parsedPost.title), std::string(parsedPost.message)};
             // DEBUG: Detailed post addition logging
             // std::cout << "  Adding Post " << i << ": Author=\"" << p.author 
             //           << "\" Title=\"" << p.title 
@@ -170,14 +409,19 @@ bool post_handler(const ParseResult& parsed, std::string& errorDetails, int clie
             
             // Associate this post with the client that posted it
             p.clientId = clientId;
-            
-            // Add the post to the shared message board (thread-safe under the lock)
-            g_serverState.messageBoard.push_back(p);
-            
-            // Increment the total message counter for statistics
-            g_serverState.totalMessagesReceived++;
+            batch.push_back(std::move(p));
+        }
+
+        // Publish the whole batch at once (concurrent GET_BOARD readers are never blocked)
+        // and wait until the post log has made it durable (unless the caller holds the reply itself)
+        if (!publish_posts(std::move(batch), errorDetails, durableTicket))
+        {
+            return false;
         }
         
+        // Increment the total message counter for statistics
+        g_serverState.stats.add(ServerStats::MESSAGES_RECEIVED, parsed.posts.size());
+        
         // DEBUG: Verify posts were added
         // std::cout << "Total posts in messageBoard after adding: " << g_serverState.messageBoard.size() << std::endl;
         // std::cout << "==========================\n" << std::endl;
@@ -252,11 +496,12 @@ std::string build_post_ok()
 /// @brief Splits a message string into fields based on a delimiter
 /// Only processes up to endPos, allowing partial message parsing
 /// This is used to isolate the actual message from any buffered data that follows it
+/// parse_message uses tokenize_fields instead; this copying version is the reference it must match
 /// @param text The input string to split
 /// @param delim The delimiter string that separates fields (e.g., "}+{")
 /// @param endPos The position in the string up to which to process (acts as a limit)
 /// @return A vector of split field strings
-static std::vector<std::string> split_fields_until(const std::string& text, const std::string& delim, size_t endPos) 
+std::vector<std::string> split_fields_until(const std::string& text, const std::string& delim, size_t endPos) 
 {
     // Vector to accumulate the extracted fields
     std::vector<std::string> out;
@@ -290,29 +535,82 @@ static std::vector<std::string> split_fields_until(const std::string& text, cons
     return out;
 }
 
+/// @brief Splits a message into fields in one left-to-right scan, stopping at the terminator
+/// Same fields as cutting at the first terminator, replacing every post separator with the
+/// field delimiter and calling split_fields_until, but without copying: the fields are
+/// views into text
+/// @param text The message (terminator and anything after it optional); the views point into it
+/// @param scanner Finds field delimiters, post separators (treated as field delimiters) and the terminator
+/// @param out Receives the fields (cleared first; reuse it to avoid allocations)
+static void tokenize_fields(std::string_view text, const DelimiterScanner& scanner, std::vector<std::string_view>& out)
+{
+    out.clear();
+    size_t start = 0;
+    bool terminated = false;
+    scanner.scan(text, 0, [&](size_t pos, DelimiterKind kind) {
+        out.push_back(text.substr(start, pos - start));
+        terminated = (kind == DelimiterKind::TERMINATOR);
+        start = pos + scanner.length(kind);
+        return !terminated;
+    });
+    if (!terminated) out.push_back(text.substr(start));
+}
+
+/// @brief Parses an unsigned decimal GET_BOARD paging field (empty = 0)
+/// @param field The field text, e.g. "25"
+/// @param value Receives the parsed number
+/// @return False if the field is not a plain decimal number that fits in size_t
+static bool parse_page_number(std::string_view field, size_t& value)
+{
+    value = 0;
+    for (char c : field)
+    {
+        if (c < '0' || c > '9') return false;
+        size_t digit = (size_t)(c - '0');
+        if (value > (SIZE_MAX - digit) / 10) return false;
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
 // ============================================================================
 // GET_BOARD COMMAND HANDLER
 // ============================================================================
 
+/// @brief Appends one post in GET_BOARD wire format: [}#{]}+{author}+{title}+{message
+/// Shared by get_board_handler and the response cache so both produce identical bytes
+/// @param out Response being built
+/// @param post The post to append (views may point into the mapped board file)
+/// @param separator True for every post except the first one in the response
+static void append_board_post(std::string& out, const PostView& post, bool separator)
+{
+    if (separator) out += messageSeperator;
+    out += fieldDelimiter;
+    out += post.author;
+    out += fieldDelimiter;
+    out += post.title;
+    out += fieldDelimiter;
+    out += post.message;
+}
+
 /// @brief Handles the GET_BOARD command - returns the message board, optionally filtered
 /// Retrieves all posts from the message board and formats them in wire format
 /// Can optionally filter by author name and/or title
 /// @param authorFilter Optional filter: only return posts by this author (empty = no filter)
 /// @param titleFilter Optional filter: only return posts with this exact title (empty = no filter)
 /// @return A formatted wire-format string containing the filtered message board
-std::string get_board_handler(const std::string& authorFilter, const std::string& titleFilter)
+std::string get_board_handler(std::string_view authorFilter, std::string_view titleFilter)
 {
-    // Acquire exclusive lock to safely read from the shared message board
-    // Prevents other threads from modifying messageBoard while we're reading it
-    std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
+    // No lock needed: the board store only ever appends, and forEach() walks the
+    // posts that were published when it started (concurrent POSTs are not blocked)
     
     // DEBUG: Detailed board state logging
     // std::cout << "\n=== GET_BOARD_HANDLER DEBUG ===" << std::endl;
     // std::cout << "Total posts in messageBoard: " << g_serverState.messageBoard.size() << std::endl;
     // for (size_t i = 0; i < g_serverState.messageBoard.size(); i++) {
-    //     std::cout << "  Post " << i << ": Author=\"" << g_serverState.messageBoard[i].author 
-    //               << "\" Title=\"" << g_serverState.messageBoard[i].title 
-    //               << "\" Message=\"" << g_serverState.messageBoard[i].message << "\"" << std::endl;
+    //     std::cout << "  Post " << i << ": Author=\"" << g_serverState.messageBoard.at(i).author 
+    //               << "\" Title=\"" << g_serverState.messageBoard.at(i).title 
+    //               << "\" Message=\"" << g_serverState.messageBoard.at(i).message << "\"" << std::endl;
     // }
     // std::cout << "Filters: Author=\"" << authorFilter << "\" Title=\"" << titleFilter << "\"" << std::endl;
     
@@ -324,30 +622,33 @@ std::string get_board_handler(const std::string& authorFilter, const std::string
     // Start the message with the GET_BOARD command identifier
     allMessages += command;
 
-    // Iterate through all posts in the message board and append matching ones to the response
+    // Append every post (no filter) or only the indexed matches to the response
     // Use message separator }#{ between posts and field delimiter }+{ within post data
     bool firstPost = true;           // Track if this is the first post (no separator needed)
     int postsIncluded = 0;           // Count how many posts matched the filters
-    for (const Post& post : g_serverState.messageBoard)
+    auto appendPost = [&](const PostView& post)
     {
-        // Apply author filter: skip if authorFilter is set and doesn't match post's author
-        if (!authorFilter.empty() && post.author != authorFilter) continue;
-        
-        // Apply title filter: skip if titleFilter is set and doesn't match post's title
-        if (!titleFilter.empty() && post.title != titleFilter) continue;
-        
-        // Add message separator BEFORE each post except the first one
-        // This follows the wire format where posts are separated by }#{
-        if (!firstPost) {
-            allMessages += messageSeperator;
-        }
+        // Message separator }#{ goes BEFORE each post except the first one
+        append_board_post(allMessages, post, !firstPost);
         
         // Mark that we've added at least one post (so separators are needed before subsequent posts)
         firstPost = false;
         postsIncluded++;  // Increment counter for statistics
-        
-        // Append this post's data in wire format: }+{author}+{title}+{message
-        allMessages += fieldDelimiter + post.author + fieldDelimiter + post.title + fieldDelimiter + post.message;
+    };
+
+    if (authorFilter.empty() && titleFilter.empty())
+    {
+        g_serverState.messageBoard.forEach(appendPost);
+    }
+    else
+    {
+        // Filtered: walk only the matching ids from the author/title posting lists
+        // (intersected when both filters are set), never the whole board
+        size_t count = g_serverState.messageBoard.size();
+        for (uint32_t id : g_serverState.boardIndex.lookup(g_serverState.messageBoard, count, authorFilter, titleFilter))
+        {
+            appendPost(g_serverState.messageBoard.at(id));
+        }
     }
 
     // DEBUG: Verify response assembly
@@ -362,6 +663,117 @@ std::string get_board_handler(const std::string& authorFilter, const std::string
     return allMessages;
 }
 
+/// @brief Handles a paged GET_BOARD - returns one window of the board and where the next one starts
+/// Reply: "GET_BOARD_PAGE}+{next}+{author1}+{title1}+{msg1}#{...}}&{{" where next is the continuation
+/// token (the start to send on the next poll). Only posts with id >= start are touched, so a client
+/// that polls with its last token pays for new posts only, not for the whole history
+/// @param authorFilter Optional filter: only return posts by this author (empty = no filter)
+/// @param titleFilter Optional filter: only return posts with this exact title (empty = no filter)
+/// @param start First post id (board index) to consider
+/// @param limit Maximum number of posts to return (0 = no limit)
+/// @return A formatted wire-format string containing the window
+std::string get_board_page_handler(std::string_view authorFilter, std::string_view titleFilter,
+                                   size_t start, size_t limit)
+{
+    const BoardStore& board = g_serverState.messageBoard;
+    size_t count = board.size();
+    size_t maxPosts = limit == 0 ? SIZE_MAX : limit;
+
+    // Collect the window first: the continuation token goes before the posts
+    std::string posts;
+    // Caught up unless the limit cuts the window short (a start past the end, e.g. a token from
+    // before the board was cleared, also resumes at the current end)
+    size_t next = count;
+    if (authorFilter.empty() && titleFilter.empty())
+    {
+        size_t end = start < count ? start + std::min(maxPosts, count - start) : start;
+        for (size_t i = start; i < end; i++)
+        {
+            append_board_post(posts, board.at(i), i > start);
+        }
+        if (end < count) next = end;
+    }
+    else
+    {
+        std::vector<uint32_t> ids = g_serverState.boardIndex.lookup(board, count, authorFilter, titleFilter, start, maxPosts);
+        for (size_t k = 0; k < ids.size(); k++)
+        {
+            append_board_post(posts, board.at(ids[k]), k > 0);
+        }
+        // A full page may have more matches after it; resume right after its last post
+        if (ids.size() == maxPosts) next = (size_t)ids.back() + 1;
+    }
+
+    std::string response = std::string(kCmdToStr.at(SERVER_RESPONSES::GET_BOARD_PAGE));
+    response += fieldDelimiter;
+    response += std::to_string(next);
+    response += posts;
+    response += transmissionTerminator;
+    return response;
+}
+
+// ============================================================================
+// SEARCH COMMAND HANDLER
+// ============================================================================
+
+/// @brief Handles the SEARCH command - returns matching posts, newest first
+/// Reply: "SEARCH_RESULT}+{id1}+{author1}+{title1}+{msg1}#{}+{id2}+...}}&{{" where id is the post's
+/// board index (a paged GET_BOARD start); no matches is just "SEARCH_RESULT}}&{{"
+/// @param query What to look for (see SearchQuery)
+/// @return A formatted wire-format string containing the matches
+std::string search_handler(const SearchQuery& query)
+{
+    const BoardStore& board = g_serverState.messageBoard;
+    std::vector<uint32_t> ids = g_serverState.searchIndex.search(board, g_serverState.boardIndex, board.size(), query);
+
+    std::string response = std::string(kCmdToStr.at(SERVER_RESPONSES::SEARCH_RESULT));
+    for (size_t k = 0; k < ids.size(); k++)
+    {
+        PostView post = board.at(ids[k]);
+        if (k > 0) response += messageSeperator;
+        response += fieldDelimiter;
+        response += std::to_string(ids[k]);
+        append_board_post(response, post, false);
+    }
+    response += transmissionTerminator;
+    return response;
+}
+
+/// @brief Returns the GET_BOARD response from the response cache
+/// Same bytes as get_board_handler(), but the unfiltered board and recently used filters are
+/// kept serialized: a repeat request returns the cached chunks, and after a POST only the new
+/// posts are serialized (filtered entries take them from the author/title index)
+/// @param authorFilter Optional filter: only return posts by this author (empty = no filter)
+/// @param titleFilter Optional filter: only return posts with this exact title (empty = no filter)
+/// @return The shared, immutable response (hand its chunks to the send path as-is)
+std::shared_ptr<const WireResponse> cached_board_response(std::string_view authorFilter, std::string_view titleFilter)
+{
+    const BoardStore& board = g_serverState.messageBoard;
+    uint64_t generation = board.generation();
+    size_t count = board.size();
+    bool filtered = !authorFilter.empty() || !titleFilter.empty();
+
+    return g_serverState.responseCache.get(ResponseCache::filterKey(authorFilter, titleFilter), count, generation,
+        kCmdToStr.at(SERVER_RESPONSES::GET_BOARD), transmissionTerminator,
+        [&](std::string& out, size_t first, size_t last, bool needSeparator) -> size_t
+        {
+            if (!filtered)
+            {
+                for (size_t i = first; i < last; i++)
+                {
+                    append_board_post(out, board.at(i), needSeparator || i > first);
+                }
+                return last - first;
+            }
+            std::vector<uint32_t> ids = g_serverState.boardIndex.lookup(board, last, authorFilter, titleFilter, first);
+            for (size_t k = 0; k < ids.size(); k++)
+            {
+                append_board_post(out, board.at(ids[k]), needSeparator || k > 0);
+            }
+            return ids.size();
+        });
+}
+
 // ============================================================================
 // MESSAGE PARSING FUNCTION
 // ============================================================================
@@ -369,17 +781,22 @@ std::string get_board_handler(const std::string& authorFilter, const std::string
 /// @brief Parses a complete message received from a client
 /// Handles variable field delimiters and message separators
 /// Returns a ParseResult with either parsed data or error details
-/// @param completeMessage The raw message string to parse (must include terminator)
+/// Fields are string_views into completeMessage (found in one scan that recognises both
+/// delimiters); strings are only built for what the result keeps (filters, posts)
+/// @param completeMessage The raw message to parse (terminator optional)
 /// @param fieldDelimiter String used to separate fields (normally "}+{")
 /// @param messageSeperator String used to separate multiple messages (normally "}#{")
 /// @param transmissionTerminator String marking end of transmission (normally "}}&{{")
+/// @param memory Where the result's strings and post array live (the connection's RequestArena
+///        on the request path; the result must not outlive it)
 /// @return ParseResult containing parsed command/data or error details
-ParseResult parse_message(const std::string& completeMessage,
-                          const std::string& fieldDelimiter,
-                          const std::string& messageSeperator,
-                          const std::string& transmissionTerminator)
+ParseResult parse_message(std::string_view completeMessage,
+                          std::string_view fieldDelimiter,
+                          std::string_view messageSeperator,
+                          std::string_view transmissionTerminator,
+                          std::pmr::memory_resource* memory = std::pmr::get_default_resource())
 {
-    ParseResult res{};     // Initialize result structure with defaults
+    ParseResult res(memory);  // Initialize result structure with defaults
     res.ok = false;        // Assume failure until parsing succeeds
 
     // DEBUG: Detailed message parsing logging
@@ -393,49 +810,21 @@ ParseResult parse_message(const std::string& completeMessage,
         return res;
     }
 
-    // Find the terminator position in the message (marks end of the logical message)
-    // The terminator separates this message from any buffered data that follows
-    size_t termPos = completeMessage.find(transmissionTerminator);
-
-    // DEBUG: Log terminator position
-    // std::cout << "Terminator pos: " << (termPos == std::string::npos ? -1 : (int)termPos) << std::endl;
-
-    // Determine where to stop parsing: use terminator if found, otherwise full message
-    // This ensures we only parse the current complete message, not partial buffered data
-    size_t endPos = completeMessage.size();
-    if (termPos != std::string::npos) {
-        endPos = termPos;  // Stop at the terminator
-    }
-
-    // DEBUG: Log parsing bounds
-    // std::cout << "Using endPos: " << endPos << std::endl;
-    // std::cout << "Message chunk to parse: [" << completeMessage.substr(0, endPos) << "]" << std::endl;
-
     // ====================================================================
-    // FIELD EXTRACTION: Convert message to tokenizable format
+    // FIELD EXTRACTION: One scan, all delimiters, no copies
     // ====================================================================
     // Wire format uses message separators }#{ to delimit individual messages within
-    // a batch, but for parsing, we can treat them as regular field delimiters
-    // Strategy: temporarily replace message separators with field delimiters
-    std::string messageToTokenize = completeMessage.substr(0, endPos);
-    size_t replacePos = 0;
-    while ((replacePos = messageToTokenize.find(messageSeperator, replacePos)) != std::string::npos) {
-        // Replace }#{ with }+{ to normalize all delimiters
-        messageToTokenize.replace(replacePos, messageSeperator.length(), fieldDelimiter);
-        replacePos += fieldDelimiter.length();
-    }
-    
-    // Split the normalized message into individual fields
-    auto fields = split_fields_until(messageToTokenize, fieldDelimiter, messageToTokenize.size());
-    if (fields.empty()) {
-        res.error = "Malformed message: no fields found.";
-        return res;  // Cannot proceed without at least a command
-    }
+    // a batch, but for parsing they are just another field boundary
+    // The scan ends at the terminator, so partial buffered data after it is never looked at
+    // The field list is reused per thread, so steady-state parsing does not allocate for it
+    DelimiterScanner scanner(fieldDelimiter, messageSeperator, transmissionTerminator);
+    thread_local std::vector<std::string_view> fields;
+    tokenize_fields(completeMessage, scanner, fields);
 
     // ====================================================================
     // COMMAND PARSING (First field is always the command)
     // ====================================================================
-    const std::string& commandStr = fields[0];
+    std::string_view commandStr = fields[0];
    
     // Look up command string in the string-to-enum map
     // This converts wire format command strings (e.g., "GET_BOARD") to enum values
@@ -453,7 +842,8 @@ ParseResult parse_message(const std::string& completeMessage,
     {
         // Unknown command - mark as invalid and return error
         res.clientCmd = CLIENT_COMMANDS::INVALID_COMMAND;
-        res.error = "Invalid command: " + commandStr;
+        res.error = "Invalid command: ";
+        res.error += commandStr;
         return res;
     }
 
@@ -472,6 +862,31 @@ ParseResult parse_message(const std::string& completeMessage,
         if (fields.size() > 2) {
             res.filter_title = fields[2];   // Optional title filter
         }
+
+        // Optional paging: GET_BOARD}+{[author]}+{[title]}+{[start]}+{[limit]}
+        // start is a post id (or ">id" for "everything after the last id I saw"), limit caps the
+        // number of posts returned; old clients never send these fields and get the plain reply
+        if (fields.size() > 3) {
+            res.paged = true;
+            std::string_view start = fields[3];
+            bool after = !start.empty() && start[0] == '>';
+            if (after) start.remove_prefix(1);
+            if (!parse_page_number(start, res.page_start) || (after && (start.empty() || res.page_start == SIZE_MAX))) {
+                res.error = "Invalid GET_BOARD start: ";
+                res.error += fields[3];
+                return res;
+            }
+            if (after) res.page_start++;
+        }
+        if (fields.size() > 4 && !parse_page_number(fields[4], res.page_limit)) {
+            res.error = "Invalid GET_BOARD limit: ";
+            res.error += fields[4];
+            return res;
+        }
+        if (fields.size() > 5) {
+            res.error = "GET_BOARD takes at most author, title, start and limit fields.";
+            return res;
+        }
         res.ok = true;  // Successfully parsed GET_BOARD
         return res;
     }
@@ -502,11 +917,12 @@ ParseResult parse_message(const std::string& completeMessage,
         // Extract individual posts from the triples
         // ================================================================
         // Loop through fields in groups of 3 (author, title, message)
+        res.posts.reserve(payloadCount / 3);
         for (size_t i = 1; i + 2 < fields.size(); i += 3) 
         {
-            const std::string& author  = fields[i];     // Index i = author (may be empty for anonymous)
-            const std::string& title   = fields[i+1];   // Index i+1 = title (may be empty)
-            const std::string& message = fields[i+2];   // Index i+2 = message body
+            std::string_view author  = fields[i];     // Index i = author (may be empty for anonymous)
+            std::string_view title   = fields[i+1];   // Index i+1 = title (may be empty)
+            std::string_view message = fields[i+2];   // Index i+2 = message body
 
             // Validation: message content cannot be empty
             if (message.empty()) 
@@ -515,12 +931,10 @@ ParseResult parse_message(const std::string& completeMessage,
                 return res;  // Reject post with empty message
             }
 
-            // Create a new Post object from the fields
-            // Author and title CAN be empty, but message cannot
-            Post p{author, title, message};
-
-            // Add the post to the result (uses move semantics for efficiency)
-            res.posts.push_back(std::move(p));
+            // Copy the fields into the request's memory (post_handler copies them once more,
+            // into the board); author and title CAN be empty, but message cannot
+            res.posts.push_back(ParsedPost{std::pmr::string(author, memory), std::pmr::string(title, memory),
+                                           std::pmr::string(message, memory)});
         }
 
         // All posts extracted successfully
@@ -531,7 +945,51 @@ ParseResult parse_message(const std::string& completeMessage,
         return res;
     }
 
-    // QUIT: No payload needed, just the command
+    // SUBSCRIBE: Optional filters for author and title, like GET_BOARD
+    if (res.clientCmd == CLIENT_COMMANDS::SUBSCRIBE)
+    {
+        // Format: SUBSCRIBE}+{[author]}+{[title]}
+        if (fields.size() > 3) {
+            res.error = "SUBSCRIBE takes at most author and title fields.";
+            return res;
+        }
+        if (fields.size() > 1) res.filter_author = fields[1];
+        if (fields.size() > 2) res.filter_title = fields[2];
+        res.ok = true;
+        return res;
+    }
+
+    // SEARCH: words, then author/title/message substrings, then a limit; at least one must be set
+    if (res.clientCmd == CLIENT_COMMANDS::SEARCH)
+    {
+        // Format: SEARCH}+{[words]}+{[author]}+{[title]}+{[message]}+{[limit]}
+        if (fields.size() > 6) {
+            res.error = "SEARCH takes at most words, author, title, message and limit fields.";
+            return res;
+        }
+        if (fields.size() > 1) res.search_words = fields[1];
+        if (fields.size() > 2) res.filter_author = fields[2];
+        if (fields.size() > 3) res.filter_title = fields[3];
+        if (fields.size() > 4) res.search_message = fields[4];
+        if (fields.size() > 5 && !parse_page_number(fields[5], res.page_limit)) {
+            res.error = "Invalid SEARCH limit: ";
+            res.error += fields[5];
+            return res;
+        }
+        if (res.search_words.empty() && res.filter_author.empty() && res.filter_title.empty() && res.search_message.empty()) {
+            res.error = "SEARCH needs words, an author, a title or a message to look for.";
+            return res;
+        }
+        res.ok = true;
+        return res;
+    }
+
+    // QUIT and UNSUBSCRIBE: No payload needed, just the command
+    if (res.clientCmd == CLIENT_COMMANDS::UNSUBSCRIBE)
+    {
+        res.ok = true;
+        return res;
+    }
     if (res.clientCmd == CLIENT_COMMANDS::QUIT) 
     {
         res.ok = true;  // Successfully parsed QUIT
@@ -552,6 +1010,41 @@ ParseResult parse_message(const std::string& completeMessage,
 // SOCKET I/O FUNCTIONS
 // ============================================================================
 
+/// @brief Counters of the worker the calling thread serves (nullptr on non-server threads)
+/// Lets the I/O helpers attribute syscalls and requests to a worker without a lookup;
+/// benchmark/test client threads leave it unset so their own I/O is not counted
+thread_local WorkerStats* t_ioStats = nullptr;
+
+/// @brief Records one socket or event-loop system call for the current worker
+static inline void count_io_syscall()
+{
+    if (t_ioStats) t_ioStats->ioSyscalls.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// @brief Records one framed request handled by the current worker
+static inline void count_request()
+{
+    if (t_ioStats) t_ioStats->requests.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// @brief Records bytes the current worker received from a client socket
+static inline void count_bytes_in(ssize_t bytes)
+{
+    if (t_ioStats && bytes > 0) g_serverState.stats.add(ServerStats::BYTES_IN, (uint64_t)bytes);
+}
+
+/// @brief Records bytes the current worker sent to a client socket
+static inline void count_bytes_out(ssize_t bytes)
+{
+    if (t_ioStats && bytes > 0) g_serverState.stats.add(ServerStats::BYTES_OUT, (uint64_t)bytes);
+}
+
+/// @brief Records a failed receive or send on a client socket of the current worker
+static inline void count_io_error(StatError error)
+{
+    if (t_ioStats) g_serverState.stats.countError(error);
+}
+
 /// @brief Sends all bytes in a buffer through a socket (handles partial sends)
 /// The system may not send all requested bytes in a single send() call
 /// This function loops until all bytes are sent or an error occurs
@@ -571,6 +1064,7 @@ ssize_t send_all_bytes(int socket, const char* buffer, size_t length, int flags)
         // buffer + totalSent: pointer to remaining data
         // length - totalSent: number of bytes remaining to send
         ssize_t bytesSent = send(socket, buffer + totalSent, length - totalSent, flags);
+        count_io_syscall();
         
         // Check if send was successful
         if (bytesSent > 0)
@@ -599,6 +1093,34 @@ ssize_t send_all_bytes(int socket, const char* buffer, size_t length, int flags)
 // MESSAGE RECEPTION AND BUFFERING
 // ============================================================================
 
+/// @brief Extracts one complete message from an accumulation buffer, if present
+/// String-buffer framing used by the client-side reader below (tests and benchmarks);
+/// server connections use MessageFramer, which neither rescans nor copies
+/// @param messageBuffer Accumulation buffer for received data (consumed message is removed)
+/// @param terminator The sequence that marks end of a complete message
+/// @param completedMessage Output: the extracted complete message (without terminator)
+/// @return True if a complete message was extracted; false if the buffer holds only a partial message
+bool extract_message_from_buffer(
+    std::string& messageBuffer,
+    const std::string& terminator,
+    std::string& completedMessage
+)
+{
+    auto pos = messageBuffer.find(terminator);
+    if (pos == std::string::npos)
+    {
+        return false;  // No terminator yet - wait for more data
+    }
+
+    // Extract complete message up to (but not including) terminator
+    completedMessage = messageBuffer.substr(0, pos);
+
+    // Remove processed message AND terminator from buffer
+    // This leaves any subsequent data for the next message
+    messageBuffer.erase(0, pos + terminator.size());
+    return true;
+}
+
 /// @brief Reads data from socket until a terminator sequence is found
 /// Uses buffering to handle cases where terminator arrives in multiple recv() calls
 /// Properly handles partial messages and removes processed data from buffer
@@ -619,15 +1141,8 @@ bool read_message_until_terminator(
     // ====================================================================
     // Optimization: maybe we already have a complete message in the buffer
     // from a previous recv() call (buffered before this function was called)
-    auto pos = messageBuffer.find(terminator);
-    if (pos != std::string::npos)
+    if (extract_message_from_buffer(messageBuffer, terminator, completedMessage))
     {
-        // Extract complete message up to (but not including) terminator
-        completedMessage = messageBuffer.substr(0, pos);
-        
-        // Remove processed message AND terminator from buffer
-        // This leaves any subsequent data for the next message
-        messageBuffer.erase(0, pos + terminator.size());
         return true;  // Success: found complete message
     }
 
@@ -640,6 +1155,7 @@ bool read_message_until_terminator(
     {
         // Attempt to receive data from the socket
         ssize_t bytesReceived = recv(socket, temp, sizeof(temp), 0);
+        count_io_syscall();
         
         // Success: got data from socket
         if (bytesReceived > 0)
@@ -648,12 +1164,8 @@ bool read_message_until_terminator(
             messageBuffer.append(temp, bytesReceived);
 
             // Check if terminator is now present in the accumulated buffer
-            auto pos = messageBuffer.find(terminator);
-            if (pos != std::string::npos)
+            if (extract_message_from_buffer(messageBuffer, terminator, completedMessage))
             {
-                // Found terminator! Extract message and update buffer
-                completedMessage = messageBuffer.substr(0, pos);
-                messageBuffer.erase(0, pos + terminator.size());
                 return true;  // Successfully extracted complete message
             }
 
@@ -681,6 +1193,79 @@ bool read_message_until_terminator(
     }
 }
 
+/// @brief Largest request a client may send (bytes before its terminator)
+/// A connection whose unterminated data grows past it is closed, so one client can neither
+/// grow its receive buffer without bound nor keep a worker busy scanning it
+constexpr size_t MAX_REQUEST_BYTES = 8 * 1024 * 1024;
+
+/// @brief Received bytes one connection may read per wakeup before others get a turn
+/// Applies to the non-blocking read-ahead of the blocking mode and to each epoll readiness
+/// event; sockets are level-triggered, so whatever is left is reported again next wait
+constexpr size_t READ_BUDGET_BYTES = 64 * 1024;
+
+/// @brief True if the framer holds an unterminated request longer than MAX_REQUEST_BYTES
+/// Counts and logs the error; the caller closes the connection
+/// @param framer The connection's received bytes
+/// @param socket The client socket (used for logging only)
+static bool request_too_large(MessageFramer& framer, int socket)
+{
+    if (framer.buffered() <= MAX_REQUEST_BYTES || framer.hasFrame()) return false;
+    g_serverState.stats.countError(StatError::OVERSIZED);
+    g_serverState.logEventf("ERROR", "Request longer than %lld bytes, closing connection (socket: %lld)",
+                            (long long)MAX_REQUEST_BYTES, socket);
+    return true;
+}
+
+/// @brief Receives until the framer holds at least one complete message (server side of the blocking mode)
+/// recv() writes straight into the framer's buffer and the terminator search resumes where
+/// it stopped, so a large or pipelined message is neither copied nor rescanned per recv().
+/// If the last recv() filled its whole buffer, more pipelined requests are probably queued
+/// in the socket: they are picked up without blocking so they join the same batch (up to
+/// READ_BUDGET_BYTES buffered). A request over MAX_REQUEST_BYTES ends the connection.
+/// @param socket The socket to read from
+/// @param framer The connection's framer
+/// @param waitReadable Called before each blocking recv(), also while a partial request is
+/// buffered; returns false to give up (a subscribed connection sends its pushes there)
+/// @return True once a complete message is buffered; false on error/disconnect/oversized request
+template <typename Wait>
+bool receive_until_message(int socket, MessageFramer& framer, Wait&& waitReadable)
+{
+    constexpr size_t RECV_SIZE = 4096;
+    bool mayHaveMore = false;  // Last recv() filled its buffer
+    while (!framer.hasFrame() || mayHaveMore)
+    {
+        bool waiting = !framer.hasFrame();  // Block only until the first complete message
+        if (waiting && !waitReadable()) return false;
+        ssize_t bytesReceived = recv(socket, framer.writeBuffer(RECV_SIZE), RECV_SIZE, waiting ? 0 : MSG_DONTWAIT);
+        count_io_syscall();
+        if (bytesReceived > 0)
+        {
+            count_bytes_in(bytesReceived);
+            framer.commit((size_t)bytesReceived);
+            if (request_too_large(framer, socket)) return false;
+            mayHaveMore = ((size_t)bytesReceived == RECV_SIZE) && framer.buffered() < READ_BUDGET_BYTES;
+            continue;
+        }
+        if (bytesReceived == -1 && errno == EINTR) continue;
+        if (!waiting) break;  // Nothing more queued (or EOF/error, reported by the next call)
+        if (bytesReceived == 0)
+        {
+            std::cerr << "Connection closed by peer." << std::endl;
+            return false;
+        }
+        std::cerr << "Error receiving data: " << strerror(errno) << std::endl;
+        count_io_error(StatError::RECV);
+        return false;
+    }
+    return true;
+}
+
+/// @brief receive_until_message() for a connection with nothing to do while it blocks
+bool receive_until_message(int socket, MessageFramer& framer)
+{
+    return receive_until_message(socket, framer, [] { return true; });
+}
+
 // ============================================================================
 // ERROR RESPONSE BUILDERS
 // ============================================================================
@@ -711,45 +1296,148 @@ std::string handle_post_error(const std::string& errorMessage)
 }
 
 // ============================================================================
-// UTILITY: TRUNCATE LONG STRINGS FOR LOGGING
+// SUBSCRIBE COMMAND HANDLER (SERVER PUSH)
 // ============================================================================
+// A SUBSCRIBE'd connection gets "NEW_POST}+{id}+{author}+{title}+{message}}&{{" for
+// every post published afterwards that matches its filters. publish_posts() queues the
+// pushes in the SubscriptionHub and rings the owning loop's eventfd; the loop moves them
+// to the connection's send queue only once earlier output has been sent, so a client
+// that stops reading hits its queue bound (--subscriber-queue) and then the
+// --slow-subscriber policy: drop (it later gets "SUBSCRIBE_LAGGED}+{firstMissedId}}&{{"
+// and can backfill with a paged GET_BOARD) or disconnect.
+
+/// @brief Push-subscription state of one connection (touched only by its I/O thread)
+struct ClientSubscription {
+    SubscriberWakeup* wakeup = nullptr;        // Doorbell of the owning loop (per worker, or ownWakeup)
+    void* owner = nullptr;                     // Connection object the loop gets back from the doorbell
+    std::unique_ptr<SubscriberWakeup> ownWakeup;  // Thread-per-client mode: created on first SUBSCRIBE
+    std::shared_ptr<Subscriber> subscriber;    // Set while SUBSCRIBE'd
+};
+
+/// @brief Stops pushes to a connection (on UNSUBSCRIBE, re-SUBSCRIBE and disconnect)
+void end_subscription(ClientSubscription& subscription)
+{
+    if (subscription.subscriber == nullptr) return;
+    g_serverState.subscriptions.unsubscribe(subscription.subscriber);
+    subscription.subscriber.reset();
+}
+
+/// @brief Handles SUBSCRIBE and UNSUBSCRIBE for one connection
+/// SUBSCRIBE replies "SUBSCRIBE_OK}+{next}}&{{": every post with id >= next will be pushed,
+/// so a client that wants history too can fetch [0, next) with a paged GET_BOARD
+/// @param parsed The parsed SUBSCRIBE/UNSUBSCRIBE request
+/// @param subscription The connection's subscription state
+/// @param CommunicationSocket The socket for this client (used for logging only)
+/// @param rawMessage The request as received (shown in the event log)
+/// @return The wire-format reply
+std::string subscribe_handler(const ParseResult& parsed, ClientSubscription& subscription, int CommunicationSocket,
+                              std::string_view rawMessage = {})
+{
+    end_subscription(subscription);
+    if (parsed.clientCmd == CLIENT_COMMANDS::UNSUBSCRIBE)
+    {
+        g_serverState.logEventf("SUBSCRIBE", "Client unsubscribed (socket: %lld)", CommunicationSocket);
+        return std::string(kCmdToStr.at(SERVER_RESPONSES::UNSUBSCRIBE_OK)) + transmissionTerminator;
+    }
+
+    if (subscription.wakeup == nullptr)
+    {
+        std::string error;
+        auto wakeup = std::make_unique<SubscriberWakeup>();
+        if (!wakeup->open(error))
+        {
+            g_serverState.logEvent("ERROR", "SUBSCRIBE failed: " + error);
+            return "INVALID_COMMAND" + fieldDelimiter + fieldDelimiter + fieldDelimiter + "SUBSCRIBE failed: " + error + transmissionTerminator;
+        }
+        subscription.ownWakeup = std::move(wakeup);
+        subscription.wakeup = subscription.ownWakeup.get();
+    }
+
+    // Register before sampling the board size: any post at or past it is published later, so it is pushed
+    subscription.subscriber = g_serverState.subscriptions.subscribe(parsed.filter_author, parsed.filter_title,
+                                                                    *subscription.wakeup, subscription.owner);
+    size_t next = g_serverState.messageBoard.size();
+    g_serverState.logEventf("SUBSCRIBE", "Client subscribed (socket: %lld)", CommunicationSocket, 0, rawMessage);
+    return std::string(kCmdToStr.at(SERVER_RESPONSES::SUBSCRIBE_OK)) + fieldDelimiter + std::to_string(next) + transmissionTerminator;
+}
+
+/// @brief Hands a subscriber's queued pushes to the connection's send path
+/// Call only when the connection has no unsent output, so the hub's queue bound holds
+/// @param subscription The connection's subscription state
+/// @param emit Callable taking a WireResponse by rvalue (pushes share the hub's chunks)
+/// @return False if the subscriber overflowed under --slow-subscriber=disconnect
+template <typename Emit>
+static bool drain_subscription(ClientSubscription& subscription, Emit&& emit)
+{
+    if (subscription.subscriber == nullptr) return true;
 
-/// @brief Truncates a string to a maximum length, appending "..." if truncated
-/// Useful for logging long wire-format responses without flooding output
-/// @param str The string to potentially truncate
-/// @param max_len Maximum length before truncation (default 80 chars)
-/// @return Truncated string with "..." appended if it exceeded max_len
-static std::string truncate_for_log(const std::string& str, size_t max_len = 80) {
-    if (str.length() <= max_len) {
-        return str;
+    WireResponse pushes;
+    uint64_t firstMissed = 0;
+    SubscriptionHub::Drain result = g_serverState.subscriptions.drain(*subscription.subscriber, pushes.chunks, firstMissed);
+    if (result == SubscriptionHub::Drain::OVERFLOWED)
+    {
+        g_serverState.logEvent("WARNING", "Disconnecting subscriber that fell " +
+                               std::to_string(g_serverState.config.subscriptions.queueLimit) + " posts behind");
+        return false;
+    }
+    if (result == SubscriptionHub::Drain::LAGGED)
+    {
+        pushes.chunks.push_back(std::make_shared<const std::string>(
+            std::string(kCmdToStr.at(SERVER_RESPONSES::SUBSCRIBE_LAGGED)) + fieldDelimiter +
+            std::to_string(firstMissed) + transmissionTerminator));
     }
-    return str.substr(0, max_len) + "...";
+    if (!pushes.chunks.empty()) emit(std::move(pushes));
+    return true;
 }
 
 // ============================================================================
 // CLIENT REQUEST DISPATCHER AND HANDLER
 // ============================================================================
 
-/// @brief Routes parsed client requests to appropriate handlers and sends responses
+/// @brief Maps a parsed command to its request counter in g_serverState.stats
+static StatCommand stat_command(const ParseResult& parsed)
+{
+    if (!parsed.ok) return StatCommand::INVALID_COMMAND;
+    switch (parsed.clientCmd) {
+        case CLIENT_COMMANDS::GET_BOARD:   return StatCommand::GET_BOARD;
+        case CLIENT_COMMANDS::POST:        return StatCommand::POST;
+        case CLIENT_COMMANDS::SUBSCRIBE:   return StatCommand::SUBSCRIBE;
+        case CLIENT_COMMANDS::UNSUBSCRIBE: return StatCommand::UNSUBSCRIBE;
+        case CLIENT_COMMANDS::SEARCH:      return StatCommand::SEARCH;
+        case CLIENT_COMMANDS::QUIT:        return StatCommand::QUIT;
+        case CLIENT_COMMANDS::INVALID_COMMAND:
+        default:                           return StatCommand::INVALID_COMMAND;
+    }
+}
+
+/// @brief Routes parsed client requests to appropriate handlers and builds the wire response
 /// Executes command handlers (POST, GET_BOARD, etc.) and constructs wire-format responses
 /// Logs all activity to the shared event log for the GUI to display
+/// Does not touch the socket, so the blocking and the epoll I/O paths can share it
 /// @param parsed The ParseResult containing parsed command and payload
-/// @param CommunicationSocket The socket for communication with this client
+/// @param CommunicationSocket The socket for this client (used for logging only)
 /// @param clientId The unique identifier assigned to this client on connection
-void handle_client_request(const ParseResult& parsed, int CommunicationSocket, int clientId)
+/// @param subscription The connection's push-subscription state (nullptr = SUBSCRIBE unsupported)
+/// @param rawMessage The request as received (shown in the event log instead of rebuilding it from parsed)
+/// @param durableTicket If set, a POST does not wait for the post log: its ticket is stored here
+///        and the returned POST_OK must be held until the ticket settles (see HeldPost)
+/// @return The complete wire-format response (empty if nothing should be sent)
+WireResponse build_client_response(const ParseResult& parsed, int CommunicationSocket, int clientId,
+                                   ClientSubscription* subscription = nullptr, std::string_view rawMessage = {},
+                                   uint64_t* durableTicket = nullptr)
 {
     // ====================================================================
     // ERROR CHECK: Validate parsing was successful
     // ====================================================================
-    if (!parsed.ok) 
+    if (!parsed.ok)
     {
         // Parsing failed - send invalid command response back to client
-        g_serverState.logEvent("ERROR", "Invalid command: " + parsed.error);
+        std::string error(parsed.error);
+        g_serverState.stats.countError(StatError::PARSE);
+        g_serverState.logEvent("ERROR", "Invalid command: " + error);
         std::string emptyAuthor = "";
         std::string emptyTitle = "";
-        std::string response = "INVALID_COMMAND" + fieldDelimiter + emptyAuthor + fieldDelimiter + emptyTitle + fieldDelimiter + parsed.error + transmissionTerminator;
-        send_all_bytes(CommunicationSocket, response.c_str(), response.size(), 0);
-        return;  // Done handling this invalid request
+        return "INVALID_COMMAND" + fieldDelimiter + emptyAuthor + fieldDelimiter + emptyTitle + fieldDelimiter + error + transmissionTerminator;
     }
 
     // ====================================================================
@@ -761,69 +1449,99 @@ void handle_client_request(const ParseResult& parsed, int CommunicationSocket, i
         // ================================================================
         // GET_BOARD COMMAND
         // ================================================================
-        case CLIENT_COMMANDS::GET_BOARD: 
+        case CLIENT_COMMANDS::GET_BOARD:
         {
             // Client requested the message board with optional filters
-            // Reconstruct raw message for event log display
-            std::string raw_msg = "GET_BOARD}+{" + parsed.filter_author + "}+{" + parsed.filter_title + "}}&{{";
-            g_serverState.logEvent("GET_BOARD", "Client requested board (socket: " + std::to_string(CommunicationSocket) + ")", raw_msg);
-            
-            // Get the formatted message board (with optional filters applied)
-            std::string response = get_board_handler(parsed.filter_author, parsed.filter_title);
-            
-            // Log the response being sent (truncated for readability)
-            std::string truncated_response = truncate_for_log(response, 120);
-            g_serverState.logEvent("GET_BOARD_RESPONSE", "Sending board to client (size: " + std::to_string(response.size()) + " bytes)", truncated_response);
-            
-            // Send the board to the client
-            send_all_bytes(CommunicationSocket, response.c_str(), response.size(), 0);
-            return;     
+            g_serverState.logEventf("GET_BOARD", "Client requested board (socket: %lld)", CommunicationSocket, 0, rawMessage);
+
+            if (parsed.paged)
+            {
+                // Paged/incremental request: only the requested window is serialized (not cached)
+                std::string page = get_board_page_handler(parsed.filter_author, parsed.filter_title,
+                                                          parsed.page_start, parsed.page_limit);
+                g_serverState.logEventf("GET_BOARD_RESPONSE", "Sending board page to client (size: %lld bytes)",
+                                        (long long)page.size(), 0, page);
+                return page;
+            }
+
+            // Get the formatted message board (with optional filters applied) from the response cache;
+            // the returned chunks are shared with the cache, not copied
+            WireResponse response = *cached_board_response(parsed.filter_author, parsed.filter_title);
+
+            // Log the response being sent (the log keeps only the start of its first chunk, and only if shown)
+            g_serverState.logEventf("GET_BOARD_RESPONSE", "Sending board to client (size: %lld bytes)",
+                                    (long long)response.size(), 0, response.front());
+
+            return response;
+        }
+
+        // ================================================================
+        // SEARCH COMMAND
+        // ================================================================
+        case CLIENT_COMMANDS::SEARCH:
+        {
+            g_serverState.logEventf("SEARCH", "Client searched the board (socket: %lld)", CommunicationSocket, 0, rawMessage);
+            SearchQuery query;
+            query.words = parsed.search_words;
+            query.author = parsed.filter_author;
+            query.title = parsed.filter_title;
+            query.message = parsed.search_message;
+            query.limit = parsed.page_limit == 0 ? SIZE_MAX : parsed.page_limit;
+            std::string response = search_handler(query);
+            g_serverState.logEventf("SEARCH_RESPONSE", "Sending search results to client (size: %lld bytes)",
+                                    (long long)response.size(), 0, response);
+            return response;
         }
 
         // ================================================================
         // POST COMMAND
         // ================================================================
-        case CLIENT_COMMANDS::POST: 
+        case CLIENT_COMMANDS::POST:
         {
             // Client posted one or more new messages
             std::string errorMessage;  // Buffer for error details if post fails
-            
+
             // Try to add the posts to the shared message board
-            bool result = post_handler(parsed, errorMessage, clientId);
-            
+            bool result = post_handler(parsed, errorMessage, clientId, durableTicket);
+
             if (result == false)
             {
                 // Post failed - send error response
+                g_serverState.stats.countError(StatError::POST);
                 g_serverState.logEvent("POST_ERROR", errorMessage);
-                std::string response = handle_post_error(errorMessage);
-                send_all_bytes(CommunicationSocket, response.c_str(), response.size(), 0);
+                return handle_post_error(errorMessage);
             }
-            else
+
+            // Post succeeded - send confirmation response
+            g_serverState.logEventf("POST", "Client posted %lld message(s) (socket: %lld)", (long long)parsed.posts.size(),
+                                    CommunicationSocket, rawMessage);
+
+            // Send success response (the same bytes every time, so one shared chunk)
+            static const WireResponse postOk(build_post_ok());
+            return postOk;
+        }
+
+        // ================================================================
+        // SUBSCRIBE / UNSUBSCRIBE COMMANDS
+        // ================================================================
+        case CLIENT_COMMANDS::SUBSCRIBE:
+        case CLIENT_COMMANDS::UNSUBSCRIBE:
+        {
+            if (subscription == nullptr)
             {
-                // Post succeeded - send confirmation response
-                // Reconstruct raw message from parsed posts for event log
-                std::string raw_msg = "POST";
-                for (const auto& post : parsed.posts) {
-                    raw_msg += "}+{" + post.author + "}+{" + post.title + "}+{" + post.message;
-                    if (&post != &parsed.posts.back()) raw_msg += "}#{";
-                }
-                raw_msg += "}}&{{";
-                g_serverState.logEvent("POST", "Client posted " + std::to_string(parsed.posts.size()) + " message(s) (socket: " + std::to_string(CommunicationSocket) + ")", raw_msg);
-                
-                // Send success response
-                std::string response = build_post_ok();
-                send_all_bytes(CommunicationSocket, response.c_str(), response.size(), 0);
+                return "INVALID_COMMAND" + fieldDelimiter + fieldDelimiter + fieldDelimiter +
+                       "SUBSCRIBE is not available on this connection" + transmissionTerminator;
             }
-            return;
+            return subscribe_handler(parsed, *subscription, CommunicationSocket, rawMessage);
         }
 
         // ================================================================
         // QUIT COMMAND
         // ================================================================
         case CLIENT_COMMANDS::QUIT:
-            // Note: QUIT is actually handled in the main client handler loop
-            // This case should not be reached since client_handler breaks on QUIT
-            return;
+            // Note: QUIT is handled by the connection loops (see build_quit_response)
+            // This case should not be reached since they stop processing on QUIT
+            return "";
 
         // ================================================================
         // INVALID OR UNKNOWN COMMAND
@@ -831,53 +1549,347 @@ void handle_client_request(const ParseResult& parsed, int CommunicationSocket, i
         case CLIENT_COMMANDS::INVALID_COMMAND:
         default: {
             // Send generic invalid command response
+            g_serverState.stats.countError(StatError::PARSE);
             std::string emptyAuthor = "";
             std::string emptyTitle = "";
             std::string message = "Error, unable to interpret command - make sure to use accepted legitimate commands!";
-            std::string response = "INVALID_COMMAND" + fieldDelimiter + emptyAuthor + fieldDelimiter + emptyTitle + fieldDelimiter + message + transmissionTerminator;
-            send_all_bytes(CommunicationSocket, response.c_str(), response.size(), 0);
-            return;
+            return "INVALID_COMMAND" + fieldDelimiter + emptyAuthor + fieldDelimiter + emptyTitle + fieldDelimiter + message + transmissionTerminator;
+        }
+    }
+}
+
+/// @brief Upper bound on chunks gathered into one blocking sendmsg() call
+constexpr size_t SEND_MAX_IOV = 64;
+
+/// @brief Sends response chunks on a blocking socket with as few syscalls as possible
+/// Chunks are gathered into one sendmsg() (up to SEND_MAX_IOV at a time), so the replies to
+/// a batch of pipelined requests and multi-chunk cached GET_BOARD responses go out together
+/// without being concatenated. MSG_MORE is set while further chunks follow, so the kernel
+/// packs the pieces into full segments instead of pushing a short one per call.
+/// @param CommunicationSocket The socket for communication with this client
+/// @param chunks The chunks to send, in order
+/// @return False if a send failed
+static bool send_chunks(int CommunicationSocket, const std::vector<ResponseChunk>& chunks)
+{
+    size_t next = 0;    // First chunk not completely sent
+    size_t offset = 0;  // Bytes of chunks[next] already sent
+    while (true)
+    {
+        while (next < chunks.size() && offset == chunks[next]->size())
+        {
+            next++;      // Retire sent (or empty) chunks
+            offset = 0;
+        }
+        if (next == chunks.size()) return true;
+
+        struct iovec iov[SEND_MAX_IOV];
+        size_t iovCount = 0;
+        for (size_t i = next; i < chunks.size() && iovCount < SEND_MAX_IOV; i++)
+        {
+            size_t skip = (i == next) ? offset : 0;
+            iov[iovCount].iov_base = const_cast<char*>(chunks[i]->data() + skip);
+            iov[iovCount].iov_len = chunks[i]->size() - skip;
+            iovCount++;
+        }
+        struct msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovCount;
+        int flags = MSG_NOSIGNAL | ((next + iovCount < chunks.size()) ? MSG_MORE : 0);
+
+        ssize_t bytesSent = sendmsg(CommunicationSocket, &msg, flags);
+        count_io_syscall();
+        if (bytesSent < 0)
+        {
+            if (errno == EINTR) continue;  // Retry after signal
+            count_io_error(StatError::SEND);
+            return false;                  // Peer reset or other fatal error
+        }
+        count_bytes_out(bytesSent);
+
+        // Advance past what the kernel accepted (a blocking send may still be partial)
+        for (size_t remaining = (size_t)bytesSent; remaining > 0; )
+        {
+            size_t step = std::min(remaining, chunks[next]->size() - offset);
+            offset += step;
+            remaining -= step;
+            if (offset == chunks[next]->size())
+            {
+                next++;
+                offset = 0;
+            }
+        }
+    }
+}
+
+/// @brief Sends every chunk of a response on a blocking socket
+/// @param CommunicationSocket The socket for communication with this client
+/// @param response The response to send
+/// @return False if a send failed
+static bool send_response(int CommunicationSocket, const WireResponse& response)
+{
+    return send_chunks(CommunicationSocket, response.chunks);
+}
+
+/// @brief Builds the goodbye response sent when a client issues QUIT
+/// Wire format: "QUIT}+{SERVER}+{BYE!!!}+{Server says: BYE!!!}}&{{"
+/// @return A formatted string ready to send to the client
+std::string build_quit_response()
+{
+    std::string emptyAuthor = "SERVER";
+    std::string emptyTitle = "BYE!!!";
+    std::string message = "Server says: BYE!!!";
+    return "QUIT" + fieldDelimiter + emptyAuthor + fieldDelimiter + emptyTitle + fieldDelimiter + message + transmissionTerminator;
+}
+
+/// @brief A POST reply held until the post log has made the batch durable
+/// An event loop must not block in waitDurable(), so it keeps serving its other connections and
+/// leaves the requests behind the POST buffered until the reply is released (replies stay in
+/// request order). A connection thread waits itself once the handler pool has returned, so
+/// pooled handlers never sit out a group commit.
+struct HeldPost {
+    uint64_t ticket = 0;     // Post log ticket being waited for (0 = nothing held)
+    bool watching = false;   // The loop's doorbell is registered for the ticket
+    WireResponse reply;      // POST_OK, sent once the ticket is durable
+};
+
+/// @brief Frames, parses and handles every complete message in a connection's receive buffer
+/// Shared by every I/O mode; responses are handed to emit() in request order, so a caller
+/// can answer a batch of pipelined requests with a single gathered send. QUIT stops
+/// processing so nothing after it is answered. Every request is counted by command and every
+/// response as a sent message in g_serverState.stats.
+/// @param framer Received bytes (complete messages are consumed)
+/// @param socket The client socket (used for logging only)
+/// @param clientId The ID assigned by register_client()
+/// @param subscription The connection's push-subscription state
+/// @param arena The connection's scratch memory (parsed requests live there; reset after each one)
+/// @param held A POST still waiting for the post log stops processing and its reply is parked
+///        here instead of emitted (nullptr = wait for durability in place)
+/// @param emit Callable taking each WireResponse by rvalue
+/// @return True if the client sent QUIT (the caller closes after flushing)
+template <typename Emit>
+static bool process_buffered_messages(MessageFramer& framer, int socket, int clientId,
+                                      ClientSubscription& subscription, RequestArena& arena,
+                                      HeldPost* held, Emit&& emit)
+{
+    std::string_view CompletedMessage;
+    while ((held == nullptr || held->ticket == 0) && framer.next(CompletedMessage))
+    {
+        count_request();
+        arena.reset();  // The previous request's ParseResult is gone
+        ParseResult parsed = parse_message(CompletedMessage, fieldDelimiter, messageSeperator, transmissionTerminator,
+                                           arena.resource());
+        g_serverState.stats.countRequest(stat_command(parsed));
+
+        // Client requested graceful disconnect: queue goodbye and close after flushing
+        if (parsed.ok && parsed.clientCmd == CLIENT_COMMANDS::QUIT)
+        {
+            g_serverState.logEventf("QUIT", "Client requested disconnect (socket: %lld)", socket);
+            emit(build_quit_response());
+            g_serverState.stats.add(ServerStats::MESSAGES_SENT);
+            return true;
+        }
+
+        uint64_t ticket = 0;
+        WireResponse response = build_client_response(parsed, socket, clientId, &subscription, CompletedMessage,
+                                                      held != nullptr ? &ticket : nullptr);
+        if (!response.empty()) g_serverState.stats.add(ServerStats::MESSAGES_SENT);
+        if (ticket != 0)
+        {
+            held->ticket = ticket;
+            held->reply = std::move(response);
+            continue;
+        }
+        emit(std::move(response));
+    }
+    return false;
+}
+
+/// @brief Replaces a held POST_OK with the POST_ERROR for a post log failure
+static void fail_held_post(HeldPost& held, const std::string& error)
+{
+    std::string errorMessage = "Failed to persist post: " + error;
+    g_serverState.stats.countError(StatError::POST);
+    g_serverState.logEvent("POST_ERROR", errorMessage);
+    held.reply = handle_post_error(errorMessage);
+}
+
+/// @brief Checks a held POST without blocking
+/// The first check registers the loop's doorbell with the post log, which rings it once the
+/// ticket settles; the loop then checks again
+/// @param held The held reply (ticket cleared once settled)
+/// @param doorbellFd The loop's wakeup eventfd
+/// @return True once settled: held.reply is POST_OK, or a POST_ERROR if the log failed first
+static bool settle_held_post(HeldPost& held, int doorbellFd)
+{
+    std::string error;
+    TicketState state = g_serverState.postLog.settle(held.ticket, held.watching ? -1 : doorbellFd, error);
+    if (state == TicketState::PENDING)
+    {
+        held.watching = true;
+        return false;
+    }
+    if (state == TicketState::FAILED) fail_held_post(held, error);
+    held.ticket = 0;
+    held.watching = false;
+    return true;
+}
+
+/// @brief Blocking counterpart of settle_held_post() for connection threads
+/// Called after RequestPool::run() returns, so the handler is already free for other clients
+/// @param held The held reply (ticket cleared; reply becomes a POST_ERROR if the log failed)
+static void wait_held_post(HeldPost& held)
+{
+    std::string error;
+    if (!g_serverState.postLog.waitDurable(held.ticket, error)) fail_held_post(held, error);
+    held.ticket = 0;
+}
+
+/// @brief process_buffered_messages() for the event loops: POST replies are held instead of
+/// waited for, and a settled one is emitted before the requests buffered behind it are handled
+/// @return True if the client sent QUIT
+template <typename Emit>
+static bool process_event_loop_messages(MessageFramer& framer, int socket, int clientId, ClientSubscription& subscription,
+                                        RequestArena& arena, HeldPost& held, Emit&& emit)
+{
+    while (true)
+    {
+        if (held.ticket != 0)
+        {
+            if (!settle_held_post(held, subscription.wakeup->fd())) return false;  // Doorbell rings when settled
+            emit(std::move(held.reply));
+            held.reply = WireResponse();
+        }
+        if (process_buffered_messages(framer, socket, clientId, subscription, arena, &held, emit)) return true;
+        if (held.ticket == 0) return false;
+    }
+}
+
+// ============================================================================
+// CLIENT REGISTRATION (SHARED BY ALL I/O MODES)
+// ============================================================================
+
+/// @brief Registers a newly accepted client in the shared state
+/// Assigns a client ID, records the socket for the GUI and shutdown broadcast,
+/// and logs the CONNECT event
+/// @param CommunicationSocket The accepted client socket
+/// @param workerId Index of the accepting worker in g_serverState.workerStats
+/// @return The unique client ID assigned to this connection
+int register_client(int CommunicationSocket, int workerId = 0)
+{
+    // Assign a unique ID to this client for tracking and logging (increments for each new client)
+    int clientId = g_serverState.stats.nextClientId();
+    {
+        // Lock mutex to safely modify shared client tracking data
+        std::lock_guard<std::mutex> lock(g_serverState.clientsMutex);
+
+        // Add this client's socket to the active clients list
+        g_serverState.activeClientSockets.push_back(CommunicationSocket);
+    }
+
+    // Increment the active connection counters for statistics
+    g_serverState.stats.add(ServerStats::CONNECTIONS_OPENED);
+    WorkerStats& stats = g_serverState.workerStats[workerId];
+    stats.accepted.fetch_add(1, std::memory_order_relaxed);
+    stats.active.fetch_add(1, std::memory_order_relaxed);
+
+    // Log the client connection event for the GUI
+    g_serverState.logEventf("CONNECT", "Client #%lld connected (socket: %lld)", clientId, CommunicationSocket);
+    return clientId;
+}
+
+/// @brief Closes a client socket and removes it from the shared client tracking
+/// @param CommunicationSocket The client socket to close
+/// @param workerId Index of the owning worker in g_serverState.workerStats
+void unregister_client(int CommunicationSocket, int workerId = 0)
+{
+    // Remove this client from active clients list before the descriptor number
+    // can be reused by a new accept()
+    {
+        std::lock_guard<std::mutex> lock(g_serverState.clientsMutex);
+
+        // Find and remove this socket from the active list
+        auto it = std::find(g_serverState.activeClientSockets.begin(),
+                           g_serverState.activeClientSockets.end(),
+                           CommunicationSocket);
+        if (it != g_serverState.activeClientSockets.end()) {
+            g_serverState.activeClientSockets.erase(it);
         }
+
+        // Close the socket for this client
+        close(CommunicationSocket);
     }
+
+    // Decrement the active connection counters
+    g_serverState.stats.add(ServerStats::CONNECTIONS_CLOSED);
+    WorkerStats& stats = g_serverState.workerStats[workerId];
+    stats.active.fetch_sub(1, std::memory_order_relaxed);
+    stats.closed.fetch_add(1, std::memory_order_relaxed);
 }
 
 // ============================================================================
 // PER-CLIENT CONNECTION HANDLER (RUNS IN SEPARATE THREAD)
 // ============================================================================
 
+/// @brief Waits until a subscribed client's socket is readable, sending its pushes in the meantime
+/// Returns at once for unsubscribed clients (the recv() in receive_until_message blocks instead)
+/// @param CommunicationSocket The socket for this client connection
+/// @param subscription The connection's push-subscription state
+/// @return False if the connection should be closed (send failed or the subscriber overflowed)
+static bool wait_readable(int CommunicationSocket, ClientSubscription& subscription)
+{
+    while (subscription.subscriber != nullptr)
+    {
+        struct pollfd fds[2] = {{CommunicationSocket, POLLIN, 0}, {subscription.wakeup->fd(), POLLIN, 0}};
+        int ready = poll(fds, 2, -1);
+        count_io_syscall();
+        if (ready == -1)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        if (fds[1].revents & POLLIN)
+        {
+            // The doorbell belongs to this connection alone, so the ready list needs no walk
+            subscription.wakeup->clear();
+            subscription.wakeup->takeReady();
+            bool sent = true;
+            if (!drain_subscription(subscription, [&](WireResponse&& pushes) {
+                    sent = send_response(CommunicationSocket, pushes);
+                }) || !sent)
+            {
+                return false;
+            }
+        }
+        if (fds[0].revents != 0) return true;  // Request data, EOF or error: let recv() report it
+    }
+    return true;
+}
+
 /// @brief Handles all communication with a single connected client
 /// Runs in its own thread to allow simultaneous handling of multiple clients
 /// Manages receive, parse, process, and response cycle for each client
 /// Logs all client activity (connect, disconnect, requests) to event log
+/// Pipelined requests are handled as a batch: every complete message already received is
+/// processed in order and the replies go out in one gathered send
 /// @param CommunicationSocket The socket for this client connection (passed by value)
 void client_handler(int CommunicationSocket)
 {
-    std::string RxBuffer;        // Accumulation buffer for received data fragments
-    std::string CompletedMessage; // Complete message once terminator is found
+    MessageFramer framer(transmissionTerminator);  // Received bytes, split into messages in place
+    RequestArena arena;                            // Scratch memory for parsing each request
+    std::vector<ResponseChunk> replies;            // Responses to the current batch of requests
     bool keepRunning = true;     // Flag to control the client loop
+    ClientSubscription subscription;  // Pushes to send between requests (after SUBSCRIBE)
 
     // ====================================================================
     // CLIENT CONNECTION INITIALIZATION
     // ====================================================================
     
-    // Assign a unique ID to this client for tracking and logging
-    int myClientId;
-    {
-        // Lock mutex to safely modify shared client tracking data
-        std::lock_guard<std::mutex> lock(g_serverState.clientsMutex);
-        
-        // Assign next available client ID (increments for each new client)
-        myClientId = g_serverState.nextClientId++;
-        
-        // Add this client's socket to the active clients list
-        g_serverState.activeClientSockets.push_back(CommunicationSocket);
-    }
+    // Assign a unique ID, track the socket and log the connection
+    int myClientId = register_client(CommunicationSocket);
 
-    // Increment the active connection counter for statistics
-    g_serverState.activeConnections++;
-    
-    // Log the client connection event for the GUI
-    g_serverState.logEvent("CONNECT", "Client #" + std::to_string(myClientId) + " connected (socket: " + std::to_string(CommunicationSocket) + ")");
+    // All thread-per-client connections report as worker 0
+    t_ioStats = &g_serverState.workerStats[0];
 
     // ====================================================================
     // MAIN CLIENT MESSAGE LOOP
@@ -886,227 +1898,935 @@ void client_handler(int CommunicationSocket)
     while (keepRunning) {
 
         // ================================================================
-        // RECEIVE MESSAGE FROM CLIENT
+        // RECEIVE MESSAGES FROM CLIENT
         // ================================================================
         
-        // Read from socket until we find a complete message (marked by terminator)
-        bool result = read_message_until_terminator(
-            CommunicationSocket,
-            RxBuffer,                    // Accumulation buffer for partial data
-            transmissionTerminator,      // Message end marker
-            CompletedMessage             // Output: complete message received
-        );
+        // Read from socket until at least one complete message (marked by terminator) is
+        // buffered; a subscribed client is sent its pushes while we wait, including while
+        // part of a request has arrived
+        bool result = receive_until_message(CommunicationSocket, framer,
+                                            [&] { return wait_readable(CommunicationSocket, subscription); });
 
         // Check if read was successful or if connection closed
         if (!result) {
             // Connection closed or error reading - exit client loop
-            g_serverState.logEvent("DISCONNECT", "Client disconnected (socket: " + std::to_string(CommunicationSocket) + ")");
+            g_serverState.logEventf("DISCONNECT", "Client disconnected (socket: %lld)", CommunicationSocket);
             keepRunning = false;
             break;  // Exit message loop
         }
 
-        // DEBUG: Log received message
-        // std::cout << "Received message from client: " << CompletedMessage << std::endl;
-
-        // ================================================================
-        // PARSE MESSAGE FROM CLIENT
-        // ================================================================
-        
-        // Parse the complete message to extract command and payload
-        // Returns ParseResult with either parsed data or error details
-        ParseResult parsed = parse_message(
-            CompletedMessage,             // Complete message (no partial data)
-            fieldDelimiter,               // Field separator
-            messageSeperator,             // Message batch separator
-            transmissionTerminator        // End marker
-        );
-
         // ================================================================
-        // CHECK FOR QUIT COMMAND (SPECIAL CASE)
+        // PARSE AND HANDLE EVERY BUFFERED REQUEST
         // ================================================================
         
-        // Client requested graceful disconnect
-        if (parsed.ok && parsed.clientCmd == CLIENT_COMMANDS::QUIT) {
-            // Log the quit request
-            g_serverState.logEvent("QUIT", "Client requested disconnect (socket: " + std::to_string(CommunicationSocket) + ")");
-            
-            // Send goodbye message back to client (as wire-format message)
-            std::string emptyAuthor = "SERVER";
-            std::string emptyTitle = "BYE!!!";
-            std::string message = "Server says: BYE!!!";
-            std::string response = "QUIT" + fieldDelimiter + emptyAuthor + fieldDelimiter + emptyTitle + fieldDelimiter + message + transmissionTerminator;
-            send_all_bytes(CommunicationSocket, response.c_str(), response.size(), 0);
-            
-            // Exit the client loop
-            keepRunning = false;
-            break;  // End client session
+        // Route each parsed request to its handler (GET_BOARD, POST, etc.) in arrival order;
+        // QUIT queues the goodbye message and stops the batch
+        // With --handlers=N the batch runs on the bounded handler pool while this thread waits.
+        // A POST ends the handler's turn: this thread then waits for its group commit and hands
+        // the rest of the batch back to the pool
+        bool quit = false;
+        HeldPost held;
+        auto emit = [&](WireResponse&& response) {
+            for (ResponseChunk& chunk : response.chunks) replies.push_back(std::move(chunk));
+        };
+        while (true)
+        {
+            g_serverState.requestPool.run([&] {
+                quit = process_buffered_messages(framer, CommunicationSocket, myClientId, subscription, arena, &held, emit);
+            });
+            if (held.ticket == 0) break;
+            wait_held_post(held);
+            emit(std::move(held.reply));
+            held.reply = WireResponse();
         }
 
         // ================================================================
-        // HANDLE THE CLIENT REQUEST
+        // SEND THE REPLIES FOR THE WHOLE BATCH
         // ================================================================
         
-        // Route the parsed request to the appropriate handler
-        // (GET_BOARD, POST, etc.) which generates and sends response
-        handle_client_request(parsed, CommunicationSocket, myClientId);
+        // One sendmsg() for the batch instead of one send() per request
+        bool sent = send_chunks(CommunicationSocket, replies);
+        replies.clear();
 
-        // ================================================================
-        // PREPARE FOR NEXT MESSAGE
-        // ================================================================
-        
-        // Clear the completed message for next iteration
-        CompletedMessage.clear();
+        if (quit || !sent) {
+            // Client asked to disconnect (or can no longer be written to): end the session
+            keepRunning = false;
+            break;
+        }
     }
 
     // ====================================================================
     // CLIENT CLEANUP AND DISCONNECTION
     // ====================================================================
     
-    // Close the socket for this client
-    close(CommunicationSocket);
-    
-    // Remove this client from active clients list
-    {
-        std::lock_guard<std::mutex> lock(g_serverState.clientsMutex);
-        
-        // Find and remove this socket from the active list
-        auto it = std::find(g_serverState.activeClientSockets.begin(), 
-                           g_serverState.activeClientSockets.end(), 
-                           CommunicationSocket);
-        if (it != g_serverState.activeClientSockets.end()) {
-            g_serverState.activeClientSockets.erase(it);
-        }
-    }
-    
-    // Decrement the active connection counter
-    g_serverState.activeConnections--;
+    // Stop pushes, close the socket and remove this client from the shared tracking
+    end_subscription(subscription);
+    unregister_client(CommunicationSocket);
     
     // Thread will exit here (implicit return)
 }
 
 // ============================================================================
-// SERVER MAIN LOOP
+// EPOLL REACTOR (NON-BLOCKING EVENT LOOP MODE)
 // ============================================================================
+// Instead of one blocked thread per client, a small fixed number of loop threads
+// each own an epoll instance and drive every connection as a state machine:
+//   readable  -> drain recv() into the framer -> parse/handle every complete
+//                message -> queue the response chunks on TxQueue
+//   writable  -> flush TxQueue with gathered sendmsg(); only subscribe to EPOLLOUT
+//                while data is pending
+//   wakeup    -> eventfd rung by publish_posts(): move queued SUBSCRIBE pushes to the
+//                TxQueue of each signalled subscriber whose earlier output is sent;
+//                also rung by the post log flusher: release POST replies held until
+//                their batch is durable (the loop never waits for a disk sync)
+// Each loop is a self-contained worker: it owns its own SO_REUSEPORT listening
+// socket on the server port, so the kernel load-balances incoming connections
+// across workers and no accept path is shared. If SO_REUSEPORT is unavailable the
+// workers fall back to sharing one listener registered with EPOLLEXCLUSIVE.
+
+/// @brief Per-connection state owned by exactly one reactor loop thread
+struct ReactorConnection {
+    int socket = INVALID_SOCKET;      // Non-blocking client socket
+    int clientId = 0;                 // ID assigned by register_client()
+    MessageFramer framer{transmissionTerminator};  // Received bytes, split into messages in place
+    RequestArena arena;               // Scratch memory for parsing each request
+    std::deque<ResponseChunk> TxQueue;// Response chunks not yet accepted by the kernel (shared, never copied)
+    size_t txOffset = 0;              // Bytes of TxQueue.front() already sent
+    bool closeAfterFlush = false;     // Set after QUIT: close once TxQueue drains
+    uint32_t interest = EPOLLIN | EPOLLRDHUP;  // Events currently registered with epoll
+    ClientSubscription subscription;  // SUBSCRIBE pushes (doorbell is the loop's wakeup eventfd)
+    HeldPost heldPost;                // POST reply waiting for the post log
+};
 
-/// @brief Main server event loop - listens for connections and spawns client handlers
-/// Manages TCP socket setup, binding, listening, and client connection acceptance
-/// Runs in a background thread while GUI runs in main thread
-/// Uses g_serverState.serverRunning flag to determine when to initiate shutdown
-void server_run_loop()
+/// @brief Puts a socket into non-blocking mode
+/// @param socket The socket file descriptor to modify
+/// @return True on success
+static bool set_non_blocking(int socket)
 {
-    // Server configuration constants
-    constexpr int SERVER_PORT = 26500;  // Port to listen on
-    // constexpr const char* SERVER_ADDR = "0.0.0.0"; // Listen on all interfaces
+    int flags = fcntl(socket, F_GETFL, 0);
+    if (flags == -1) return false;
+    return fcntl(socket, F_SETFL, flags | O_NONBLOCK) != -1;
+}
 
-    int ListeningSocket;          // Socket used to listen for incoming connections
-    int CommunicationSocket;      // Socket for client communication (created on accept)
+/// @brief Upper bound on chunks gathered into one sendmsg() call
+constexpr size_t REACTOR_MAX_IOV = 64;
 
-    struct sockaddr_in SvrAddr;   // Server address structure (holds IP/port binding info)
+/// @brief Sends as much of the pending TxQueue as the socket accepts without blocking
+/// Queued chunks are gathered into one sendmsg() per call, so pipelined responses and
+/// multi-chunk cached GET_BOARD responses go out together without being concatenated
+/// @param conn The connection to flush
+/// @return False if the connection hit a fatal send error and must be closed
+static bool reactor_flush(ReactorConnection& conn)
+{
+    while (!conn.TxQueue.empty())
+    {
+        struct iovec iov[REACTOR_MAX_IOV];
+        size_t iovCount = 0;
+        for (auto it = conn.TxQueue.begin(); it != conn.TxQueue.end() && iovCount < REACTOR_MAX_IOV; ++it)
+        {
+            size_t skip = (iovCount == 0) ? conn.txOffset : 0;
+            iov[iovCount].iov_base = const_cast<char*>((*it)->data() + skip);
+            iov[iovCount].iov_len = (*it)->size() - skip;
+            iovCount++;
+        }
+        struct msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovCount;
+
+        // More queued than one call can gather: MSG_MORE keeps this part from going out as a
+        // short segment that Nagle would then hold the rest behind until the peer ACKs
+        int flags = MSG_NOSIGNAL | (iovCount < conn.TxQueue.size() ? MSG_MORE : 0);
+        ssize_t bytesSent = sendmsg(conn.socket, &msg, flags);
+        count_io_syscall();
+        if (bytesSent > 0)
+        {
+            count_bytes_out(bytesSent);
 
-    // ====================================================================
-    // SOCKET CREATION
-    // ====================================================================
-    
-    // Create a TCP socket for listening (AF_INET = IPv4, SOCK_STREAM = TCP)
-    ListeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (ListeningSocket == INVALID_SOCKET)
+            // Retire fully sent chunks; remember how far into the next one we got
+            size_t remaining = (size_t)bytesSent;
+            while (remaining > 0)
+            {
+                size_t left = conn.TxQueue.front()->size() - conn.txOffset;
+                if (remaining < left)
+                {
+                    conn.txOffset += remaining;
+                    break;
+                }
+                remaining -= left;
+                conn.TxQueue.pop_front();
+                conn.txOffset = 0;
+            }
+            continue;
+        }
+        if (bytesSent == -1 && errno == EINTR) continue;              // Retry after signal
+        if (bytesSent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return true;  // Kernel buffer full - wait for EPOLLOUT
+        }
+        count_io_error(StatError::SEND);
+        return false;     // Peer reset or other fatal error
+    }
+
+    // Everything sent
+    return true;
+}
+
+/// @brief Frames, parses and handles every complete message buffered on a connection
+/// Response chunks are queued on TxQueue; QUIT stops processing and marks the connection for closing.
+/// Also called when the doorbell rings for a held POST reply, which is queued once durable.
+/// @param conn The connection whose received bytes should be processed
+static void reactor_process_messages(ReactorConnection& conn)
+{
+    if (conn.closeAfterFlush) return;
+    conn.closeAfterFlush = process_event_loop_messages(conn.framer, conn.socket, conn.clientId, conn.subscription, conn.arena,
+        conn.heldPost, [&](WireResponse&& response) {
+            for (ResponseChunk& chunk : response.chunks) conn.TxQueue.push_back(std::move(chunk));
+        });
+}
+
+/// @brief Queues a subscribed connection's pending pushes once its earlier output is sent
+/// Leaving them in the hub while TxQueue is non-empty is what bounds a slow reader's backlog
+/// @param conn The connection to push to
+/// @return False if the subscriber overflowed (--slow-subscriber=disconnect) or the send failed
+static bool reactor_send_pushes(ReactorConnection& conn)
+{
+    if (!conn.TxQueue.empty() || conn.closeAfterFlush || conn.heldPost.ticket != 0) return true;
+    if (!drain_subscription(conn.subscription, [&](WireResponse&& pushes) {
+            for (ResponseChunk& chunk : pushes.chunks) conn.TxQueue.push_back(std::move(chunk));
+        }))
     {
-        // Socket creation failed - log error and exit server
-        g_serverState.logEvent("ERROR", "Socket creation failed: " + std::string(strerror(errno)));
-        close(ListeningSocket);
-        return;
+        return false;
     }
+    return reactor_flush(conn);
+}
+
+/// @brief Updates the epoll interest set so EPOLLOUT is only requested while output is pending
+/// While a POST reply is held the connection is not read at all: its later requests must wait
+/// anyway, and level-triggered EPOLLIN would fire on every wait (EPOLLHUP is always reported)
+/// @param epollFd The loop's epoll instance
+/// @param conn The connection to re-arm
+static void reactor_update_interest(int epollFd, ReactorConnection& conn)
+{
+    uint32_t wanted = (conn.heldPost.ticket != 0) ? 0 : (EPOLLIN | EPOLLRDHUP);
+    if (!conn.TxQueue.empty()) wanted |= EPOLLOUT;
+    if (wanted == conn.interest) return;  // Nothing changed
+
+    struct epoll_event ev{};
+    ev.events = wanted;
+    ev.data.ptr = &conn;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.socket, &ev);
+    count_io_syscall();
+    conn.interest = wanted;
+}
+
+/// @brief Handles readiness on one client connection
+/// @param conn The ready connection
+/// @param events The epoll event mask reported for it
+/// @return False if the connection should be closed
+static bool reactor_handle_connection(ReactorConnection& conn, uint32_t events)
+{
+    if (events & EPOLLERR) return false;
+
+    // Peer gone while its POST reply is held: nobody is left to answer
+    if (conn.heldPost.ticket != 0 && (events & EPOLLHUP)) return false;
 
     // ====================================================================
-    // SOCKET OPTIONS
+    // READ: up to READ_BUDGET_BYTES straight into the framer. The socket is
+    // level-triggered, so anything still unread is reported by the next wait
+    // and a client that streams without pause cannot starve the others
+    // (not read at all while a POST reply is held)
     // ====================================================================
-    
-    // Set SO_REUSEADDR to allow port reuse after server restart
-    // Without this, the port might be in TIME_WAIT state and unavailable for ~30 seconds
-    int reuse = 1;
-    if (setsockopt(ListeningSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
-        g_serverState.logEvent("WARNING", "Failed to set SO_REUSEADDR: " + std::string(strerror(errno)));
+    if (conn.heldPost.ticket == 0 && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)))
+    {
+        for (size_t budget = READ_BUDGET_BYTES; budget > 0; )
+        {
+            ssize_t bytesReceived = recv(conn.socket, conn.framer.writeBuffer(4096), 4096, 0);
+            count_io_syscall();
+            if (bytesReceived > 0)
+            {
+                count_bytes_in(bytesReceived);
+                conn.framer.commit((size_t)bytesReceived);
+                if (request_too_large(conn.framer, conn.socket)) return false;
+                budget -= std::min(budget, (size_t)bytesReceived);
+                continue;
+            }
+            if (bytesReceived == 0)
+            {
+                // Peer closed - still answer anything it sent before closing
+                reactor_process_messages(conn);
+                reactor_flush(conn);
+                return false;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;  // Drained
+            count_io_error(StatError::RECV);
+            return false;  // Fatal receive error
+        }
+
+        reactor_process_messages(conn);
     }
 
     // ====================================================================
-    // SOCKET BINDING
+    // WRITE: push out as much pending response data as possible
     // ====================================================================
-    
-    // Configure the server address structure for binding
-    SvrAddr.sin_family = AF_INET;             // IPv4 address family
-    SvrAddr.sin_addr.s_addr = INADDR_ANY;     // Listen on all network interfaces (0.0.0.0)
-    SvrAddr.sin_port = htons(SERVER_PORT);    // Port 26500 (host-to-network byte order)
-    
-    // Bind the socket to the configured address and port
-    if (bind(ListeningSocket, (struct sockaddr*)&SvrAddr, sizeof(SvrAddr)) == SOCKET_ERROR)
+    if (!reactor_flush(conn)) return false;
+
+    // Output drained: subscription pushes that waited for it go next
+    if (!reactor_send_pushes(conn)) return false;
+
+    // QUIT handled and goodbye fully sent
+    if (conn.closeAfterFlush && conn.TxQueue.empty()) return false;
+    return true;
+}
+
+/// @brief Body of one reactor worker thread
+/// Accepts connections from its listening socket and multiplexes them until stopLoop is set
+/// @param workerId Index of this worker in g_serverState.workerStats
+/// @param ListeningSocket The non-blocking listening socket (per-worker, or shared in fallback mode)
+/// @param stopLoop Set by server_run_loop once the shutdown broadcast has been sent
+void reactor_loop(int workerId, int ListeningSocket, const std::atomic<bool>& stopLoop)
+{
+    t_ioStats = &g_serverState.workerStats[workerId];
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
     {
-        std::cerr << "ERROR: Failed to bind ServerSocket: " << strerror(errno) << std::endl;
-        close(ListeningSocket);
-        g_serverState.logEvent("ERROR", "Failed to bind ServerSocket: " + std::string(strerror(errno)));
+        g_serverState.logEvent("ERROR", "epoll_create1 failed: " + std::string(strerror(errno)));
         return;
     }
 
-    // ====================================================================
-    // START LISTENING
-    // ====================================================================
-    
-    // Put the socket in listening mode (backlog of 1 connection)
-    if (listen(ListeningSocket, 1) == SOCKET_ERROR)
+    // Register the listening socket; data.ptr == nullptr identifies it
+    // EPOLLEXCLUSIVE avoids waking every loop when the listener is shared (fallback mode)
+    struct epoll_event listenEv{};
+    listenEv.events = EPOLLIN | EPOLLEXCLUSIVE;
+    listenEv.data.ptr = nullptr;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ListeningSocket, &listenEv) == -1)
     {
-        std::cerr << "ERROR: Failed to configure listen on ServerSocket: " << strerror(errno) << std::endl;
-        close(ListeningSocket);
-        g_serverState.logEvent("ERROR", "Failed to configure listen on ServerSocket: " + std::string(strerror(errno)));
+        g_serverState.logEvent("ERROR", "Failed to register listening socket with epoll: " + std::string(strerror(errno)));
+        close(epollFd);
         return;
     }
 
-    // Log that server is ready to accept connections
-    g_serverState.logEvent("SERVER", "Server is listening for connections on port 26500...");
-
+    // Doorbell for SUBSCRIBE pushes to this loop's connections; data.ptr == &wakeup identifies it
+    SubscriberWakeup wakeup;
+    std::string wakeupError;
+    struct epoll_event wakeEv{};
+    wakeEv.events = EPOLLIN;
+    wakeEv.data.ptr = &wakeup;
+    if (!wakeup.open(wakeupError) || epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeup.fd(), &wakeEv) == -1)
+    {
+        g_serverState.logEvent("ERROR", "Failed to set up subscription wakeup: " +
+                               (wakeupError.empty() ? std::string(strerror(errno)) : wakeupError));
+        close(epollFd);
+        return;
+    }
+
+    // Connections owned by this loop (keyed by socket), and those holding a POST reply
+    std::unordered_map<int, std::unique_ptr<ReactorConnection>> connections;
+    std::unordered_set<ReactorConnection*> heldConnections;
+
+    auto closeConnection = [&](ReactorConnection& conn) {
+        int socket = conn.socket;
+        g_serverState.logEventf("DISCONNECT", "Client disconnected (socket: %lld)", socket);
+        end_subscription(conn.subscription);
+        heldConnections.erase(&conn);
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, socket, nullptr);
+        count_io_syscall();
+        connections.erase(socket);
+        unregister_client(socket, workerId);
+    };
+
+    constexpr int MAX_EVENTS = 64;
+    struct epoll_event events[MAX_EVENTS];
+
+    while (!stopLoop)
+    {
+        // Wake up periodically so shutdown is noticed even with no traffic
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+        count_io_syscall();
+        if (ready == -1)
+        {
+            if (errno == EINTR) continue;
+            g_serverState.logEvent("ERROR", "epoll_wait failed: " + std::string(strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < ready; i++)
+        {
+            // ============================================================
+            // NEW CONNECTIONS
+            // ============================================================
+            if (events[i].data.ptr == nullptr)
+            {
+                while (true)
+                {
+                    int CommunicationSocket = accept4(ListeningSocket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    count_io_syscall();
+                    if (CommunicationSocket == SOCKET_ERROR)
+                    {
+                        if (errno == EINTR) continue;
+                        if (errno != EAGAIN && errno != EWOULDBLOCK)
+                        {
+                            g_serverState.logEvent("WARNING", "Failed to accept connection on ServerSocket: " + std::string(strerror(errno)));
+                        }
+                        break;  // Backlog drained (or transient error)
+                    }
+
+                    auto conn = std::make_unique<ReactorConnection>();
+                    conn->socket = CommunicationSocket;
+                    conn->clientId = register_client(CommunicationSocket, workerId);
+                    conn->subscription.wakeup = &wakeup;
+                    conn->subscription.owner = conn.get();
+
+                    struct epoll_event ev{};
+                    ev.events = EPOLLIN | EPOLLRDHUP;
+                    ev.data.ptr = conn.get();
+                    count_io_syscall();
+                    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, CommunicationSocket, &ev) == -1)
+                    {
+                        g_serverState.logEvent("WARNING", "Failed to register client with epoll: " + std::string(strerror(errno)));
+                        unregister_client(CommunicationSocket, workerId);
+                        continue;
+                    }
+                    connections.emplace(CommunicationSocket, std::move(conn));
+                }
+                continue;
+            }
+
+            // ============================================================
+            // SUBSCRIPTION PUSHES READY
+            // ============================================================
+            if (events[i].data.ptr == &wakeup)
+            {
+                wakeup.clear();
+                count_io_syscall();
+                for (const std::shared_ptr<Subscriber>& subscriber : wakeup.takeReady())
+                {
+                    if (subscriber->closed()) continue;  // Unsubscribed (its connection may be gone)
+                    ReactorConnection& conn = *static_cast<ReactorConnection*>(subscriber->owner);
+                    if (!reactor_send_pushes(conn))
+                    {
+                        // Close through the normal event path: conn may still be in this batch
+                        conn.closeAfterFlush = true;
+                        shutdown(conn.socket, SHUT_RDWR);
+                        count_io_syscall();
+                        continue;
+                    }
+                    reactor_update_interest(epollFd, conn);
+                }
+
+                // Held POST replies whose batch the post log may have settled
+                for (ReactorConnection* held : std::vector<ReactorConnection*>(heldConnections.begin(), heldConnections.end()))
+                {
+                    ReactorConnection& conn = *held;
+                    reactor_process_messages(conn);
+                    if (conn.heldPost.ticket == 0) heldConnections.erase(held);  // Else still syncing (or held again)
+                    if (!reactor_flush(conn) || !reactor_send_pushes(conn))
+                    {
+                        conn.closeAfterFlush = true;
+                        shutdown(conn.socket, SHUT_RDWR);
+                        count_io_syscall();
+                        continue;
+                    }
+                    reactor_update_interest(epollFd, conn);
+                }
+                continue;
+            }
+
+            // ============================================================
+            // CLIENT CONNECTION READY
+            // ============================================================
+            ReactorConnection& conn = *static_cast<ReactorConnection*>(events[i].data.ptr);
+            if (!reactor_handle_connection(conn, events[i].events))
+            {
+                closeConnection(conn);
+                continue;
+            }
+            if (conn.heldPost.ticket != 0) heldConnections.insert(&conn);
+            reactor_update_interest(epollFd, conn);
+        }
+    }
+
+    // Loop stopping: close every connection this loop still owns
+    while (!connections.empty())
+    {
+        closeConnection(*connections.begin()->second);
+    }
+    g_serverState.postLog.cancelWatch(wakeup.fd());  // The flusher must not ring it once it is closed
+    close(epollFd);
+}
+
+// ============================================================================
+// IO_URING BACKEND (COMPLETION-BASED EVENT LOOP MODE)
+// ============================================================================
+// Same per-worker layout as the epoll reactor (one SO_REUSEPORT listener and one
+// loop per worker), but socket I/O is submitted to an io_uring instead of being
+// issued as individual syscalls:
+//   - one multishot ACCEPT per worker delivers every new connection
+//   - one multishot RECV per connection fills buffers from a provided-buffer ring,
+//     so no buffer is pinned to idle connections
+//   - queued responses go out as a chain of IOSQE_IO_LINK'ed SENDs, which the
+//     kernel executes in order
+//   - a POLL_ADD on the worker's subscription eventfd reports SUBSCRIBE pushes
+// All submissions and the wait for completions share one io_uring_enter() call.
+// Framing and request handling reuse process_buffered_messages().
+
+#ifdef SERVER_HAVE_IO_URING
+
+/// @brief One response inside a linked send chain
+struct UringSend {
+    ResponseChunk data; // Response bytes (shared with the response cache for GET_BOARD)
+    size_t sent = 0;    // Bytes the kernel has already sent
+};
+
+/// @brief Per-connection state owned by exactly one io_uring worker
+struct UringConnection {
+    int socket = INVALID_SOCKET;        // Client socket (blocking mode is fine for io_uring)
+    int clientId = 0;                   // ID assigned by register_client()
+    MessageFramer framer{transmissionTerminator};  // Received bytes, split into messages in place
+    RequestArena arena;                 // Scratch memory for parsing each request
+    std::deque<UringSend> sendQueue;    // Responses waiting for the next send chain
+    std::vector<UringSend> sendChain;   // Responses in the in-flight linked chain
+    size_t chainCompleted = 0;          // Completions received for the current chain
+    bool sendFailed = false;            // A send in the chain hit a fatal error
+    bool recvArmed = false;             // Multishot recv is active
+    bool closeAfterFlush = false;       // Set after QUIT: close once all responses are sent
+    bool closing = false;               // Shutdown issued; freed once inflight reaches zero
+    int inflight = 0;                   // Operations the kernel still owns for this connection
+    ClientSubscription subscription;    // SUBSCRIBE pushes (doorbell is the worker's wakeup eventfd)
+    HeldPost heldPost;                  // POST reply waiting for the post log
+};
+
+// user_data layout: connection pointer with the operation kind in the low bits
+constexpr uint64_t URING_OP_ACCEPT = 0;
+constexpr uint64_t URING_OP_RECV = 1;
+constexpr uint64_t URING_OP_SEND = 2;
+constexpr uint64_t URING_OP_WAKE = 3;
+constexpr uint64_t URING_OP_CANCEL = 4;
+constexpr uint64_t URING_OP_MASK = 7;
+static_assert(alignof(UringConnection) > URING_OP_MASK, "operation kind must fit below the connection pointer");
+
+constexpr unsigned URING_QUEUE_DEPTH = 1024;     // Submission queue entries per worker
+constexpr unsigned URING_BUFFER_COUNT = 256;     // Provided receive buffers per worker (power of two)
+constexpr unsigned URING_BUFFER_SIZE = 4096;     // Bytes per provided buffer
+constexpr unsigned short URING_BUFFER_GROUP = 0; // Buffer group ID used for recv
+constexpr size_t URING_MAX_CHAIN = 16;           // Longest linked send chain submitted at once
+
+/// @brief Gets a submission entry, flushing the queue to the kernel if it is full
+static struct io_uring_sqe* uring_get_sqe(IoUring& ring)
+{
+    struct io_uring_sqe* sqe = ring.getSqe();
+    while (sqe == nullptr)
+    {
+        ring.submitAndWait(0, 0);
+        count_io_syscall();
+        sqe = ring.getSqe();
+    }
+    return sqe;
+}
+
+/// @brief Arms a multishot accept on the worker's listening socket
+static void uring_arm_accept(IoUring& ring, int ListeningSocket)
+{
+    struct io_uring_sqe* sqe = uring_get_sqe(ring);
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = ListeningSocket;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = URING_OP_ACCEPT;
+}
+
+/// @brief Arms a one-shot poll on the worker's subscription wakeup eventfd
+static void uring_arm_wakeup(IoUring& ring, const SubscriberWakeup& wakeup)
+{
+    struct io_uring_sqe* sqe = uring_get_sqe(ring);
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = wakeup.fd();
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = URING_OP_WAKE;
+}
+
+/// @brief Cancels in-flight operations: the multishot accept, or every operation on a socket
+/// Kernels without cancel-by-fd fail the request; the socket shutdown completes them instead
+/// @param conn Connection whose operations to cancel, or nullptr for the accept
+static void uring_cancel(IoUring& ring, const UringConnection* conn)
+{
+    struct io_uring_sqe* sqe = uring_get_sqe(ring);
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    if (conn != nullptr)
+    {
+        sqe->fd = conn->socket;
+        sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    }
+    else
+    {
+        sqe->addr = URING_OP_ACCEPT;  // Matched against user_data
+    }
+    sqe->user_data = URING_OP_CANCEL;
+}
+
+/// @brief Arms a multishot recv that picks buffers from the provided-buffer ring
+static void uring_arm_recv(IoUring& ring, UringConnection& conn)
+{
+    struct io_uring_sqe* sqe = uring_get_sqe(ring);
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = conn.socket;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BUFFER_GROUP;
+    sqe->user_data = reinterpret_cast<uint64_t>(&conn) | URING_OP_RECV;
+    conn.recvArmed = true;
+    conn.inflight++;
+}
+
+/// @brief Submits queued responses as one linked send chain (if no chain is in flight)
+static void uring_submit_sends(IoUring& ring, UringConnection& conn)
+{
+    if (!conn.sendChain.empty() || conn.sendQueue.empty() || conn.closing) return;
+
+    while (!conn.sendQueue.empty() && conn.sendChain.size() < URING_MAX_CHAIN)
+    {
+        conn.sendChain.push_back(std::move(conn.sendQueue.front()));
+        conn.sendQueue.pop_front();
+    }
+    conn.chainCompleted = 0;
+
+    for (size_t i = 0; i < conn.sendChain.size(); i++)
+    {
+        UringSend& pending = conn.sendChain[i];
+        struct io_uring_sqe* sqe = uring_get_sqe(ring);
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = conn.socket;
+        sqe->addr = reinterpret_cast<uint64_t>(pending.data->data() + pending.sent);
+        sqe->len = (unsigned)(pending.data->size() - pending.sent);
+        // MSG_WAITALL makes the kernel retry short sends, so a link is only broken by errors;
+        // MSG_MORE on all but the last link keeps small chunks from waiting on Nagle/delayed ACK
+        // (the last link too while responses that did not fit in the chain are still queued)
+        sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        if (i + 1 < conn.sendChain.size())
+        {
+            sqe->flags = IOSQE_IO_LINK;
+            sqe->msg_flags |= MSG_MORE;
+        }
+        else if (!conn.sendQueue.empty())
+        {
+            sqe->msg_flags |= MSG_MORE;
+        }
+        sqe->user_data = reinterpret_cast<uint64_t>(&conn) | URING_OP_SEND;
+        conn.inflight++;
+    }
+}
+
+/// @brief Queues a subscribed connection's pending pushes once its earlier output is sent
+/// (see reactor_send_pushes)
+/// @return False if the subscriber overflowed (--slow-subscriber=disconnect)
+static bool uring_send_pushes(IoUring& ring, UringConnection& conn)
+{
+    if (!conn.sendQueue.empty() || !conn.sendChain.empty() || conn.closeAfterFlush || conn.closing ||
+        conn.heldPost.ticket != 0)
+    {
+        return true;
+    }
+    if (!drain_subscription(conn.subscription, [&](WireResponse&& pushes) {
+            for (ResponseChunk& chunk : pushes.chunks) conn.sendQueue.push_back(UringSend{std::move(chunk), 0});
+        }))
+    {
+        return false;
+    }
+    uring_submit_sends(ring, conn);
+    return true;
+}
+
+/// @brief Starts closing a connection: shut the socket down so pending operations complete
+static void uring_begin_close(UringConnection& conn)
+{
+    if (conn.closing) return;
+    conn.closing = true;
+    shutdown(conn.socket, SHUT_RDWR);
+    count_io_syscall();
+}
+
+/// @brief Handles every complete message buffered on a connection and submits the responses
+/// Also called when the doorbell rings for a held POST reply, which is sent once durable
+static void uring_process_messages(IoUring& ring, UringConnection& conn)
+{
+    if (conn.closeAfterFlush || conn.closing) return;
+    conn.closeAfterFlush = process_event_loop_messages(conn.framer, conn.socket, conn.clientId, conn.subscription, conn.arena,
+        conn.heldPost, [&](WireResponse&& response) {
+            for (ResponseChunk& chunk : response.chunks) conn.sendQueue.push_back(UringSend{std::move(chunk), 0});
+        });
+    uring_submit_sends(ring, conn);
+}
+
+/// @brief Handles a completion for a connection's multishot recv
+static void uring_on_recv(IoUring& ring, UringConnection& conn, const struct io_uring_cqe& cqe)
+{
+    if (!(cqe.flags & IORING_CQE_F_MORE))
+    {
+        // Multishot ended (error, EOF or out of buffers) - the kernel no longer owns it
+        conn.recvArmed = false;
+        conn.inflight--;
+    }
+
+    if (cqe.res > 0)
+    {
+        // Copy out of the provided buffer and hand it straight back to the kernel
+        unsigned short bufferId = (unsigned short)(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        count_bytes_in(cqe.res);
+        conn.framer.append(ring.bufferAt(bufferId), cqe.res);
+        ring.addBuffer(bufferId);
+        // The multishot recv keeps delivering while a POST reply is held, so the
+        // unprocessed backlog behind it is bounded the same way as one request
+        bool backlogTooLarge = conn.heldPost.ticket != 0 && conn.framer.buffered() > MAX_REQUEST_BYTES;
+        if (backlogTooLarge || request_too_large(conn.framer, conn.socket))
+        {
+            if (backlogTooLarge)
+            {
+                g_serverState.stats.countError(StatError::OVERSIZED);
+                g_serverState.logEventf("ERROR", "Client sent too much while its POST was syncing; closing (socket: %lld)", conn.socket);
+            }
+            uring_begin_close(conn);
+            return;
+        }
+
+        if (conn.heldPost.ticket == 0) uring_process_messages(ring, conn);
+    }
+    else if (cqe.res != -ENOBUFS)
+    {
+        // Peer closed the connection (0) or the receive failed
+        if (cqe.res < 0) count_io_error(StatError::RECV);
+        uring_begin_close(conn);
+        return;
+    }
+
+    // Re-arm when the multishot stopped for a recoverable reason (e.g. all buffers in use)
+    if (!conn.recvArmed && !conn.closing && !conn.closeAfterFlush)
+    {
+        uring_arm_recv(ring, conn);
+    }
+}
+
+/// @brief Handles a completion for one send in the connection's linked chain
+static void uring_on_send(IoUring& ring, UringConnection& conn, const struct io_uring_cqe& cqe)
+{
+    conn.inflight--;
+
+    // Chain members complete in submission order
+    UringSend& pending = conn.sendChain[conn.chainCompleted++];
+    if (cqe.res > 0)
+    {
+        pending.sent += cqe.res;
+        count_bytes_out(cqe.res);
+    }
+    else if (cqe.res != -ECANCELED)
+    {
+        if (!conn.sendFailed) count_io_error(StatError::SEND);
+        conn.sendFailed = true;  // -ECANCELED only means an earlier link failed
+    }
+    if (conn.chainCompleted < conn.sendChain.size()) return;
+
+    // Whole chain accounted for: requeue anything unsent (in order) ahead of newer responses
+    for (auto it = conn.sendChain.rbegin(); it != conn.sendChain.rend(); ++it)
+    {
+        if (it->sent < it->data->size()) conn.sendQueue.push_front(std::move(*it));
+    }
+    conn.sendChain.clear();
+
+    if (conn.sendFailed)
+    {
+        uring_begin_close(conn);
+        return;
+    }
+    if (conn.sendQueue.empty() && conn.closeAfterFlush)
+    {
+        uring_begin_close(conn);  // Goodbye fully sent after QUIT
+        return;
+    }
+
+    // Output drained: subscription pushes that waited for it go next
+    if (!uring_send_pushes(ring, conn))
+    {
+        uring_begin_close(conn);
+        return;
+    }
+    uring_submit_sends(ring, conn);
+}
+
+/// @brief Body of one io_uring worker thread
+/// Falls back to reactor_loop() if the kernel lacks the required io_uring features
+/// @param workerId Index of this worker in g_serverState.workerStats
+/// @param ListeningSocket The worker's listening socket (blocking mode)
+/// @param stopLoop Set by server_run_loop once the shutdown broadcast has been sent
+void uring_loop(int workerId, int ListeningSocket, const std::atomic<bool>& stopLoop)
+{
+    t_ioStats = &g_serverState.workerStats[workerId];
+
     // ====================================================================
-    // MAIN ACCEPTANCE LOOP
+    // RING AND PROVIDED-BUFFER SETUP
     // ====================================================================
-    
-    // Accept client connections and spawn handler threads
-    // Vector to hold references to client threads (not used since we detach, but could be extended)
-    std::vector<std::thread> clientThreads;
-    
-    // Continue accepting connections while server is running
-    while (g_serverState.serverRunning) {
-        // Accept an incoming connection
-        // Creates a new socket for communication with the client
-        CommunicationSocket = accept(ListeningSocket, NULL, NULL);
-        
-        // Check if accept succeeded
-        if (CommunicationSocket == SOCKET_ERROR)
-        {
-            // Accept failed - log warning but continue listening
-            g_serverState.logEvent("WARNING", "Failed to accept connection on ServerSocket: " + std::string(strerror(errno)));
-            continue;  // Keep trying to accept more connections
+    // Buffer memory and the wakeup eventfd are declared first so they outlive the ring
+    std::vector<char> bufferMemory((size_t)URING_BUFFER_COUNT * URING_BUFFER_SIZE);
+    SubscriberWakeup wakeup;
+    IoUring ring;
+    std::string error;
+    if (!ring.init(URING_QUEUE_DEPTH, error) ||
+        !ring.registerBufferRing(URING_BUFFER_GROUP, bufferMemory.data(), URING_BUFFER_COUNT, URING_BUFFER_SIZE, error) ||
+        !wakeup.open(error))
+    {
+        g_serverState.logEvent("WARNING", "Worker " + std::to_string(workerId) + ": io_uring unavailable (" + error + "), using epoll");
+        if (set_non_blocking(ListeningSocket)) {
+            reactor_loop(workerId, ListeningSocket, stopLoop);
         }
-        
-        // ================================================================
-        // SPAWN CLIENT HANDLER THREAD
-        // ================================================================
-        
-        // Create new thread to handle this client
-        // Each client gets its own thread for concurrent handling
-        // We use detach() since we don't need to wait for the thread to finish
-        // The thread will clean itself up when the client disconnects
-        std::thread t(client_handler, CommunicationSocket);
-        t.detach();  // Let thread run independently
+        return;
     }
 
+    // Connections owned by this worker (keyed by socket), and those holding a POST reply
+    std::unordered_map<int, std::unique_ptr<UringConnection>> connections;
+    std::unordered_set<UringConnection*> heldConnections;
+
+    auto finishClose = [&](UringConnection& conn) {
+        int socket = conn.socket;
+        g_serverState.logEventf("DISCONNECT", "Client disconnected (socket: %lld)", socket);
+        end_subscription(conn.subscription);
+        heldConnections.erase(&conn);
+        connections.erase(socket);
+        unregister_client(socket, workerId);
+    };
+
+    // Submits queued entries, waits (bounded) for completions and dispatches them
+    auto runOnce = [&]() -> bool {
+        // Submission and wait share one io_uring_enter() call
+        int ret = ring.submitAndWait(1, 100);
+        count_io_syscall();
+        if (ret < 0 && ret != -ETIME && ret != -EINTR && ret != -EBUSY)
+        {
+            g_serverState.logEvent("ERROR", "io_uring_enter failed: " + std::string(strerror(-ret)));
+            return false;
+        }
+
+        ring.forEachCompletion([&](const struct io_uring_cqe& cqe) {
+            uint64_t kind = cqe.user_data & URING_OP_MASK;
+
+            // ============================================================
+            // NEW CONNECTIONS
+            // ============================================================
+            if (kind == URING_OP_ACCEPT)
+            {
+                if (cqe.res >= 0)
+                {
+                    auto conn = std::make_unique<UringConnection>();
+                    conn->socket = cqe.res;
+                    conn->clientId = register_client(cqe.res, workerId);
+                    conn->subscription.wakeup = &wakeup;
+                    conn->subscription.owner = conn.get();
+                    uring_arm_recv(ring, *conn);
+                    if (stopLoop) uring_begin_close(*conn);  // Accepted while shutting down
+                    connections.emplace(cqe.res, std::move(conn));
+                }
+                else
+                {
+                    g_serverState.logEvent("WARNING", "Failed to accept connection on ServerSocket: " + std::string(strerror(-cqe.res)));
+                }
+                if (!(cqe.flags & IORING_CQE_F_MORE) && !stopLoop) uring_arm_accept(ring, ListeningSocket);
+                return;
+            }
+            if (kind == URING_OP_CANCEL) return;  // The cancelled operations report their own completions
+
+            // ============================================================
+            // SUBSCRIPTION PUSHES READY
+            // ============================================================
+            if (kind == URING_OP_WAKE)
+            {
+                wakeup.clear();
+                count_io_syscall();
+                for (const std::shared_ptr<Subscriber>& subscriber : wakeup.takeReady())
+                {
+                    if (subscriber->closed()) continue;  // Unsubscribed (its connection may be gone)
+                    UringConnection& conn = *static_cast<UringConnection*>(subscriber->owner);
+                    if (uring_send_pushes(ring, conn)) continue;
+                    uring_begin_close(conn);
+                    if (conn.inflight == 0) finishClose(conn);
+                }
+
+                // Held POST replies whose batch the post log may have settled
+                for (UringConnection* held : std::vector<UringConnection*>(heldConnections.begin(), heldConnections.end()))
+                {
+                    UringConnection& conn = *held;
+                    uring_process_messages(ring, conn);
+                    if (conn.heldPost.ticket != 0 && !conn.closing) continue;  // Still syncing
+                    heldConnections.erase(held);
+                    if (!uring_send_pushes(ring, conn)) uring_begin_close(conn);
+                    if (conn.closing && conn.inflight == 0) finishClose(conn);
+                }
+                uring_arm_wakeup(ring, wakeup);
+                return;
+            }
+
+            // ============================================================
+            // CLIENT CONNECTION COMPLETIONS
+            // ============================================================
+            UringConnection& conn = *reinterpret_cast<UringConnection*>(cqe.user_data & ~URING_OP_MASK);
+            if (kind == URING_OP_RECV) uring_on_recv(ring, conn, cqe);
+            else uring_on_send(ring, conn, cqe);
+
+            if (conn.closing && conn.inflight == 0) finishClose(conn);
+            else if (conn.heldPost.ticket != 0) heldConnections.insert(&conn);
+        });
+        return true;
+    };
+
     // ====================================================================
-    // GRACEFUL SERVER SHUTDOWN
+    // COMPLETION LOOP
     // ====================================================================
-    
+    uring_arm_accept(ring, ListeningSocket);
+    uring_arm_wakeup(ring, wakeup);
+    bool healthy = true;
+    while (!stopLoop && healthy)
+    {
+        healthy = runOnce();
+    }
+
+    // Loop stopping: shut every connection down, cancel what the kernel still owns and
+    // wait for those completions, since in-flight sends reference connection buffers
+    uring_cancel(ring, nullptr);
+    for (auto& entry : connections)
+    {
+        uring_begin_close(*entry.second);
+        uring_cancel(ring, entry.second.get());
+    }
+    for (int attempt = 0; healthy && attempt < 50 && !connections.empty(); attempt++)
+    {
+        healthy = runOnce();
+    }
+    if (!connections.empty())
+    {
+        // Operations still pending: tear the ring down first so the kernel drops them
+        // before their buffers are freed
+        g_serverState.logEventf("WARNING", "Worker %lld: %lld connections did not drain, closing the ring",
+                                (long long)workerId, (long long)connections.size());
+        ring.close();
+    }
+    while (!connections.empty())
+    {
+        finishClose(*connections.begin()->second);
+    }
+    g_serverState.postLog.cancelWatch(wakeup.fd());  // The flusher must not ring it once it is closed
+}
+
+#endif // SERVER_HAVE_IO_URING
+
+// ============================================================================
+// SHUTDOWN BROADCAST
+// ============================================================================
+
+/// @brief Notifies all connected clients that the server is shutting down
+/// Sends the SERVER/SHUTDOWN goodbye message to every tracked socket, then gives
+/// clients a moment to receive it before their sockets are closed
+void broadcast_shutdown_message()
+{
     // Server shutdown initiated (serverRunning set to false by GUI)
     g_serverState.logEvent("SERVER", "Initiating server shutdown - disconnecting all clients...");
     
-    // ================================================================
-    // GOODBYE MESSAGE BROADCAST
-    // ================================================================
-    
     // Notify all connected clients that server is shutting down
     {
         std::lock_guard<std::mutex> lock(g_serverState.clientsMutex);
@@ -1123,7 +2843,7 @@ void server_run_loop()
         // 2. We're about to close sockets forcefully, which can interrupt in-flight data
         for (int attempt = 0; attempt < 3; attempt++) {
             for (int clientSocket : clientsToDisconnect) {
-                send_all_bytes(clientSocket, goodbyeMessage.c_str(), goodbyeMessage.size(), 0);
+                send_all_bytes(clientSocket, goodbyeMessage.c_str(), goodbyeMessage.size(), MSG_NOSIGNAL);
             }
             
             // Add delay between attempts to allow client threads time to process
@@ -1135,30 +2855,414 @@ void server_run_loop()
     
     // Give clients time to receive and process the goodbye message
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
+}
+
+// ============================================================================
+// LISTENING SOCKET SETUP
+// ============================================================================
+
+/// @brief Creates, binds and starts listening on a TCP socket for the configured port
+/// @param config Server configuration (port and backlog)
+/// @param reusePort True to set SO_REUSEPORT so several workers can each own a listener
+///                  on the same port (the kernel then load-balances new connections)
+/// @return The listening socket, or INVALID_SOCKET on failure (already logged)
+int open_listening_socket(const ServerConfig& config, bool reusePort)
+{
+    struct sockaddr_in SvrAddr;   // Server address structure (holds IP/port binding info)
+
+    // ====================================================================
+    // SOCKET CREATION
+    // ====================================================================
     
-    // ================================================================
-    // CLEANUP
-    // ================================================================
+    // Create a TCP socket for listening (AF_INET = IPv4, SOCK_STREAM = TCP)
+    int ListeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (ListeningSocket == INVALID_SOCKET)
+    {
+        // Socket creation failed - log error and exit server
+        g_serverState.logEvent("ERROR", "Socket creation failed: " + std::string(strerror(errno)));
+        return INVALID_SOCKET;
+    }
+
+    // ====================================================================
+    // SOCKET OPTIONS
+    // ====================================================================
     
-    // Close the listening socket (client sockets will be closed by their handler threads)
-    close(ListeningSocket);
+    // Set SO_REUSEADDR to allow port reuse after server restart
+    // Without this, the port might be in TIME_WAIT state and unavailable for ~30 seconds
+    int reuse = 1;
+    if (setsockopt(ListeningSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
+        g_serverState.logEvent("WARNING", "Failed to set SO_REUSEADDR: " + std::string(strerror(errno)));
+    }
+
+    // Set SO_REUSEPORT so every worker can bind its own listener to the same port
+    if (reusePort && setsockopt(ListeningSocket, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+        g_serverState.logEvent("WARNING", "Failed to set SO_REUSEPORT: " + std::string(strerror(errno)));
+        close(ListeningSocket);
+        return INVALID_SOCKET;
+    }
+
+    // ====================================================================
+    // SOCKET BINDING
+    // ====================================================================
+    
+    // Configure the server address structure for binding
+    SvrAddr.sin_family = AF_INET;             // IPv4 address family
+    SvrAddr.sin_addr.s_addr = INADDR_ANY;     // Listen on all network interfaces (0.0.0.0)
+    SvrAddr.sin_port = htons(config.port);    // Port 26500 by default (host-to-network byte order)
     
+    // Bind the socket to the configured address and port
+    if (bind(ListeningSocket, (struct sockaddr*)&SvrAddr, sizeof(SvrAddr)) == SOCKET_ERROR)
+    {
+        std::cerr << "ERROR: Failed to bind ServerSocket: " << strerror(errno) << std::endl;
+        g_serverState.logEvent("ERROR", "Failed to bind ServerSocket: " + std::string(strerror(errno)));
+        close(ListeningSocket);
+        return INVALID_SOCKET;
+    }
+
+    // ====================================================================
+    // START LISTENING
+    // ====================================================================
+    
+    // Put the socket in listening mode
+    // The old backlog of 1 made the kernel drop connection bursts (clients then wait out
+    // SYN retransmits); the configured backlog is capped by the kernel's somaxconn
+    if (listen(ListeningSocket, config.backlog) == SOCKET_ERROR)
+    {
+        std::cerr << "ERROR: Failed to configure listen on ServerSocket: " << strerror(errno) << std::endl;
+        g_serverState.logEvent("ERROR", "Failed to configure listen on ServerSocket: " + std::string(strerror(errno)));
+        close(ListeningSocket);
+        return INVALID_SOCKET;
+    }
+
+    return ListeningSocket;
+}
+
+// ============================================================================
+// SERVER MAIN LOOP
+// ============================================================================
+
+/// @brief Main server event loop - listens for connections and spawns client handlers
+/// Manages TCP socket setup, binding, listening, and client connection acceptance
+/// Depending on g_serverState.config.ioMode, clients get a dedicated thread each or
+/// are multiplexed across the epoll reactor (or io_uring) workers
+/// Runs in a background thread while GUI runs in main thread
+/// Uses g_serverState.serverRunning flag to determine when to initiate shutdown
+void server_run_loop()
+{
+    // Server configuration (port, I/O mode) is filled in before the server thread starts
+    const ServerConfig& config = g_serverState.config;
+    g_serverState.subscriptions.configure(config.subscriptions);
+    g_serverState.eventLog.setRawSampling((uint32_t)config.logRawSampleEvery);
+
+    // Recover posts from the write-ahead log before accepting any client
+    std::string logError;
+    if (!start_post_log(config, logError))
+    {
+        g_serverState.logEvent("ERROR", logError);
+        return;
+    }
+
+    // Cap the board for new POSTs only, so loading and replay never lose saved posts
+    g_serverState.messageBoard.setCapacity(config.maxPosts > 0 ? config.maxPosts : BoardStore::MAX_POSTS);
+
+    if (config.ioMode == IoMode::EPOLL || config.ioMode == IoMode::IO_URING)
+    {
+        // ================================================================
+        // EVENT LOOP MODES: ONE LISTENER + EVENT LOOP PER WORKER
+        // ================================================================
+        // Both backends share the worker/listener layout; only the loop body differs
+        bool useUring = config.ioMode == IoMode::IO_URING;
+#ifndef SERVER_HAVE_IO_URING
+        if (useUring)
+        {
+            g_serverState.logEvent("WARNING", "Built without io_uring support - using the epoll reactor");
+            useUring = false;
+        }
+#endif
+        int workerCount = std::max(1, std::min(config.loopThreads, MAX_SERVER_WORKERS));
+        if (config.requestPool.threads > 0)
+        {
+            // The loop workers are already a fixed set of threads handling every request
+            g_serverState.logEvent("WARNING", "--handlers applies to --io=threads only; event-loop workers handle requests themselves");
+        }
+
+        // Give every worker its own SO_REUSEPORT listener so accepts are spread by the kernel
+        std::vector<int> listeners;
+        for (int i = 0; i < workerCount; i++)
+        {
+            int ListeningSocket = open_listening_socket(config, true);
+            if (ListeningSocket == INVALID_SOCKET) break;
+            listeners.push_back(ListeningSocket);
+        }
+
+        // Fallback: one listener shared by all workers (EPOLLEXCLUSIVE / one multishot accept each)
+        bool sharedListener = (int)listeners.size() < workerCount;
+        if (sharedListener)
+        {
+            for (int ListeningSocket : listeners) close(ListeningSocket);
+            listeners.clear();
+
+            int ListeningSocket = open_listening_socket(config, false);
+            if (ListeningSocket == INVALID_SOCKET) { stop_post_log(); return; }
+            listeners.push_back(ListeningSocket);
+            g_serverState.logEvent("WARNING", "SO_REUSEPORT unavailable - workers share one listening socket");
+        }
+
+        // Epoll workers accept from their listening sockets themselves, so they must never block
+        // (io_uring workers keep them blocking - the kernel completes accepts asynchronously)
+        for (int ListeningSocket : listeners)
+        {
+            if (useUring) break;
+            if (!set_non_blocking(ListeningSocket))
+            {
+                g_serverState.logEvent("ERROR", "Failed to make listening socket non-blocking: " + std::string(strerror(errno)));
+                for (int fd : listeners) close(fd);
+                stop_post_log();
+                return;
+            }
+        }
+
+        // Log that server is ready to accept connections
+        g_serverState.logEvent("SERVER", "Server is listening for connections on port " + std::to_string(config.port) + "...");
+
+        // Spawn the workers; they run until after the shutdown broadcast
+        std::atomic<bool> stopLoops{false};
+        std::vector<std::thread> workerThreads;
+        g_serverState.workerCount = workerCount;
+        for (int i = 0; i < workerCount; i++) {
+            int ListeningSocket = sharedListener ? listeners[0] : listeners[i];
+#ifdef SERVER_HAVE_IO_URING
+            if (useUring) {
+                workerThreads.emplace_back(uring_loop, i, ListeningSocket, std::cref(stopLoops));
+                continue;
+            }
+#endif
+            workerThreads.emplace_back(reactor_loop, i, ListeningSocket, std::cref(stopLoops));
+        }
+        g_serverState.logEvent("SERVER", std::string(useUring ? "io_uring" : "Epoll reactor") + " started with " +
+                               std::to_string(workerCount) + " worker(s)" +
+                               (sharedListener ? " sharing one listener" : " using SO_REUSEPORT listeners"));
+
+        // Idle until the GUI (or signal) clears serverRunning
+        while (g_serverState.serverRunning) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        broadcast_shutdown_message();
+
+        // Stop the workers; each one closes the connections it owns
+        stopLoops = true;
+        for (auto& t : workerThreads) {
+            t.join();
+        }
+
+        // Close the listening sockets
+        for (int ListeningSocket : listeners) {
+            close(ListeningSocket);
+        }
+    }
+    else
+    {
+        // ================================================================
+        // THREAD-PER-CLIENT MODE: MAIN ACCEPTANCE LOOP
+        // ================================================================
+        int ListeningSocket = open_listening_socket(config, false);
+        if (ListeningSocket == INVALID_SOCKET) { stop_post_log(); return; }
+
+        // Log that server is ready to accept connections
+        g_serverState.logEvent("SERVER", "Server is listening for connections on port " + std::to_string(config.port) + "...");
+
+        // The single accept loop reports its counters as worker 0
+        g_serverState.workerCount = 1;
+        t_ioStats = &g_serverState.workerStats[0];
+
+        // Connection threads do the socket I/O and a fixed pool (--handlers) runs the requests;
+        // at most --max-connections connection threads are live at once
+        g_serverState.requestPool.start(config.requestPool, [] { t_ioStats = &g_serverState.workerStats[0]; });
+        g_serverState.logEvent("SERVER", "Request handler pool started with " + std::to_string(g_serverState.requestPool.size()) +
+                               " thread(s), queue limit " + std::to_string(config.requestPool.queueLimit) +
+                               ", connection limit " + std::to_string(config.requestPool.maxConnections));
+
+        // Continue accepting connections while server is running
+        while (g_serverState.serverRunning) {
+            // At the connection cap, stop accepting until a connection thread finishes:
+            // new clients wait in the listen backlog instead of each getting a thread
+            if (!g_serverState.requestPool.admitConnection([] { return !g_serverState.serverRunning; }))
+            {
+                break;  // Shutting down
+            }
+
+            // Accept an incoming connection
+            // Creates a new socket for communication with the client
+            int CommunicationSocket = accept(ListeningSocket, NULL, NULL);
+            count_io_syscall();
+            
+            // Check if accept succeeded
+            if (CommunicationSocket == SOCKET_ERROR)
+            {
+                // Accept failed - log warning but continue listening
+                g_serverState.requestPool.releaseConnection();
+                g_serverState.logEvent("WARNING", "Failed to accept connection on ServerSocket: " + std::string(strerror(errno)));
+                continue;  // Keep trying to accept more connections
+            }
+            
+            // ============================================================
+            // SPAWN CLIENT HANDLER THREAD
+            // ============================================================
+            
+            // Create new thread to handle this client
+            // Each client gets its own thread for concurrent handling
+            // We use detach() since we don't need to wait for the thread to finish
+            // The thread will clean itself up (and free its connection slot) when the client disconnects
+            std::thread t([CommunicationSocket] {
+                client_handler(CommunicationSocket);
+                g_serverState.requestPool.releaseConnection();
+            });
+            t.detach();  // Let thread run independently
+        }
+
+        broadcast_shutdown_message();
+
+        // Close the listening socket (client sockets are closed by their handler threads)
+        close(ListeningSocket);
+
+        // Finish queued requests; connection threads still running handle their own from now on
+        g_serverState.requestPool.stop();
+    }
+
+    // Flush and close the post log
+    stop_post_log();
+
     // Log completion of server shutdown
     g_serverState.logEvent("SERVER", "Server shutdown complete");
 }
 
+// ============================================================================
+// COMMAND LINE CONFIGURATION
+// ============================================================================
+
+/// @brief Parses server startup options into a ServerConfig
+/// Supported options:
+///   --io=threads|epoll|uring  Connection handling model (default: threads)
+///   --loops=N            Number of epoll/io_uring workers, each with its own listener (default: 2)
+///   --port=N             TCP port to listen on (default: 26500)
+///   --backlog=N          listen() backlog per listening socket (default: 4096)
+///   --wal=PATH           Write-ahead log of accepted posts (default: MessageBoard.wal)
+///   --wal-sync=none|write|fsync  What POST_OK waits for (default: fsync)
+///   --wal-flush-us=N     Group-commit window in microseconds (default: 0 = flush immediately)
+///   --wal-batch=N        Flush a group early once N posts are queued (default: 256)
+///   --wal-segment-mb=N   Start a new log segment once the current one reaches N MiB (default: 64)
+///   --snapshot-s=N       Save new posts to MessageBoard.board and compact the log every N seconds
+///                        (default: 30, 0 = only on exit)
+///   --subscriber-queue=N Pushed posts queued per SUBSCRIBE'd connection (default: 1024)
+///   --slow-subscriber=drop|disconnect  What happens when that queue is full (default: drop)
+///   --handlers=N         Thread-per-client mode: run requests on N pooled handler threads
+///                        (default: one per CPU core, 0 = on each connection's own thread)
+///   --handler-queue=N    Requests queued for the handler pool before connections are held back (default: 1024)
+///   --max-connections=N  Thread-per-client mode: live connection threads before accepts are held back
+///                        (default: 1024, 0 = no cap)
+///   --log-raw-sample=N   Keep the raw request/reply of 1 in N events in the event log while the GUI's
+///                        Event Log tab is hidden (default: 0 = only while it is shown)
+///   --max-posts=N        Reject POSTs that would take the board past N posts with POST_ERROR
+///                        (default: 0 = BoardStore::MAX_POSTS)
+/// @param argc Argument count from main()
+/// @param argv Argument vector from main()
+/// @param config Output: configuration to fill in (unmentioned fields keep their defaults)
+/// @param errorDetails Output: description of the first invalid option
+/// @return True if all options were recognised and valid
+bool parse_server_args(int argc, char* argv[], ServerConfig& config, std::string& errorDetails)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+        try {
+            if (key == "--io" && value == "threads") {
+                config.ioMode = IoMode::THREAD_PER_CLIENT;
+            } else if (key == "--io" && value == "epoll") {
+                config.ioMode = IoMode::EPOLL;
+            } else if (key == "--io" && value == "uring") {
+                config.ioMode = IoMode::IO_URING;
+            } else if (key == "--loops" && std::stoi(value) > 0) {
+                config.loopThreads = std::stoi(value);
+            } else if (key == "--port" && std::stoi(value) > 0 && std::stoi(value) < 65536) {
+                config.port = std::stoi(value);
+            } else if (key == "--backlog" && std::stoi(value) > 0) {
+                config.backlog = std::stoi(value);
+            } else if (key == "--wal" && !value.empty()) {
+                config.postLogPath = value;
+            } else if (key == "--wal-sync" && value == "none") {
+                config.postLog.durability = LogDurability::NONE;
+            } else if (key == "--wal-sync" && value == "write") {
+                config.postLog.durability = LogDurability::WRITE;
+            } else if (key == "--wal-sync" && value == "fsync") {
+                config.postLog.durability = LogDurability::FSYNC;
+            } else if (key == "--wal-flush-us" && std::stoi(value) >= 0) {
+                config.postLog.flushIntervalUs = std::stoi(value);
+            } else if (key == "--wal-batch" && std::stoi(value) > 0) {
+                config.postLog.maxBatchRecords = std::stoi(value);
+            } else if (key == "--wal-segment-mb" && std::stoi(value) > 0 && std::stoi(value) <= 4096) {
+                config.postLog.segmentBytes = (size_t)std::stoi(value) << 20;
+            } else if (key == "--snapshot-s" && std::stoi(value) >= 0) {
+                config.snapshotIntervalSec = std::stoi(value);
+            } else if (key == "--subscriber-queue" && std::stoi(value) > 0) {
+                config.subscriptions.queueLimit = (size_t)std::stoi(value);
+            } else if (key == "--slow-subscriber" && value == "drop") {
+                config.subscriptions.policy = SlowSubscriberPolicy::DROP;
+            } else if (key == "--slow-subscriber" && value == "disconnect") {
+                config.subscriptions.policy = SlowSubscriberPolicy::DISCONNECT;
+            } else if (key == "--handlers" && std::stoi(value) >= 0 && std::stoi(value) <= 1024) {
+                config.requestPool.threads = std::stoi(value);
+            } else if (key == "--handler-queue" && std::stoi(value) > 0) {
+                config.requestPool.queueLimit = (size_t)std::stoi(value);
+            } else if (key == "--max-connections" && std::stoi(value) >= 0) {
+                config.requestPool.maxConnections = (size_t)std::stoi(value);
+            } else if (key == "--log-raw-sample" && std::stoi(value) >= 0) {
+                config.logRawSampleEvery = std::stoi(value);
+            } else if (key == "--max-posts" && !value.empty() && value[0] != '-') {
+                config.maxPosts = (size_t)std::stoull(value);
+            } else {
+                errorDetails = "Invalid option: " + arg;
+                return false;
+            }
+        } catch (const std::exception&) {
+            errorDetails = "Invalid value for option: " + arg;
+            return false;
+        }
+    }
+    return true;
+}
+
 // ============================================================================
 // STANDALONE SERVER ENTRY POINT
 // ============================================================================
 
 /// @brief Main entry point when compiling standalone server (not as part of GUI)
 /// Only compiled when both UNIT_TEST and GUI_BUILD are not defined
-/// Starts the server main loop
+/// Parses startup options and starts the server main loop
 #if !defined(UNIT_TEST) && !defined(GUI_BUILD)
-int main()
+int main(int argc, char* argv[])
 {
+    std::string errorDetails;
+    if (!parse_server_args(argc, argv, g_serverState.config, errorDetails))
+    {
+        std::cerr << errorDetails << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [--io=threads|epoll|uring] [--loops=N] [--port=N] [--backlog=N]"
+                  << " [--wal=PATH] [--wal-sync=none|write|fsync] [--wal-flush-us=N] [--wal-batch=N]"
+                  << " [--wal-segment-mb=N] [--snapshot-s=N] [--subscriber-queue=N] [--slow-subscriber=drop|disconnect]"
+                  << " [--handlers=N] [--handler-queue=N] [--max-connections=N] [--log-raw-sample=N] [--max-posts=N]" << std::endl;
+        return 1;
+    }
+
+    // Load the latest snapshot; server_run_loop replays only the log tail after it
+    g_serverState.loadFromFile();
+
     // Run the server main loop (blocking until shutdown)
     server_run_loop();
+    g_serverState.saveToFile();
     return 0;
 }
 #endif
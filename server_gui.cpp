@@ -10,12 +10,25 @@
 
 using namespace ftxui;
 
-// Forward declaration - defined in server.cpp
+// Forward declarations - defined in server.cpp
 extern void server_run_loop();
+extern bool parse_server_args(int argc, char* argv[], ServerConfig& config, std::string& errorDetails);
+extern bool publish_posts(std::vector<Post>&& batch, std::string& errorDetails);
 
 // Global access to the message board object
 
-int main() {
+int main(int argc, char* argv[]) {
+  // Apply startup options (--io, --loops, --port, --backlog, --wal*, --snapshot-s, --subscriber-queue, --slow-subscriber, --handlers, --handler-queue, --max-connections) before the server thread starts
+  std::string arg_error;
+  if (!parse_server_args(argc, argv, g_serverState.config, arg_error)) {
+    std::cerr << arg_error << std::endl;
+    std::cerr << "Usage: " << argv[0] << " [--io=threads|epoll|uring] [--loops=N] [--port=N] [--backlog=N]"
+              << " [--wal=PATH] [--wal-sync=none|write|fsync] [--wal-flush-us=N] [--wal-batch=N]"
+              << " [--wal-segment-mb=N] [--snapshot-s=N] [--subscriber-queue=N] [--slow-subscriber=drop|disconnect]"
+              << " [--handlers=N] [--handler-queue=N] [--max-connections=N] [--log-raw-sample=N] [--max-posts=N]" << std::endl;
+    return 1;
+  }
+
   g_serverState.loadFromFile();
   // Spawn the server in a background thread so it accepts connections while GUI runs in main thread
   std::thread server_thread(server_run_loop);
@@ -36,8 +49,7 @@ int main() {
   
   // Server stats that will be updated from shared state every frame
   int messageCount = 0;
-  int activeClients = 0;
-  int totalReceived = 0;
+  ServerStatsTotals server_stats;  // Summed from the per-thread counter shards
 
   // Track which tab is currently selected (0=Board, 1=Log, 2=Clients, 3=Stats)
   int selected_tab = 0;
@@ -133,17 +145,11 @@ int main() {
     if (selected_tab == 0) {
       // For Message Board: go to page 1 and mark all posts as viewed
       current_page = 0;
-      {
-        std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
-        last_displayed_message_count = g_serverState.messageBoard.size();
-      }
+      last_displayed_message_count = g_serverState.messageBoard.size();
     } else if (selected_tab == 1) {
       // For Event Log: go to page 1 and mark all events as viewed
       current_log_page = 0;
-      {
-        std::lock_guard<std::mutex> lock(g_serverState.eventLogMutex);
-        last_displayed_event_count = g_serverState.eventLog.size();
-      }
+      last_displayed_event_count = g_serverState.eventLog.total();
     }
   });
   
@@ -167,13 +173,11 @@ int main() {
   auto next_page_button = Button("Next >", [&] {
     if (selected_tab == 0) {
       // Message Board: check total pages and increment if not on last page
-      std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
       int total_posts = g_serverState.messageBoard.size();
       int total_pages = (total_posts + POSTS_PER_PAGE - 1) / POSTS_PER_PAGE;
       if (current_page < total_pages - 1) current_page++;
     } else if (selected_tab == 1) {
       // Event Log: check total event pages and increment if not on last page
-      std::lock_guard<std::mutex> lock(g_serverState.eventLogMutex);
       int total_events = g_serverState.eventLog.size();
       int total_pages = (total_events + EVENTS_PER_PAGE - 1) / EVENTS_PER_PAGE;
       if (current_log_page < total_pages - 1) current_log_page++;
@@ -215,16 +219,21 @@ int main() {
       "Final test message in this batch."
     };
     
-    // Lock the board and add 5 random posts
-    std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
+    // Build 5 random posts and publish them (board + post log) as one batch
+    std::vector<Post> batch;
     for (int i = 0; i < 5; i++) {
       Post p;
       p.author = authors[author_dist(gen)];
       p.title = titles[title_dist(gen)];
       p.message = messages[msg_dist(gen)];
       p.clientId = 999; // Special ID marking these as test posts
-      g_serverState.messageBoard.push_back(p);
-      g_serverState.totalMessagesReceived++;
+      batch.push_back(p);
+    }
+    std::string error;
+    if (!publish_posts(std::move(batch), error)) {
+      g_serverState.logEvent("ERROR", error);
+    } else {
+      g_serverState.stats.add(ServerStats::MESSAGES_RECEIVED, 5);
     }
     // Log the test action for visibility in event log
     g_serverState.logEvent("TEST", "Added 5 random test posts");
@@ -237,13 +246,9 @@ int main() {
   // This renderer runs every frame and constructs the main viewport content
   // It handles all tab rendering, filtering, pagination, and state updates
   auto content_scroller = Renderer([&] {
-    // Update statistics from shared state (thread-safe with lock)
-    {
-      std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
-      messageCount = g_serverState.messageBoard.size();
-      activeClients = g_serverState.activeConnections;
-      totalReceived = g_serverState.totalMessagesReceived;
-    }
+    // Update statistics from shared state (board size and counters are read without locking)
+    messageCount = g_serverState.messageBoard.size();
+    server_stats = g_serverState.stats.totals();
 
     // Apply any pending filters (set by "Apply Filters" button)
     // This deferred approach prevents blocking the render thread
@@ -256,31 +261,26 @@ int main() {
     
     // Check if new messages have arrived (for banner display)
     // This check happens every frame even if not viewing the Message Board
-    {
-      std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
-      if (g_serverState.messageBoard.size() > last_displayed_message_count && current_page > 0) {
-        // New messages exist and we're on an older page - banner will display
-      }
+    if (g_serverState.messageBoard.size() > last_displayed_message_count && current_page > 0) {
+      // New messages exist and we're on an older page - banner will display
     }
     
     // Check if new events have arrived (for banner display)
-    {
-      std::lock_guard<std::mutex> lock(g_serverState.eventLogMutex);
-      if (g_serverState.eventLog.size() > last_displayed_event_count && current_log_page > 0) {
-        // New events exist and we're on an older event page - banner will display
-      }
+    if (g_serverState.eventLog.total() > last_displayed_event_count && current_log_page > 0) {
+      // New events exist and we're on an older event page - banner will display
     }
     
     // Update last displayed message count when viewing page 1 (newest content)
     if (current_page == 0 && selected_tab == 0) {
-      std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
       last_displayed_message_count = g_serverState.messageBoard.size();
     }
     
+    // Request threads copy raw wire messages into the event log only while this tab can show them
+    g_serverState.eventLog.setRawVisible(selected_tab == 1);
+    
     // Update last displayed event count when viewing page 1 of event log
     if (current_log_page == 0 && selected_tab == 1) {
-      std::lock_guard<std::mutex> lock(g_serverState.eventLogMutex);
-      last_displayed_event_count = g_serverState.eventLog.size();
+      last_displayed_event_count = g_serverState.eventLog.total();
     }
 
     // Determine if there's new content (computed once per frame for all tabs)
@@ -289,16 +289,10 @@ int main() {
     bool has_new_events = false;
     
     // Check message board for new content
-    {
-      std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
-      has_new_messages = (g_serverState.messageBoard.size() > last_displayed_message_count);
-    }
+    has_new_messages = (g_serverState.messageBoard.size() > last_displayed_message_count);
     
-    // Check event log for new content
-    {
-      std::lock_guard<std::mutex> lock(g_serverState.eventLogMutex);
-      has_new_events = (g_serverState.eventLog.size() > last_displayed_event_count);
-    }
+    // Check event log for new content (total() counts events the ring has already dropped too)
+    has_new_events = (g_serverState.eventLog.total() > last_displayed_event_count);
 
     // ========================================================================
     // TAB 0: MESSAGE BOARD
@@ -309,19 +303,21 @@ int main() {
       int total_pages = 0;           // Track total pages for page display
       
       {
-        std::lock_guard<std::mutex> lock(g_serverState.boardMutex);
-        
         // BUILD FILTERED MESSAGE LIST (do this first, regardless of empty check)
-        // Iterate backwards through board (newest first) and collect indices of matching posts
-        std::vector<int> filtered_indices;
-        for (int i = (int)g_serverState.messageBoard.size() - 1; i >= 0; i--) {
-          const auto& post = g_serverState.messageBoard[i];
-          // Check if post matches both title and author filters
-          bool title_match = filter_title.empty() || post.title.find(filter_title) != std::string::npos;
-          bool author_match = filter_author.empty() || post.author.find(filter_author) != std::string::npos;
-          if (title_match && author_match) {
-            filtered_indices.push_back(i);
-          }
+        // Indices of matching posts, newest first; the search index matches the substrings
+        // against the distinct authors/titles and expands them to posts, so no full-board scan
+        // No lock needed: published posts never move, and POSTs may keep appending meanwhile
+        size_t board_size = g_serverState.messageBoard.size();
+        std::vector<uint32_t> filtered_indices;
+        if (filter_author.empty() && filter_title.empty()) {
+          filtered_indices.resize(board_size);
+          for (size_t i = 0; i < board_size; i++) filtered_indices[i] = (uint32_t)(board_size - 1 - i);
+        } else {
+          SearchQuery query;
+          query.author = filter_author;
+          query.title = filter_title;
+          filtered_indices = g_serverState.searchIndex.search(g_serverState.messageBoard, g_serverState.boardIndex,
+                                                              board_size, query);
         }
         
         // CALCULATE PAGINATION ON FILTERED RESULTS
@@ -347,7 +343,7 @@ int main() {
           // RENDER EACH POST ON CURRENT PAGE
           for (int i = start_idx; i < end_idx; i++) {
             int original_idx = filtered_indices[i];  // Get index in full board
-            const auto& post = g_serverState.messageBoard[original_idx];
+            const auto& post = g_serverState.messageBoard.at(original_idx);
             int post_number = i + 1;  // Display numbering (1-indexed)
             
             message_elements.push_back(
@@ -355,14 +351,14 @@ int main() {
                 // Post number, author name, and client ID
                 hbox(
                   text("#" + std::to_string(post_number) + "  ") | dim,
-                  text("Author: " + (post.author.empty() ? "(anonymous)" : post.author)) | bold,
+                  text("Author: " + (post.author.empty() ? std::string("(anonymous)") : std::string(post.author))) | bold,
                   text("  |  "),
                   text("Client #" + std::to_string(post.clientId)) | color(Color::Green)
                 ),
                 // Post title
-                text("Title: " + post.title),
+                text("Title: " + std::string(post.title)),
                 // Post message content
-                text("Message: " + post.message),
+                text("Message: " + std::string(post.message)),
                 separator()
               ) | border
             );
@@ -423,15 +419,15 @@ int main() {
     // ========================================================================
     else if (selected_tab == 1) {
       Elements log_elements;
+      // Copy of the newest events, newest first (timestamps are formatted here, not by the server)
+      std::vector<ServerEvent> events = g_serverState.eventLog.snapshot();
       {
-        std::lock_guard<std::mutex> lock(g_serverState.eventLogMutex);
-        
         // Handle empty log case
-        if (g_serverState.eventLog.empty()) {
+        if (events.empty()) {
           log_elements.push_back(text("(No events yet)") | dim);
         } else {
           // CALCULATE PAGINATION FOR EVENT LOG
-          int total_events = g_serverState.eventLog.size();
+          int total_events = events.size();
           int total_pages = (total_events + EVENTS_PER_PAGE - 1) / EVENTS_PER_PAGE;
           
           // Clamp current log page to valid range
@@ -443,9 +439,9 @@ int main() {
           int start_idx = current_log_page * EVENTS_PER_PAGE;
           int end_idx = std::min(start_idx + EVENTS_PER_PAGE, total_events);
           
-          // RENDER EVENTS (newest first, using reverse iterator)
+          // RENDER EVENTS (snapshot is already newest first)
           int event_count = 0;
-          for (auto it = g_serverState.eventLog.rbegin(); it != g_serverState.eventLog.rend(); ++it) {
+          for (auto it = events.begin(); it != events.end(); ++it) {
             // Only render events within current page range
             if (event_count >= start_idx && event_count < end_idx) {
               // Select color based on event type
@@ -500,7 +496,7 @@ int main() {
       }
       
       // Page counter for event log
-      log_viewport_elements.push_back(text("Page " + std::to_string(current_log_page + 1) + " of " + std::to_string((g_serverState.eventLog.size() + EVENTS_PER_PAGE - 1) / EVENTS_PER_PAGE)) | dim | center);
+      log_viewport_elements.push_back(text("Page " + std::to_string(current_log_page + 1) + " of " + std::to_string((events.size() + EVENTS_PER_PAGE - 1) / EVENTS_PER_PAGE)) | dim | center);
       log_viewport_elements.push_back(separator());
       log_viewport_elements.push_back(vbox(log_elements));
       
@@ -548,6 +544,34 @@ int main() {
     // TAB 3: SERVER STATISTICS
     // ========================================================================
     else if (selected_tab == 3) {
+      // Per-worker connection and I/O counters (relaxed atomics, no lock needed)
+      Elements worker_elements;
+      int worker_count = g_serverState.workerCount;
+      for (int w = 0; w < worker_count; w++) {
+        const WorkerStats& stats = g_serverState.workerStats[w];
+        worker_elements.push_back(
+          hbox(
+            text("  Worker " + std::to_string(w) + ": ") | bold,
+            text("accepted " + std::to_string(stats.accepted.load(std::memory_order_relaxed))) | color(Color::Green),
+            text("  active " + std::to_string(stats.active.load(std::memory_order_relaxed))) | color(Color::Yellow),
+            text("  closed " + std::to_string(stats.closed.load(std::memory_order_relaxed))) | color(Color::Red),
+            text("  requests " + std::to_string(stats.requests.load(std::memory_order_relaxed))) | color(Color::Cyan),
+            text("  syscalls " + std::to_string(stats.ioSyscalls.load(std::memory_order_relaxed))) | color(Color::GrayLight)
+          )
+        );
+      }
+
+      // Requests by command and errors by kind
+      std::string request_counts;
+      for (size_t c = 0; c < (size_t)StatCommand::COUNT; c++) {
+        request_counts += "  " + std::string(ServerStats::commandName((StatCommand)c)) + " " + std::to_string(server_stats.requests[c]);
+      }
+      std::string error_counts;
+      for (size_t e = 0; e < (size_t)StatError::COUNT; e++) {
+        error_counts += "  " + std::string(ServerStats::errorName((StatError)e)) + " " + std::to_string(server_stats.errors[e]);
+      }
+
+      long poolExecuted = g_serverState.requestPool.executed.load(std::memory_order_relaxed);
       viewport_content = vbox(
         text("Server Statistics") | bold | color(Color::Blue) | center,
         separator(),
@@ -556,7 +580,8 @@ int main() {
           // Active connections counter
           hbox(
             text("  Connected Clients: ") | bold,
-            text(std::to_string(activeClients)) | color(Color::Green)
+            text(std::to_string(server_stats.activeConnections)) | color(Color::Green),
+            text("  (" + std::to_string(server_stats.connectionsOpened) + " since start)") | color(Color::GrayLight)
           ),
           text(""),
           // Total messages posted
@@ -565,12 +590,69 @@ int main() {
             text(std::to_string(messageCount)) | color(Color::Yellow)
           ),
           text(""),
-          // Total requests received
+          // Total requests received, by command
           hbox(
             text("  Total Requests Received: ") | bold,
-            text(std::to_string(totalReceived)) | color(Color::Blue)
+            text(std::to_string(server_stats.totalRequests())) | color(Color::Blue),
+            text(request_counts) | color(Color::GrayLight)
+          ),
+          text(""),
+          // Client socket traffic
+          hbox(
+            text("  Traffic: ") | bold,
+            text("in " + std::to_string(server_stats.bytesIn) + " bytes") | color(Color::Cyan),
+            text("  out " + std::to_string(server_stats.bytesOut) + " bytes") | color(Color::Cyan),
+            text("  posts received " + std::to_string(server_stats.messagesReceived)) | color(Color::Yellow),
+            text("  responses sent " + std::to_string(server_stats.messagesSent)) | color(Color::Green)
+          ),
+          text(""),
+          // Errors by kind
+          hbox(
+            text("  Errors: ") | bold,
+            text(std::to_string(server_stats.totalErrors())) | color(Color::Red),
+            text(error_counts) | color(Color::GrayLight)
+          ),
+          text(""),
+          // GET_BOARD response cache (hits need no serialization, extensions only the new posts)
+          hbox(
+            text("  GET_BOARD Cache: ") | bold,
+            text("hits " + std::to_string(g_serverState.responseCache.hits.load(std::memory_order_relaxed))) | color(Color::Green),
+            text("  extended " + std::to_string(g_serverState.responseCache.extensions.load(std::memory_order_relaxed))) | color(Color::Yellow),
+            text("  misses " + std::to_string(g_serverState.responseCache.misses.load(std::memory_order_relaxed))) | color(Color::Red)
+          ),
+          text(""),
+          // SUBSCRIBE fan-out (dropped/disconnected count slow subscribers)
+          hbox(
+            text("  Subscribers: ") | bold,
+            text(std::to_string(g_serverState.subscriptions.size())) | color(Color::Cyan),
+            text("  pushed " + std::to_string(g_serverState.subscriptions.pushed.load(std::memory_order_relaxed))) | color(Color::Green),
+            text("  dropped " + std::to_string(g_serverState.subscriptions.dropped.load(std::memory_order_relaxed))) | color(Color::Yellow),
+            text("  disconnected " + std::to_string(g_serverState.subscriptions.disconnected.load(std::memory_order_relaxed))) | color(Color::Red)
+          ),
+          text(""),
+          // Request handler pool (--handlers; wait = time a request queued before a handler took it)
+          hbox(
+            text("  Request Handlers: ") | bold,
+            text(std::to_string(g_serverState.requestPool.size())) | color(Color::Cyan),
+            text("  queued " + std::to_string(g_serverState.requestPool.queued()) +
+                 " (peak " + std::to_string(g_serverState.requestPool.peakQueued.load(std::memory_order_relaxed)) + ")") | color(Color::Yellow),
+            text("  avg wait " + std::to_string(poolExecuted > 0 ? g_serverState.requestPool.waitUsTotal.load(std::memory_order_relaxed) / poolExecuted : 0) +
+                 "us  max " + std::to_string(g_serverState.requestPool.waitUsMax.load(std::memory_order_relaxed)) + "us") | color(Color::GrayLight),
+            text("  throttled " + std::to_string(g_serverState.requestPool.throttled.load(std::memory_order_relaxed))) | color(Color::Red),
+            text("  stolen " + std::to_string(g_serverState.requestPool.stolen.load(std::memory_order_relaxed))) | color(Color::Green)
+          ),
+          // Connection threads admitted (--max-connections; held back = accepts that waited for a slot)
+          hbox(
+            text("  Connection Threads: ") | bold,
+            text(std::to_string(g_serverState.requestPool.connections()) + " / " +
+                 (g_serverState.requestPool.connectionLimit() > 0 ? std::to_string(g_serverState.requestPool.connectionLimit()) : std::string("no cap"))) | color(Color::Cyan),
+            text("  (peak " + std::to_string(g_serverState.requestPool.peakConnections.load(std::memory_order_relaxed)) + ")") | color(Color::Yellow),
+            text("  held back " + std::to_string(g_serverState.requestPool.acceptsThrottled.load(std::memory_order_relaxed))) | color(Color::Red)
           ),
-          text("")
+          text(""),
+          // Accept/event-loop workers
+          text("  Connection Workers:") | bold,
+          vbox(worker_elements)
         )
       );
     }
@@ -581,18 +663,14 @@ int main() {
     
     Elements alert_elements;
     {
-      std::lock_guard<std::mutex> lock(g_serverState.eventLogMutex);
+      std::vector<ServerEvent> recent = g_serverState.eventLog.snapshot(10);
       
       // Handle empty event log case
-      if (g_serverState.eventLog.empty()) {
+      if (recent.empty()) {
         alert_elements.push_back(text("(No recent events)") | dim);
       } else {
         // Show last 8-10 events (most recent first)
-        int count = 0;
-        int max_alerts = std::min(10, (int)g_serverState.eventLog.size());
-        
-        // Iterate backwards through event log (newest first)
-        for (auto it = g_serverState.eventLog.rbegin(); it != g_serverState.eventLog.rend() && count < max_alerts; ++it, ++count) {
+        for (auto it = recent.begin(); it != recent.end(); ++it) {
           // Color code based on event type
           Color event_color = Color::White;
           if (it->event_type == "CONNECT") event_color = Color::Green;
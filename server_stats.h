@@ -0,0 +1,151 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Request commands counted separately by ServerStats (same order as CLIENT_COMMANDS)
+enum class StatCommand {
+    GET_BOARD,
+    POST,
+    SUBSCRIBE,
+    UNSUBSCRIBE,
+    SEARCH,
+    INVALID_COMMAND,
+    QUIT,
+    COUNT
+};
+
+/// @brief Error kinds counted separately by ServerStats
+enum class StatError {
+    PARSE,      // Request could not be parsed (answered with INVALID_COMMAND)
+    POST,       // POST rejected by validation or the post log (answered with POST_ERROR)
+    RECV,       // Receive failed (not a clean close by the peer)
+    SEND,       // Send failed, so the connection was dropped
+    OVERSIZED,  // Request over MAX_REQUEST_BYTES without a terminator (connection closed)
+    COUNT
+};
+
+/// @brief Server-wide totals, summed over every ServerStats shard by ServerStats::totals()
+struct ServerStatsTotals {
+    long long connectionsOpened = 0;
+    long long connectionsClosed = 0;
+    long long activeConnections = 0;  // Opened minus closed (never negative)
+    long long messagesReceived = 0;   // Posts accepted from clients
+    long long messagesSent = 0;       // Responses handed to clients (pushes are counted by the SubscriptionHub)
+    long long bytesIn = 0;            // Bytes received from client sockets
+    long long bytesOut = 0;           // Bytes sent to client sockets
+    long long requests[(size_t)StatCommand::COUNT] = {};
+    long long errors[(size_t)StatError::COUNT] = {};
+
+    long long totalRequests() const {
+        long long sum = 0;
+        for (long long count : requests) sum += count;
+        return sum;
+    }
+    long long totalErrors() const {
+        long long sum = 0;
+        for (long long count : errors) sum += count;
+        return sum;
+    }
+};
+
+/// @brief Connection, traffic, per-command and per-error counters, sharded across threads
+///
+/// Every counter has one copy per shard, and each shard is its own set of cache lines. A thread
+/// is given a shard the first time it counts something (round robin), so request threads update
+/// their own lines with relaxed atomic adds and never contend with each other or with the GUI.
+/// Beyond SHARDS threads (thread-per-client mode) shards are shared, which stays correct because
+/// updates are atomic adds. totals() sums the shards. It may miss updates made while it runs,
+/// which is fine for statistics. Client IDs come from a single atomic counter instead, as they
+/// must be unique.
+class ServerStats {
+public:
+    static constexpr size_t SHARDS = 64;  // Power of two
+
+    /// @brief Plain counters (the per-command and per-error ones follow them in each shard)
+    enum Counter : size_t {
+        CONNECTIONS_OPENED,
+        CONNECTIONS_CLOSED,
+        MESSAGES_RECEIVED,
+        MESSAGES_SENT,
+        BYTES_IN,
+        BYTES_OUT,
+        COUNTER_COUNT
+    };
+
+    ServerStats() = default;
+    ServerStats(const ServerStats&) = delete;
+    ServerStats& operator=(const ServerStats&) = delete;
+
+    /// @brief Adds amount to a counter in the calling thread's shard
+    void add(Counter counter, uint64_t amount = 1) { bump(counter, amount); }
+
+    /// @brief Counts one request with the given command
+    void countRequest(StatCommand command) { bump(COUNTER_COUNT + (size_t)command, 1); }
+
+    /// @brief Counts one error of the given kind
+    void countError(StatError error) { bump(COUNTER_COUNT + (size_t)StatCommand::COUNT + (size_t)error, 1); }
+
+    /// @brief Allocates the next client ID (1, 2, 3, ...)
+    int nextClientId() { return clientIds.fetch_add(1, std::memory_order_relaxed); }
+
+    /// @brief Sums every shard
+    ServerStatsTotals totals() const {
+        uint64_t sums[FIELD_COUNT] = {};
+        for (const Shard& shard : shards) {
+            for (size_t field = 0; field < FIELD_COUNT; field++) {
+                sums[field] += shard.values[field].load(std::memory_order_relaxed);
+            }
+        }
+
+        ServerStatsTotals totals;
+        totals.connectionsOpened = (long long)sums[CONNECTIONS_OPENED];
+        totals.connectionsClosed = (long long)sums[CONNECTIONS_CLOSED];
+        totals.activeConnections = std::max(0LL, totals.connectionsOpened - totals.connectionsClosed);
+        totals.messagesReceived = (long long)sums[MESSAGES_RECEIVED];
+        totals.messagesSent = (long long)sums[MESSAGES_SENT];
+        totals.bytesIn = (long long)sums[BYTES_IN];
+        totals.bytesOut = (long long)sums[BYTES_OUT];
+        for (size_t i = 0; i < (size_t)StatCommand::COUNT; i++) {
+            totals.requests[i] = (long long)sums[COUNTER_COUNT + i];
+        }
+        for (size_t i = 0; i < (size_t)StatError::COUNT; i++) {
+            totals.errors[i] = (long long)sums[COUNTER_COUNT + (size_t)StatCommand::COUNT + i];
+        }
+        return totals;
+    }
+
+    /// @brief Display name of a command counter
+    static const char* commandName(StatCommand command) {
+        static const char* const names[] = {"GET_BOARD", "POST", "SUBSCRIBE", "UNSUBSCRIBE", "SEARCH", "INVALID", "QUIT"};
+        return names[(size_t)command];
+    }
+
+    /// @brief Display name of an error counter
+    static const char* errorName(StatError error) {
+        static const char* const names[] = {"parse", "post", "recv", "send", "oversized"};
+        return names[(size_t)error];
+    }
+
+private:
+    static constexpr size_t FIELD_COUNT = COUNTER_COUNT + (size_t)StatCommand::COUNT + (size_t)StatError::COUNT;
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> values[FIELD_COUNT]{};
+    };
+
+    /// @brief The calling thread's shard index (assigned on first use, shared by every ServerStats)
+    static size_t shardIndex() {
+        static std::atomic<size_t> nextShard{0};
+        thread_local size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) & (SHARDS - 1);
+        return index;
+    }
+
+    void bump(size_t field, uint64_t amount) {
+        shards[shardIndex()].values[field].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    Shard shards[SHARDS];
+    alignas(64) std::atomic<int> clientIds{1};  // Next client ID
+};
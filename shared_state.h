@@ -1,132 +1,209 @@
 #pragma once
+#include <sys/stat.h>
 #include <vector>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <mutex>
-#include <deque>
 #include <chrono>
 #include <iostream>
+#include <atomic>
+#include <memory>
 
-const std::string MESSAGEBOARD_FILE = "MessageBoard.txt";
+#include "board_file.h"
+#include "board_index.h"
+#include "board_store.h"
+#include "event_log.h"
+#include "post_log.h"
+#include "request_pool.h"
+#include "response_cache.h"
+#include "search_index.h"
+#include "server_stats.h"
+#include "subscription_hub.h"
 
-/// @brief Represents a message board post
-struct Post {
-    std::string author;
-    std::string title;
-    std::string message;
-    int clientId = 0;  // Which client posted this (socket ID or client number)
+const std::string MESSAGEBOARD_FILE = "MessageBoard.board";
+const std::string MESSAGEBOARD_TEXT_FILE = "MessageBoard.txt";  // Pre-binary format, converted on first start
+const std::string POSTLOG_FILE = "MessageBoard.wal";
+
+/// @brief Selects how server_run_loop multiplexes client connections
+enum class IoMode {
+    THREAD_PER_CLIENT,  // One detached thread per accepted socket (blocking I/O)
+    EPOLL,              // Non-blocking sockets multiplexed across a few epoll loop threads
+    IO_URING            // Same worker layout, with completion-based io_uring I/O (falls back to EPOLL)
 };
 
-/// @brief Represents a server event log entry
-struct ServerEvent {
-    std::string timestamp;
-    std::string event_type;  // "CONNECT", "DISCONNECT", "POST", "GET_BOARD", "ERROR"
-    std::string message;     // Human-readable description
-    std::string raw_message; // Raw wire format message (optional)
+/// @brief Startup configuration for the server (filled in before server_run_loop starts)
+struct ServerConfig {
+    IoMode ioMode = IoMode::THREAD_PER_CLIENT;
+    int port = 26500;
+    int loopThreads = 2;    // Number of event loop workers, each with its own SO_REUSEPORT listener (EPOLL/IO_URING)
+    int backlog = 4096;     // listen() backlog per listening socket (kernel caps it at somaxconn)
+    std::string postLogPath = POSTLOG_FILE;  // Write-ahead log of accepted posts (base name of its segments)
+    PostLogOptions postLog;                  // Durability level, group-commit tuning and segment size
+    std::string snapshotPath = MESSAGEBOARD_FILE;  // Binary board snapshot (loadFromFile/saveToFile)
+    std::string legacyBoardPath = MESSAGEBOARD_TEXT_FILE;  // Text snapshot converted when snapshotPath is missing
+    int snapshotIntervalSec = 30;            // Background snapshot period (0 = only on exit)
+    SubscriptionOptions subscriptions;       // SUBSCRIBE push queue bound and slow-subscriber policy
+    RequestPoolOptions requestPool;          // Handler threads and queue bound for thread-per-client requests
+    int logRawSampleEvery = 0;               // Keep the raw payload of 1 in N events while the GUI's Event Log is hidden (0 = none)
+    size_t maxPosts = 0;                     // POSTs past this many board posts get POST_ERROR (0 = BoardStore::MAX_POSTS)
+};
+
+/// @brief Upper bound on epoll workers (sizes the fixed per-worker counter table)
+constexpr int MAX_SERVER_WORKERS = 64;
+
+/// @brief Connection counters for one accept/event-loop worker
+/// Each worker gets its own cache line so workers never contend on these updates
+struct alignas(64) WorkerStats {
+    std::atomic<long> accepted{0};  // Connections accepted by this worker
+    std::atomic<long> active{0};    // Connections currently owned by this worker
+    std::atomic<long> closed{0};    // Connections this worker has closed
+    std::atomic<long> requests{0};  // Request messages framed and handled by this worker
+    std::atomic<long> ioSyscalls{0};// Socket/event-loop system calls issued by this worker
 };
 
 /// @brief Shared server state accessible by both server and GUI threads
 struct SharedServerState {
-    std::vector<Post> messageBoard;
-    std::mutex boardMutex;
+    // Message board (append-only; readers never block writers, see board_store.h)
+    BoardStore messageBoard;
+    
+    // Author/title posting lists for filtered GET_BOARD (kept in step by publish_posts)
+    BoardIndex boardIndex;
+    
+    // Word and trigram indexes behind SEARCH and the GUI's substring filters (kept in step by publish_posts)
+    SearchIndex searchIndex;
+    
+    // Serialized GET_BOARD responses, extended as posts are appended (hit/miss counters in the Stats tab)
+    ResponseCache responseCache;
+    
+    // Write-ahead log: every accepted POST batch is made durable here before POST_OK
+    PostLog postLog;
+    
+    // SUBSCRIBE'd connections: publish_posts pushes every new post to the matching ones
+    SubscriptionHub subscriptions;
     
-    // Event log (keep last 100 events)
-    std::deque<ServerEvent> eventLog;
-    std::mutex eventLogMutex;
+    // Bounded handler threads that run thread-per-client requests (queue/wait counters in the Stats tab)
+    RequestPool requestPool;
+    
+    // Event log: lock-free ring of the newest EventLog::CAPACITY events (the GUI reads snapshots)
+    EventLog eventLog;
     
     // Active client tracking
     std::vector<int> activeClientSockets;
     std::mutex clientsMutex;
     
-    int activeConnections = 0;
-    int totalMessagesReceived = 0;
-    int totalMessagesSent = 0;
-    int nextClientId = 1;  // Auto-incrementing client ID
+    // Connection, traffic, per-command and per-error counters plus client IDs (sharded per thread, summed on read)
+    ServerStats stats;
+    
+    std::atomic<bool> serverRunning{true};
     
-    bool serverRunning = true;
+    // Startup configuration (read-only once the server thread is running)
+    ServerConfig config;
+    
+    // Per-worker connection counters (thread-per-client mode reports everything as worker 0)
+    WorkerStats workerStats[MAX_SERVER_WORKERS];
+    std::atomic<int> workerCount{0};  // Number of workerStats entries in use
     
     /// @brief Add an event to the log
-    void logEvent(const std::string& event_type, const std::string& message, const std::string& raw_message = "") {
-        std::lock_guard<std::mutex> lock(eventLogMutex);
-        
-        // Get current timestamp
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        char timeBuffer[20];
-        strftime(timeBuffer, sizeof(timeBuffer), "%H:%M:%S", localtime(&time));
-        
-        ServerEvent event{timeBuffer, event_type, message, raw_message};
-        eventLog.push_back(event);
-        
-        // Keep only the last 100 events
-        if (eventLog.size() > 100) {
-            eventLog.pop_front();
-        }
+    /// Copies the text into a preallocated ring slot (no lock, no allocation); the timestamp is
+    /// formatted only when the GUI reads the event, and raw_message is only kept while the
+    /// Event Log tab is shown or when --log-raw-sample picks the event
+    void logEvent(std::string_view event_type, std::string_view message, std::string_view raw_message = {}) {
+        eventLog.push(event_type, message, raw_message);
+    }
+    
+    /// @brief Add a per-request event without building its message: format is a string literal
+    /// taking two long long arguments (e.g. "Client posted %lld message(s) (socket: %lld)"),
+    /// formatted when the GUI reads the event
+    void logEventf(std::string_view event_type, const char* format, long long a, long long b = 0,
+                   std::string_view raw_message = {}) {
+        eventLog.pushFormat(event_type, format, a, b, raw_message);
     }
     
-    /// @brief Load message board from file at startup
+    /// @brief Load message board from the snapshot file at startup
+    /// The binary board file is memory-mapped and its posts are served from the mapping.
+    /// If it does not exist yet but a MessageBoard.txt from an older version does, that
+    /// text file is converted once. Board index N is post log sequence N
     void loadFromFile() {
-        std::lock_guard<std::mutex> lock(boardMutex);
-        
-        std::ifstream file(MESSAGEBOARD_FILE);
-        if (!file.is_open()) {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        const std::string& path = config.snapshotPath;
+        std::string error;
+        snapshotCount = 0;
+        snapshotAppendable = false;
+
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0 && stat(config.legacyBoardPath.c_str(), &info) == 0) {
+            size_t converted = 0;
+            if (!BoardFile::convertText(config.legacyBoardPath, path, converted, error)) {
+                logEvent("ERROR", "Failed to convert " + config.legacyBoardPath + ": " + error);
+                return;
+            }
+            logEvent("SYSTEM", "Converted " + std::to_string(converted) + " messages from " +
+                               config.legacyBoardPath + " to " + path);
+        }
+        if (stat(path.c_str(), &info) != 0) {
             // File doesn't exist yet, start fresh
             logEvent("SYSTEM", "No saved messages found, starting with empty board");
             return;
         }
         
-        messageBoard.clear();
-        std::string line;
-        
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            
-            // Expected format per post:
-            // AUTHOR|TITLE|MESSAGE|CLIENTID
-            std::istringstream iss(line);
-            std::string author, title, message, clientIdStr;
-            
-            if (std::getline(iss, author, '|') &&
-                std::getline(iss, title, '|') &&
-                std::getline(iss, message, '|') &&
-                std::getline(iss, clientIdStr, '|')) {
-                
-                Post p;
-                p.author = author;
-                p.title = title;
-                p.message = message;
-                p.clientId = std::stoi(clientIdStr);
-                
-                messageBoard.push_back(p);
-            }
+        auto file = std::make_unique<BoardFile>();
+        if (!file->open(path, error)) {
+            logEvent("ERROR", "Failed to load messages: " + error);
+            return;
         }
         
-        file.close();
+        // An interrupted save left the file readable but not appendable: rewrite it next time
+        snapshotAppendable = !file->indexRebuilt();
+        messageBoard.clear();
+        messageBoard.attachFile(std::move(file));
+        snapshotCount = messageBoard.size();
         logEvent("SYSTEM", "Loaded " + std::to_string(messageBoard.size()) + " messages from file");
     }
     
-    /// @brief Save message board to file
-    void saveToFile() {
-        std::lock_guard<std::mutex> lock(boardMutex);
-        
-        std::ofstream file(MESSAGEBOARD_FILE);
-        if (!file.is_open()) {
-            logEvent("ERROR", "Failed to save messages to file");
-            return;
+    /// @brief Save the message board to the snapshot file and compact the post log
+    /// Incremental: only posts published since the last save are appended (the first save
+    /// after a missing or damaged load rewrites the file). The walk is lock-free, so POSTs
+    /// continue while it runs. Once the snapshot is synced, log segments it covers are deleted
+    /// @return True if the snapshot now holds every post published when the save started
+    bool saveToFile() {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        size_t count = messageBoard.size();
+        bool rewrite = !snapshotAppendable || count < snapshotCount;
+        size_t first = rewrite ? 0 : snapshotCount;
+        auto viewAt = [&](size_t i) { return messageBoard.at(i); };
+
+        if (first < count || rewrite) {
+            std::string error;
+            bool ok = !rewrite && BoardFile::append(config.snapshotPath, snapshotCount, count, viewAt, error);
+            if (!ok) {
+                // Full rewrite goes to a temporary file, so a crash never leaves a partial snapshot
+                first = 0;
+                ok = BoardFile::write(config.snapshotPath, count, viewAt, error);
+            }
+            if (!ok) {
+                snapshotAppendable = false;
+                logEvent("ERROR", "Failed to save messages: " + error);
+                return false;
+            }
+            snapshotCount = count;
+            snapshotAppendable = true;
+            logEvent("SYSTEM", "Saved " + std::to_string(count - first) + " messages to file (" +
+                               std::to_string(count) + " total)");
         }
         
-        for (const auto& post : messageBoard) {
-            // Format: AUTHOR|TITLE|MESSAGE|CLIENTID
-            file << post.author << "|"
-                 << post.title << "|"
-                 << post.message << "|"
-                 << post.clientId << "\n";
+        // Every record below count is now in the snapshot
+        size_t removed = postLog.compact(count);
+        if (removed > 0) {
+            logEvent("SYSTEM", "Compacted post log: removed " + std::to_string(removed) + " segment(s)");
         }
-        
-        file.close();
-        logEvent("SYSTEM", "Saved " + std::to_string(messageBoard.size()) + " messages to file");
+        return true;
     }
+
+private:
+    std::mutex snapshotMutex;         // Serializes loadFromFile/saveToFile (never held by POSTs)
+    size_t snapshotCount = 0;         // Posts already in the snapshot file
+    bool snapshotAppendable = false;  // Snapshot file is intact, so new posts can be appended
 };
 
 /// @brief Global shared state instance
@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Id of a string that is not in a StringPool (e.g. a post read from the mapped board file)
+constexpr uint32_t NO_STRING_ID = UINT32_MAX;
+
+/// @brief Concurrent intern table: every distinct string is stored once and named by a dense id
+///
+/// The board keeps authors and titles as ids into one of these, so a post repeats 4 bytes
+/// instead of a std::string per field, and comparing two names is comparing two integers.
+/// intern() and find() hash the string to one of SHARDS shards, each with its own lock, so
+/// concurrent writers rarely wait for each other. view() takes no lock: ids index a chunked
+/// directory that only grows, and a string's bytes never move once interned, so a view stays
+/// valid until clear(). Ids are dense (0, 1, 2, ...) so callers can index arrays by them.
+class StringPool {
+public:
+    static constexpr size_t SHARDS = 16;
+    static constexpr size_t CHUNK_SHIFT = 12;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_SHIFT;  // Ids per directory chunk
+    static constexpr size_t MAX_CHUNKS = 16384;                     // 64M distinct strings
+    static constexpr size_t CHARS_PER_BLOCK = 64 * 1024;            // Bytes per character block
+
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    ~StringPool() { clear(); }
+
+    /// @brief Returns the id of text, adding it first if it is new
+    /// Throws std::length_error once MAX_CHUNKS * CHUNK_SIZE strings are stored
+    uint32_t intern(std::string_view text) {
+        size_t hash = std::hash<std::string_view>()(text);
+        Shard& shard = shards[hash % SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(text);
+        if (it != shard.ids.end()) return it->second;
+
+        uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        if (id >= CHUNK_SIZE * MAX_CHUNKS) {
+            next.fetch_sub(1, std::memory_order_relaxed);
+            throw std::length_error("string pool is full");
+        }
+        std::string_view stored = shard.store(text);
+        chunkFor(id)[id & (CHUNK_SIZE - 1)] = stored;
+        shard.ids.emplace(stored, id);
+        return id;
+    }
+
+    /// @brief Returns the id of text, or NO_STRING_ID if it was never interned (never adds it)
+    uint32_t find(std::string_view text) const {
+        size_t hash = std::hash<std::string_view>()(text);
+        const Shard& shard = shards[hash % SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(text);
+        return it == shard.ids.end() ? NO_STRING_ID : it->second;
+    }
+
+    /// @brief The string named by id (lock-free)
+    /// @param id An id returned by intern() (or obtained from data published after it)
+    std::string_view view(uint32_t id) const {
+        return chunks[id >> CHUNK_SHIFT].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+    }
+
+    /// @brief Number of distinct strings stored
+    size_t size() const { return next.load(std::memory_order_acquire); }
+
+    /// @brief Bytes held for string contents (character blocks, excluding the hash tables)
+    size_t bytes() const {
+        size_t total = 0;
+        for (const Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.blockBytes;
+        }
+        return total;
+    }
+
+    /// @brief Drops every string; ids and views handed out before are invalid afterwards
+    /// Not safe while other threads use the pool (the board calls it from its own clear())
+    void clear() {
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.ids.clear();
+            shard.blocks.clear();
+            shard.blockUsed = shard.blockCapacity = shard.blockBytes = 0;
+        }
+        for (auto& slot : chunks) {
+            delete[] slot.exchange(nullptr, std::memory_order_acq_rel);
+        }
+        next.store(0, std::memory_order_release);
+    }
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string_view, uint32_t> ids;  // Keys view the shard's blocks
+        std::vector<std::unique_ptr<char[]>> blocks;          // Interned bytes (never moved)
+        size_t blockUsed = 0;                                 // Bytes used in blocks.back()
+        size_t blockCapacity = 0;                             // Size of blocks.back()
+        size_t blockBytes = 0;                                // Sum of all block sizes
+
+        /// @brief Copies text into the shard's blocks (caller holds mutex)
+        std::string_view store(std::string_view text) {
+            if (text.empty()) return std::string_view();
+            if (blocks.empty() || blockCapacity - blockUsed < text.size()) {
+                blockCapacity = std::max(CHARS_PER_BLOCK, text.size());
+                blocks.push_back(std::make_unique<char[]>(blockCapacity));
+                blockBytes += blockCapacity;
+                blockUsed = 0;
+            }
+            char* out = blocks.back().get() + blockUsed;
+            std::memcpy(out, text.data(), text.size());
+            blockUsed += text.size();
+            return std::string_view(out, text.size());
+        }
+    };
+
+    /// @brief The directory chunk holding id, created on first use
+    std::string_view* chunkFor(uint32_t id) {
+        std::atomic<std::string_view*>& slot = chunks[id >> CHUNK_SHIFT];
+        std::string_view* chunk = slot.load(std::memory_order_acquire);
+        if (chunk != nullptr) return chunk;
+        // Interners in different shards may race to create the same chunk; one wins
+        std::string_view* created = new std::string_view[CHUNK_SIZE];
+        if (slot.compare_exchange_strong(chunk, created, std::memory_order_acq_rel)) return created;
+        delete[] created;
+        return chunk;
+    }
+
+    Shard shards[SHARDS];
+    std::atomic<uint32_t> next{0};                             // Next id to hand out
+    std::atomic<std::string_view*> chunks[MAX_CHUNKS] = {};    // Id directory, filled on demand
+};
@@ -0,0 +1,240 @@
+#pragma once
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "post.h"
+#include "response_cache.h"
+
+/// @brief What happens to a subscriber whose push queue is full
+enum class SlowSubscriberPolicy {
+    DROP,       // Skip posts until it catches up, then tell it the first id it missed
+    DISCONNECT  // Close its connection
+};
+
+/// @brief Fan-out tuning (see --subscriber-queue and --slow-subscriber)
+struct SubscriptionOptions {
+    size_t queueLimit = 1024;                              // Pushed posts waiting per subscriber
+    SlowSubscriberPolicy policy = SlowSubscriberPolicy::DROP;
+};
+
+class SubscriberWakeup;
+
+/// @brief One SUBSCRIBE'd connection as seen by the hub
+/// Created by SubscriptionHub::subscribe(); everything except the push queue belongs to the
+/// I/O thread that owns the connection
+class Subscriber {
+public:
+    Subscriber(std::string authorFilter, std::string titleFilter, SubscriberWakeup* wakeup, void* owner)
+        : authorFilter(std::move(authorFilter)), titleFilter(std::move(titleFilter)), wakeup(wakeup), owner(owner) {}
+
+    const std::string authorFilter;  // Required author (empty = any)
+    const std::string titleFilter;   // Required title (empty = any)
+    SubscriberWakeup* const wakeup;  // Signalled when the queue becomes non-empty
+    void* const owner;               // The owning I/O loop's connection object
+
+    /// @brief True once unsubscribed (checked by the owner before touching owner)
+    bool closed() const { return isClosed.load(std::memory_order_acquire); }
+
+    bool matches(const PostView& post) const {
+        return (authorFilter.empty() || post.author == authorFilter) &&
+               (titleFilter.empty() || post.title == titleFilter);
+    }
+
+private:
+    friend class SubscriptionHub;
+    std::mutex mutex;                  // Guards the fields below (publisher vs owner)
+    std::vector<ResponseChunk> queue;  // Pushed posts not yet handed to the connection
+    bool signalled = false;            // Already in its wakeup's ready list
+    bool lagged = false;               // DROP policy: posts are being skipped
+    uint64_t firstMissed = 0;          // DROP policy: id of the first skipped post
+    bool overflowed = false;           // DISCONNECT policy: the queue overflowed
+    std::atomic<bool> isClosed{false};
+};
+
+/// @brief An eventfd plus the subscribers that have pushes waiting
+/// One per event-loop worker (or per connection in thread-per-client mode). The hub writes
+/// the eventfd only when the ready list goes from empty to non-empty, so a burst of posts
+/// costs the owning loop a single wakeup
+class SubscriberWakeup {
+public:
+    SubscriberWakeup() = default;
+    SubscriberWakeup(const SubscriberWakeup&) = delete;
+    SubscriberWakeup& operator=(const SubscriberWakeup&) = delete;
+    ~SubscriberWakeup() {
+        if (eventFd >= 0) ::close(eventFd);
+    }
+
+    /// @brief Creates the eventfd
+    bool open(std::string& errorDetails) {
+        eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (eventFd < 0) {
+            errorDetails = "eventfd failed: " + std::string(strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief The eventfd to poll for readability (its counter is only a doorbell)
+    int fd() const { return eventFd; }
+
+    /// @brief Resets the doorbell (for owners that read the eventfd themselves)
+    void clear() {
+        uint64_t value;
+        while (::read(eventFd, &value, sizeof(value)) < 0 && errno == EINTR) {}
+    }
+
+    /// @brief Takes the subscribers signalled since the last call (owning thread only)
+    /// Clear the doorbell first, so a signal racing with this call rings it again
+    std::vector<std::shared_ptr<Subscriber>> takeReady() {
+        std::vector<std::shared_ptr<Subscriber>> taken;
+        std::lock_guard<std::mutex> lock(mutex);
+        taken.swap(ready);
+        return taken;
+    }
+
+private:
+    friend class SubscriptionHub;
+
+    void signal(std::shared_ptr<Subscriber> subscriber) {
+        bool ring;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ring = ready.empty();
+            ready.push_back(std::move(subscriber));
+        }
+        if (ring) {
+            uint64_t one = 1;
+            while (::write(eventFd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+        }
+    }
+
+    int eventFd = -1;
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Subscriber>> ready;
+};
+
+/// @brief Pushes newly published posts to SUBSCRIBE'd connections
+///
+/// publish_posts() calls publish() from the board store's pre-publish hook, so pushes
+/// follow board order. Each post is serialized once and the same chunk is queued for
+/// every matching subscriber. Queues are bounded: the owning I/O loop only drains a
+/// subscriber when its connection has no unsent output, so a client that stops reading
+/// fills its queue and then falls under the slow-subscriber policy instead of growing
+/// server memory.
+class SubscriptionHub {
+public:
+    std::atomic<long> pushed{0};        // Posts queued for a subscriber
+    std::atomic<long> dropped{0};       // Posts skipped for lagging subscribers (DROP)
+    std::atomic<long> disconnected{0};  // Subscribers closed for overflowing (DISCONNECT)
+
+    /// @brief Outcome of SubscriptionHub::drain()
+    enum class Drain {
+        OK,         // Queued pushes (if any) were moved out
+        LAGGED,     // As OK, then posts from firstMissed on were skipped
+        OVERFLOWED  // DISCONNECT policy: close the connection
+    };
+
+    /// @brief Sets queue bound and slow-subscriber policy (before clients connect)
+    void configure(const SubscriptionOptions& newOptions) { options = newOptions; }
+
+    /// @brief Registers a subscriber; posts published after this returns are pushed to it
+    std::shared_ptr<Subscriber> subscribe(std::string_view authorFilter, std::string_view titleFilter,
+                                          SubscriberWakeup& wakeup, void* owner) {
+        auto subscriber = std::make_shared<Subscriber>(std::string(authorFilter), std::string(titleFilter), &wakeup, owner);
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        subscribers.push_back(subscriber);
+        return subscriber;
+    }
+
+    /// @brief Stops pushes to a subscriber; once this returns it is never signalled again
+    void unsubscribe(const std::shared_ptr<Subscriber>& subscriber) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        subscriber->isClosed.store(true, std::memory_order_release);
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), subscriber), subscribers.end());
+    }
+
+    /// @brief Number of active subscribers
+    size_t size() {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return subscribers.size();
+    }
+
+    /// @brief Queues posts [first, first + count) for every matching subscriber
+    /// @param viewAt Called as viewAt(id) -> PostView
+    /// @param encode Called as encode(post, id) -> std::string, at most once per post
+    template <typename ViewAt, typename Encode>
+    void publish(size_t first, size_t count, ViewAt&& viewAt, Encode&& encode) {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        if (subscribers.empty()) return;
+        for (size_t id = first; id < first + count; id++) {
+            PostView post = viewAt(id);
+            ResponseChunk chunk;
+            for (const std::shared_ptr<Subscriber>& subscriber : subscribers) {
+                if (!subscriber->matches(post)) continue;
+                if (chunk == nullptr) chunk = std::make_shared<const std::string>(encode(post, id));
+                push(subscriber, chunk, id);
+            }
+        }
+    }
+
+    /// @brief Moves a subscriber's queued pushes to out (owning thread only)
+    /// @param firstMissed Output for Drain::LAGGED: the first post id that was skipped
+    Drain drain(Subscriber& subscriber, std::vector<ResponseChunk>& out, uint64_t& firstMissed) {
+        std::lock_guard<std::mutex> lock(subscriber.mutex);
+        subscriber.signalled = false;
+        if (subscriber.overflowed) return Drain::OVERFLOWED;
+        out.insert(out.end(), subscriber.queue.begin(), subscriber.queue.end());
+        subscriber.queue.clear();
+        if (!subscriber.lagged) return Drain::OK;
+        subscriber.lagged = false;
+        firstMissed = subscriber.firstMissed;
+        return Drain::LAGGED;
+    }
+
+private:
+    void push(const std::shared_ptr<Subscriber>& subscriber, const ResponseChunk& chunk, uint64_t id) {
+        bool signal = false;
+        {
+            std::lock_guard<std::mutex> lock(subscriber->mutex);
+            if (subscriber->overflowed) return;
+            if (subscriber->lagged) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (subscriber->queue.size() >= options.queueLimit) {
+                if (options.policy == SlowSubscriberPolicy::DROP) {
+                    subscriber->lagged = true;
+                    subscriber->firstMissed = id;
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    subscriber->overflowed = true;
+                    disconnected.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else {
+                subscriber->queue.push_back(chunk);
+                pushed.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (!subscriber->signalled) {
+                subscriber->signalled = true;
+                signal = true;
+            }
+        }
+        if (signal) subscriber->wakeup->signal(subscriber);
+    }
+
+    std::shared_mutex mutex;  // Writers: subscribe/unsubscribe; readers: publish()
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    SubscriptionOptions options;
+};
@@ -2,6 +2,8 @@
 #include "catch2/catch.hpp"
 #include "../shared_state.h"
 #include "../server.cpp"  // Include server implementation
+#include "../latency_histogram.h"
+#include <random>        // Fuzz tests
 
 // ============================================================================
 // TEST SUITE: split_fields_until
@@ -62,6 +64,65 @@ TEST_CASE("split_fields_until - single field", "[split_fields_until]") {
     REQUIRE(fields[0] == "onlycommand");
 }
 
+/// @brief The two-pass split parse_message used to do: cut at the terminator, turn every
+/// "}#{" into "}+{", then split_fields_until
+static std::vector<std::string> reference_fields(const std::string& text) {
+    std::string replaced = text.substr(0, text.find("}}&{{"));
+    for (size_t pos = 0; (pos = replaced.find("}#{", pos)) != std::string::npos; pos += 3) {
+        replaced.replace(pos, 3, "}+{");
+    }
+    return split_fields_until(replaced, "}+{", replaced.size());
+}
+
+TEST_CASE("tokenize_fields - every scan kernel matches replace-then-split", "[split_fields_until]") {
+    // Single scan over all delimiters must give the fields the old two-pass parse produced
+    std::vector<std::string> samples = {
+        "POST}+{A}+{T}+{M}#{B}+{}+{N",
+        "}+{}#{}+{",
+        "GET_BOARD}+{a}b}+{c}#",
+        "}}+{x}#{}#{y}}",
+        "GET_BOARD}+{x}}&{{POST}+{tail",
+        "}}}&{{",
+        "",
+        "nodelims",
+    };
+    // Randomized inputs: a '}'-heavy alphabet of every length around the 16/32-byte block edges
+    std::mt19937 rng(2024);
+    const std::string alphabet = "}}}+#{&ab";
+    for (int i = 0; i < 3000; i++) {
+        std::string text(rng() % 100, ' ');
+        for (char& c : text) c = alphabet[rng() % alphabet.size()];
+        samples.push_back(text);
+    }
+
+    std::vector<std::string_view> views;
+    for (ScanKernel kernel : {ScanKernel::SCALAR, ScanKernel::SSE2, ScanKernel::AVX2}) {
+        if (!scan_kernel_supported(kernel)) continue;
+        DelimiterScanner scanner("}+{", "}#{", "}}&{{", kernel);
+        REQUIRE(scanner.kernel() == kernel);
+        DelimiterScanner terminatorOnly("", "", "}}&{{", kernel);
+        size_t fieldMismatches = 0, terminatorMismatches = 0;
+        for (const std::string& sample : samples) {
+            tokenize_fields(sample, scanner, views);
+            if (std::vector<std::string>(views.begin(), views.end()) != reference_fields(sample)) fieldMismatches++;
+
+            // Terminator search (as MessageFramer does it) from every offset, so each byte
+            // is seen in every block position
+            DelimiterKind kind;
+            for (size_t from = 0; from < sample.size(); from++) {
+                if (terminatorOnly.next(sample, from, kind) != sample.find("}}&{{", from)) terminatorMismatches++;
+            }
+        }
+        REQUIRE(fieldMismatches == 0);
+        REQUIRE(terminatorMismatches == 0);
+    }
+
+    // Delimiters that share no first byte take the find() path
+    DelimiterScanner custom("}+{", "<|>", "");
+    tokenize_fields("A}+{B<|>C}+{D", custom, views);
+    REQUIRE(std::vector<std::string>(views.begin(), views.end()) == std::vector<std::string>{"A", "B", "C", "D"});
+}
+
 // ============================================================================
 // TEST SUITE: parse_message
 // ============================================================================
@@ -99,6 +160,42 @@ TEST_CASE("parse_message - GET_BOARD with both filters", "[parse_message]") {
     REQUIRE(result.filter_title == "Tutorial");
 }
 
+TEST_CASE("parse_message - GET_BOARD with paging fields", "[parse_message]") {
+    auto result = parse_message("GET_BOARD}+{}+{}+{20}+{5}}&{{", "}+{", "}#{", "}}&{{");
+    REQUIRE(result.ok == true);
+    REQUIRE(result.paged == true);
+    REQUIRE(result.page_start == 20);
+    REQUIRE(result.page_limit == 5);
+
+    // ">id" asks for everything after the last seen id; a missing limit means no limit
+    result = parse_message("GET_BOARD}+{Bob}+{}+{>41}}&{{", "}+{", "}#{", "}}&{{");
+    REQUIRE(result.ok == true);
+    REQUIRE(result.filter_author == "Bob");
+    REQUIRE(result.page_start == 42);
+    REQUIRE(result.page_limit == 0);
+
+    REQUIRE(parse_message("GET_BOARD}+{Bob}+{Tutorial}}&{{", "}+{", "}#{", "}}&{{").paged == false);
+    REQUIRE(parse_message("GET_BOARD}+{}+{}+{-1}}&{{", "}+{", "}#{", "}}&{{").ok == false);
+    REQUIRE(parse_message("GET_BOARD}+{}+{}+{>}}&{{", "}+{", "}#{", "}}&{{").ok == false);
+    REQUIRE(parse_message("GET_BOARD}+{}+{}+{0}+{ten}}&{{", "}+{", "}#{", "}}&{{").ok == false);
+}
+
+TEST_CASE("parse_message - SEARCH fields and limit", "[parse_message]") {
+    auto result = parse_message("SEARCH}+{hello world}+{Bob}+{}+{typo}+{10}}&{{", "}+{", "}#{", "}}&{{");
+    REQUIRE(result.ok == true);
+    REQUIRE(result.clientCmd == CLIENT_COMMANDS::SEARCH);
+    REQUIRE(result.search_words == "hello world");
+    REQUIRE(result.filter_author == "Bob");
+    REQUIRE(result.filter_title.empty());
+    REQUIRE(result.search_message == "typo");
+    REQUIRE(result.page_limit == 10);
+
+    REQUIRE(parse_message("SEARCH}+{}+{}+{Tut}}&{{", "}+{", "}#{", "}}&{{").ok == true);
+    REQUIRE(parse_message("SEARCH}}&{{", "}+{", "}#{", "}}&{{").ok == false);
+    REQUIRE(parse_message("SEARCH}+{x}+{}+{}+{}+{ten}}&{{", "}+{", "}#{", "}}&{{").ok == false);
+    REQUIRE(parse_message("SEARCH}+{x}+{}+{}+{}+{1}+{extra}}&{{", "}+{", "}#{", "}}&{{").ok == false);
+}
+
 TEST_CASE("parse_message - POST with single post", "[parse_message]") {
     std::string msg = "POST}+{Alice}+{Hello}+{This is a message}}&{{";
     
@@ -198,6 +295,57 @@ TEST_CASE("parse_message - empty message", "[parse_message]") {
     REQUIRE(result.error.find("Empty message") != std::string::npos);
 }
 
+// ============================================================================
+// TEST SUITE: RequestArena
+// ============================================================================
+
+/// @brief Upstream resource that counts the blocks it hands out and gets back
+struct CountingResource : std::pmr::memory_resource {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    void* do_allocate(size_t bytes, size_t align) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        deallocations++;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST_CASE("RequestArena - parsed requests reuse the connection's block", "[RequestArena]") {
+    CountingResource upstream;
+    {
+        RequestArena arena(4096, &upstream);
+        std::string message = "POST}+{Alice Longname}+{A title that does not fit SSO}+{A message body that does not fit either"
+                              "}#{Bob}+{T}+{Second message}}&{{";
+        int parsedOk = 0;
+        for (int i = 0; i < 100; i++) {
+            arena.reset();
+            ParseResult result = parse_message(message, "}+{", "}#{", "}}&{{", arena.resource());
+            if (result.ok && result.posts.size() == 2 && result.posts[0].title == "A title that does not fit SSO" &&
+                result.posts[1].message == "Second message") parsedOk++;
+        }
+        REQUIRE(parsedOk == 100);
+        REQUIRE(upstream.allocations == 1);  // Only the block itself
+
+        // A batch larger than the block overflows upstream; reset() gives the overflow back
+        std::string batch = "POST";
+        for (int i = 0; i < 200; i++) batch += std::string(i == 0 ? "}+{" : "}#{") + "Author}+{Title}+{Message body number " + std::to_string(i);
+        batch += "}}&{{";
+        arena.reset();
+        {
+            ParseResult result = parse_message(batch, "}+{", "}#{", "}}&{{", arena.resource());
+            REQUIRE(result.posts.size() == 200);
+        }
+        REQUIRE(upstream.allocations > 1);
+        arena.reset();
+        REQUIRE(upstream.allocations - upstream.deallocations == 1);
+    }
+    REQUIRE(upstream.allocations == upstream.deallocations);
+}
+
 // ============================================================================
 // TEST SUITE: build_post_error
 // ============================================================================
@@ -257,9 +405,34 @@ TEST_CASE("post_handler - adds single post to message board", "[post_handler]")
     REQUIRE(success == true);
     REQUIRE(errorDetails == "");
     REQUIRE(g_serverState.messageBoard.size() == 1);
-    REQUIRE(g_serverState.messageBoard[0].author == "Alice");
-    REQUIRE(g_serverState.messageBoard[0].title == "Title1");
-    REQUIRE(g_serverState.messageBoard[0].message == "Message1");
+    REQUIRE(g_serverState.messageBoard.at(0).author == "Alice");
+    REQUIRE(g_serverState.messageBoard.at(0).title == "Title1");
+    REQUIRE(g_serverState.messageBoard.at(0).message == "Message1");
+}
+
+TEST_CASE("post_handler - rejects a batch past --max-posts with POST_ERROR and stores none of it", "[post_handler]") {
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.setCapacity(3);
+
+    ParseResult parsed;
+    parsed.ok = true;
+    parsed.clientCmd = CLIENT_COMMANDS::POST;
+    parsed.posts.push_back({"Alice", "Title1", "Message1"});
+    parsed.posts.push_back({"Bob", "Title2", "Message2"});
+
+    std::string errorDetails;
+    REQUIRE(post_handler(parsed, errorDetails, 999));
+    REQUIRE_FALSE(post_handler(parsed, errorDetails, 999));  // 4 > 3: the whole batch is refused
+    REQUIRE(errorDetails.find("message board is full") != std::string::npos);
+    REQUIRE(g_serverState.messageBoard.size() == 2);
+
+    std::string reply = build_client_response(parsed, -1, 999).flatten();
+    REQUIRE(reply.find("POST_ERROR") == 0);
+    REQUIRE(reply.find("full") != std::string::npos);
+
+    g_serverState.messageBoard.setCapacity(BoardStore::MAX_POSTS);
+    REQUIRE(post_handler(parsed, errorDetails, 999));
+    REQUIRE(g_serverState.messageBoard.size() == 4);
 }
 
 TEST_CASE("post_handler - adds multiple posts to message board", "[post_handler]") {
@@ -277,9 +450,9 @@ TEST_CASE("post_handler - adds multiple posts to message board", "[post_handler]
     
     REQUIRE(success == true);
     REQUIRE(g_serverState.messageBoard.size() == 3);
-    REQUIRE(g_serverState.messageBoard[0].author == "Alice");
-    REQUIRE(g_serverState.messageBoard[1].author == "Bob");
-    REQUIRE(g_serverState.messageBoard[2].author == "Charlie");
+    REQUIRE(g_serverState.messageBoard.at(0).author == "Alice");
+    REQUIRE(g_serverState.messageBoard.at(1).author == "Bob");
+    REQUIRE(g_serverState.messageBoard.at(2).author == "Charlie");
 }
 
 TEST_CASE("post_handler - error when no posts provided", "[post_handler]") {
@@ -311,9 +484,9 @@ TEST_CASE("post_handler - handles anonymous posts", "[post_handler]") {
     
     REQUIRE(success == true);
     REQUIRE(g_serverState.messageBoard.size() == 1);
-    REQUIRE(g_serverState.messageBoard[0].author == "");
-    REQUIRE(g_serverState.messageBoard[0].title == "");
-    REQUIRE(g_serverState.messageBoard[0].message == "Anonymous message");
+    REQUIRE(g_serverState.messageBoard.at(0).author == "");
+    REQUIRE(g_serverState.messageBoard.at(0).title == "");
+    REQUIRE(g_serverState.messageBoard.at(0).message == "Anonymous message");
 }
 
 // ============================================================================
@@ -332,8 +505,8 @@ TEST_CASE("get_board_handler - returns empty board", "[get_board_handler]") {
 
 TEST_CASE("get_board_handler - returns all posts with no filter", "[get_board_handler]") {
     g_serverState.messageBoard.clear();
-    g_serverState.messageBoard.push_back({"Alice", "Title1", "Message1"});
-    g_serverState.messageBoard.push_back({"Bob", "Title2", "Message2"});
+    g_serverState.messageBoard.append(Post{"Alice", "Title1", "Message1"});
+    g_serverState.messageBoard.append(Post{"Bob", "Title2", "Message2"});
     
     std::string response = get_board_handler("", "");
     
@@ -347,9 +520,9 @@ TEST_CASE("get_board_handler - returns all posts with no filter", "[get_board_ha
 
 TEST_CASE("get_board_handler - filters by author", "[get_board_handler]") {
     g_serverState.messageBoard.clear();
-    g_serverState.messageBoard.push_back({"Alice", "Title1", "Message1"});
-    g_serverState.messageBoard.push_back({"Bob", "Title2", "Message2"});
-    g_serverState.messageBoard.push_back({"Alice", "Title3", "Message3"});
+    g_serverState.messageBoard.append(Post{"Alice", "Title1", "Message1"});
+    g_serverState.messageBoard.append(Post{"Bob", "Title2", "Message2"});
+    g_serverState.messageBoard.append(Post{"Alice", "Title3", "Message3"});
     
     std::string response = get_board_handler("Alice", "");
     
@@ -362,9 +535,9 @@ TEST_CASE("get_board_handler - filters by author", "[get_board_handler]") {
 
 TEST_CASE("get_board_handler - filters by title", "[get_board_handler]") {
     g_serverState.messageBoard.clear();
-    g_serverState.messageBoard.push_back({"Alice", "Tutorial", "Message1"});
-    g_serverState.messageBoard.push_back({"Bob", "News", "Message2"});
-    g_serverState.messageBoard.push_back({"Charlie", "Tutorial", "Message3"});
+    g_serverState.messageBoard.append(Post{"Alice", "Tutorial", "Message1"});
+    g_serverState.messageBoard.append(Post{"Bob", "News", "Message2"});
+    g_serverState.messageBoard.append(Post{"Charlie", "Tutorial", "Message3"});
     
     std::string response = get_board_handler("", "Tutorial");
     
@@ -377,9 +550,9 @@ TEST_CASE("get_board_handler - filters by title", "[get_board_handler]") {
 
 TEST_CASE("get_board_handler - filters by both author and title", "[get_board_handler]") {
     g_serverState.messageBoard.clear();
-    g_serverState.messageBoard.push_back({"Alice", "Tutorial", "Message1"});
-    g_serverState.messageBoard.push_back({"Alice", "News", "Message2"});
-    g_serverState.messageBoard.push_back({"Bob", "Tutorial", "Message3"});
+    g_serverState.messageBoard.append(Post{"Alice", "Tutorial", "Message1"});
+    g_serverState.messageBoard.append(Post{"Alice", "News", "Message2"});
+    g_serverState.messageBoard.append(Post{"Bob", "Tutorial", "Message3"});
     
     std::string response = get_board_handler("Alice", "Tutorial");
     
@@ -393,8 +566,8 @@ TEST_CASE("get_board_handler - filters by both author and title", "[get_board_ha
 
 TEST_CASE("get_board_handler - multiple posts use message separator", "[get_board_handler]") {
     g_serverState.messageBoard.clear();
-    g_serverState.messageBoard.push_back({"Alice", "Title1", "Message1"});
-    g_serverState.messageBoard.push_back({"Bob", "Title2", "Message2"});
+    g_serverState.messageBoard.append(Post{"Alice", "Title1", "Message1"});
+    g_serverState.messageBoard.append(Post{"Bob", "Title2", "Message2"});
     
     std::string response = get_board_handler("", "");
     
@@ -404,11 +577,1553 @@ TEST_CASE("get_board_handler - multiple posts use message separator", "[get_boar
 
 TEST_CASE("get_board_handler - no match returns empty board", "[get_board_handler]") {
     g_serverState.messageBoard.clear();
-    g_serverState.messageBoard.push_back({"Alice", "Title1", "Message1"});
+    g_serverState.messageBoard.append(Post{"Alice", "Title1", "Message1"});
     
     std::string response = get_board_handler("Bob", "");  // No Bob posts
     
     REQUIRE(response.find("GET_BOARD") != std::string::npos);
     REQUIRE(response.find("Alice") == std::string::npos);  // Alice filtered out
     REQUIRE(response.find("}}&{{") != std::string::npos);  // Still has terminator
-}
\ No newline at end of file
+}
+
+TEST_CASE("get_board_handler - filters use the author/title index and follow a cleared board", "[get_board_handler]") {
+    g_serverState.messageBoard.clear();
+    for (int i = 0; i < 300; i++) {
+        g_serverState.messageBoard.append(Post{"user" + std::to_string(i % 3), "Topic" + std::to_string(i % 5),
+                                               "M" + std::to_string(i)});
+    }
+    std::string error;
+    REQUIRE(publish_posts({Post{"user1", "Topic2", "Published"}}, error));
+
+    // user1 posts are i % 3 == 1, Topic2 posts are i % 5 == 2: intersection is i % 15 == 7
+    std::vector<uint32_t> ids = g_serverState.boardIndex.lookup(g_serverState.messageBoard,
+                                                                 g_serverState.messageBoard.size(), "user1", "Topic2");
+    REQUIRE(ids.size() == 21);
+    REQUIRE(ids.front() == 7);
+    REQUIRE(ids[19] == 292);
+    REQUIRE(ids.back() == 300);
+    REQUIRE(g_serverState.boardIndex.lookup(g_serverState.messageBoard, 300, "user1", "").size() == 100);
+
+    // Same authors after clear() must not return stale ids
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"user1", "Other", "Fresh"});
+    REQUIRE(get_board_handler("user1", "") == "GET_BOARD}+{user1}+{Other}+{Fresh}}&{{");
+    REQUIRE(get_board_handler("user1", "Topic2") == "GET_BOARD}}&{{");
+}
+
+TEST_CASE("get_board_page_handler - windows, continuation tokens and filters", "[get_board_handler]") {
+    g_serverState.messageBoard.clear();
+    for (int i = 0; i < 5; i++) {
+        g_serverState.messageBoard.append(Post{i % 2 == 0 ? "Alice" : "Bob", "T", "M" + std::to_string(i)});
+    }
+
+    REQUIRE(get_board_page_handler("", "", 0, 2) == "GET_BOARD_PAGE}+{2}+{Alice}+{T}+{M0}#{}+{Bob}+{T}+{M1}}&{{");
+    REQUIRE(get_board_page_handler("", "", 2, 0) ==
+            "GET_BOARD_PAGE}+{5}+{Alice}+{T}+{M2}#{}+{Bob}+{T}+{M3}#{}+{Alice}+{T}+{M4}}&{{");
+    REQUIRE(get_board_page_handler("", "", 5, 10) == "GET_BOARD_PAGE}+{5}}&{{");
+    REQUIRE(get_board_page_handler("", "", 99, 10) == "GET_BOARD_PAGE}+{5}}&{{");  // Stale token resumes at the end
+
+    // Filtered pages resume right after the last returned match
+    REQUIRE(get_board_page_handler("Alice", "", 0, 2) == "GET_BOARD_PAGE}+{3}+{Alice}+{T}+{M0}#{}+{Alice}+{T}+{M2}}&{{");
+    REQUIRE(get_board_page_handler("Alice", "", 3, 2) == "GET_BOARD_PAGE}+{5}+{Alice}+{T}+{M4}}&{{");
+
+    // Polling with the last token returns only posts published since
+    std::string error;
+    REQUIRE(publish_posts({Post{"Bob", "T", "M5"}}, error));
+    REQUIRE(get_board_page_handler("Bob", "", 5, 0) == "GET_BOARD_PAGE}+{6}+{Bob}+{T}+{M5}}&{{");
+    g_serverState.messageBoard.clear();
+}
+
+TEST_CASE("SearchIndex - words and substrings match a full scan", "[SearchIndex]") {
+    g_serverState.messageBoard.clear();
+    // Part of the board bypasses publish_posts, so search() has to catch up on it
+    std::mt19937 rng(7);
+    const char* vocabulary[] = {"apple", "Banana", "cherry", "date", "elder", "fig", "grape"};
+    auto make_post = [&](int i) {
+        std::string message;
+        for (int w = 0; w < 4; w++) message += std::string(vocabulary[rng() % 7]) + (w < 3 ? " " : "!");
+        return Post{"writer" + std::to_string(i % 11), "thread " + std::to_string(i % 6), message};
+    };
+    for (int i = 0; i < 1500; i++) g_serverState.messageBoard.append(make_post(i));
+    std::string error;
+    std::vector<Post> batch;
+    for (int i = 1500; i < 2000; i++) batch.push_back(make_post(i));
+    REQUIRE(publish_posts(std::move(batch), error));
+
+    auto contains_word = [](std::string_view text, std::string_view word) {
+        bool found = false;
+        std::string scratch;
+        SearchIndex::forEachWord(text, scratch, [&](const std::string& w) { found = found || w == word; });
+        return found;
+    };
+    auto scan = [&](const SearchQuery& query) {
+        std::vector<uint32_t> ids;
+        for (size_t id = g_serverState.messageBoard.size(); id-- > 0 && ids.size() < query.limit;) {
+            PostView post = g_serverState.messageBoard.at(id);
+            bool ok = post.author.find(query.author) != std::string_view::npos &&
+                      post.title.find(query.title) != std::string_view::npos &&
+                      post.message.find(query.message) != std::string_view::npos;
+            std::string scratch;
+            SearchIndex::forEachWord(query.words, scratch, [&](const std::string& w) {
+                ok = ok && (contains_word(post.author, w) || contains_word(post.title, w) || contains_word(post.message, w));
+            });
+            if (ok) ids.push_back((uint32_t)id);
+        }
+        return ids;
+    };
+    const SearchQuery queries[] = {
+        {"banana", "", "", "", SIZE_MAX},
+        {"APPLE fig", "", "", "", SIZE_MAX},
+        {"", "writer1", "", "", SIZE_MAX},     // writer1, writer10
+        {"", "writer", "", "", SIZE_MAX},      // Every post: several candidate batches
+        {"thread", "", "", "e!", SIZE_MAX},     // Word list driver, several candidate batches
+        {"", "r", "d 3", "", SIZE_MAX},         // Short author substring, title trigram
+        {"", "", "", "rry fig", SIZE_MAX},
+        {"", "", "", "e!", 25},                 // Shorter than a trigram: checked post by post
+        {"grape", "writer", "thread 5", "apple", 10},
+        {"kiwi", "", "", "", SIZE_MAX},
+        {"", "", "", "zzz", SIZE_MAX},
+        {"thread", "", "", "", 3},
+    };
+    int mismatches = 0;
+    size_t matched = 0;
+    for (const SearchQuery& query : queries) {
+        std::vector<uint32_t> expected = scan(query);
+        matched += expected.size();
+        mismatches += g_serverState.searchIndex.search(g_serverState.messageBoard, g_serverState.boardIndex,
+                                                       g_serverState.messageBoard.size(), query) != expected;
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(matched > 1000);
+
+    // The reply is newest first and carries each post's id
+    g_serverState.messageBoard.clear();
+    REQUIRE(publish_posts({Post{"Alice", "T", "red apple"}, Post{"Bob", "T", "green apple"}, Post{"Carol", "T", "pear"}}, error));
+    SearchQuery query;
+    query.words = "Apple";
+    REQUIRE(search_handler(query) == "SEARCH_RESULT}+{1}+{Bob}+{T}+{green apple}#{}+{0}+{Alice}+{T}+{red apple}}&{{");
+    query.words = "plum";
+    REQUIRE(search_handler(query) == "SEARCH_RESULT}}&{{");
+
+    // With nothing to narrow on, only the newest posts are checked
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"A", "T", "hi"});
+    for (size_t i = 0; i < SearchIndex::UNINDEXED_SCAN_LIMIT; i++) g_serverState.messageBoard.append(Post{"A", "T", "x"});
+    g_serverState.messageBoard.append(Post{"A", "T", "hi"});
+    query = SearchQuery();
+    query.message = "hi";
+    REQUIRE(search_handler(query) == "SEARCH_RESULT}+{" + std::to_string(SearchIndex::UNINDEXED_SCAN_LIMIT + 1) +
+                                         "}+{A}+{T}+{hi}}&{{");
+    g_serverState.messageBoard.clear();
+}
+
+TEST_CASE("SubscriptionHub - filters, shares chunks and applies the slow-subscriber policy", "[SubscriptionHub]") {
+    std::vector<Post> posts = {Post{"Alice", "T", "M0"}, Post{"Bob", "T", "M1"}, Post{"Alice", "T", "M2"},
+                               Post{"Alice", "T", "M3"}, Post{"Alice", "T", "M4"}};
+    auto viewAt = [&](size_t id) { return PostView(posts[id]); };
+    auto encode = [](const PostView& post, uint64_t id) { return std::to_string(id) + std::string(post.message); };
+    std::string error;
+    SubscriberWakeup wakeup;
+    REQUIRE(wakeup.open(error));
+
+    SubscriptionHub hub;
+    hub.configure(SubscriptionOptions{2, SlowSubscriberPolicy::DROP});
+    auto alice = hub.subscribe("Alice", "", wakeup, nullptr);
+    auto everyone = hub.subscribe("", "", wakeup, nullptr);
+    hub.publish(0, 2, viewAt, encode);
+
+    // Both became ready once; the Alice post is one chunk shared by both queues
+    REQUIRE(wakeup.takeReady().size() == 2);
+    std::vector<ResponseChunk> a, e;
+    uint64_t firstMissed = 0;
+    REQUIRE(hub.drain(*alice, a, firstMissed) == SubscriptionHub::Drain::OK);
+    REQUIRE(hub.drain(*everyone, e, firstMissed) == SubscriptionHub::Drain::OK);
+    REQUIRE(a.size() == 1);
+    REQUIRE(*a[0] == "0M0");
+    REQUIRE(e.size() == 2);
+    REQUIRE(e[0] == a[0]);
+
+    // DROP: a full queue skips posts and reports the first one it missed
+    hub.publish(2, 3, viewAt, encode);
+    a.clear();
+    REQUIRE(hub.drain(*alice, a, firstMissed) == SubscriptionHub::Drain::LAGGED);
+    REQUIRE(a.size() == 2);
+    REQUIRE(firstMissed == 4);
+    REQUIRE(hub.dropped == 2);  // Post 4 for both subscribers
+
+    // DISCONNECT: overflowing closes instead; unsubscribed subscribers get nothing
+    hub.configure(SubscriptionOptions{1, SlowSubscriberPolicy::DISCONNECT});
+    hub.unsubscribe(everyone);
+    REQUIRE(everyone->closed());
+    hub.publish(2, 2, viewAt, encode);
+    REQUIRE(hub.drain(*alice, a, firstMissed) == SubscriptionHub::Drain::OVERFLOWED);
+    REQUIRE(hub.disconnected == 1);
+    REQUIRE(hub.size() == 1);
+}
+
+TEST_CASE("cached_board_response - matches get_board_handler and extends after POSTs", "[ResponseCache]") {
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"Alice", "Tutorial", "Message1"});
+    g_serverState.messageBoard.append(Post{"Bob", "News", "Message2"});
+    ResponseCache& cache = g_serverState.responseCache;
+    long hits = cache.hits, extensions = cache.extensions, misses = cache.misses;
+
+    auto first = cached_board_response("", "");
+    REQUIRE(first->flatten() == get_board_handler("", ""));
+    REQUIRE(cached_board_response("", "") == first);  // Unchanged board: same shared response
+    REQUIRE(cached_board_response("Alice", "")->flatten() == get_board_handler("Alice", ""));
+
+    // Appending extends the cached bytes; earlier chunks stay shared with the old response
+    std::string error;
+    REQUIRE(publish_posts({Post{"Alice", "News", "Message3"}}, error));
+    auto second = cached_board_response("", "");
+    REQUIRE(second->flatten() == get_board_handler("", ""));
+    REQUIRE(second->chunks.front() == first->chunks.front());
+    REQUIRE(second->chunks[1] == first->chunks[1]);  // The new post is a chunk of its own
+    REQUIRE(second->chunks.size() == first->chunks.size() + 1);
+    REQUIRE(first->flatten().find("Message3") == std::string::npos);
+    REQUIRE(cached_board_response("Alice", "")->flatten() == get_board_handler("Alice", ""));
+    REQUIRE(cached_board_response("Alice", "News")->flatten() == get_board_handler("Alice", "News"));
+    REQUIRE(cached_board_response("Nobody", "")->flatten() == "GET_BOARD}}&{{");
+
+    REQUIRE(cache.hits - hits == 1);
+    REQUIRE(cache.extensions - extensions == 2);
+    REQUIRE(cache.misses - misses == 4);
+    g_serverState.messageBoard.clear();
+}
+
+TEST_CASE("ResponseCache - one-post extensions merge small chunks only past MERGE_CHUNKS", "[ResponseCache]") {
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"Alice", "Title0", "Message0"});
+    auto previous = cached_board_response("", "");
+
+    size_t mostChunks = 0;
+    for (size_t i = 1; i <= ResponseCache::MERGE_CHUNKS * 3; i++) {
+        g_serverState.messageBoard.append(Post{"Alice", "Title" + std::to_string(i), "Message" + std::to_string(i)});
+        auto response = cached_board_response("", "");
+        mostChunks = std::max(mostChunks, response->chunks.size());
+        if (response->chunks.size() > previous->chunks.size()) {
+            // Plain extension: every earlier body chunk is shared, not copied
+            REQUIRE(response->chunks[1] == previous->chunks[1]);
+        }
+        previous = response;
+    }
+    REQUIRE(previous->flatten() == get_board_handler("", ""));
+    REQUIRE(mostChunks <= ResponseCache::MERGE_CHUNKS + 3);  // Head, body chunks, tail
+    g_serverState.messageBoard.clear();
+}
+
+// ============================================================================
+// TEST SUITE: BoardStore
+// ============================================================================
+
+TEST_CASE("BoardStore - appends across segments and keeps references stable", "[BoardStore]") {
+    BoardStore store;
+    REQUIRE(store.empty());
+
+    REQUIRE(store.append(Post{"Alice", "First", "Message0"}) == 0);
+    const char* firstAuthor = store.at(0).author.data();
+
+    // Fill well past one segment; the first post must not move
+    std::vector<Post> batch;
+    for (size_t i = 1; i < BoardStore::SEGMENT_SIZE * 2 + 5; i++) {
+        batch.push_back(Post{"Bob", "Title" + std::to_string(i), "Message" + std::to_string(i)});
+    }
+    REQUIRE(store.append(std::move(batch)) == 1);
+    REQUIRE(store.size() == BoardStore::SEGMENT_SIZE * 2 + 5);
+    REQUIRE(store.at(0).author.data() == firstAuthor);
+    REQUIRE(store.at(BoardStore::SEGMENT_SIZE + 3).title == "Title" + std::to_string(BoardStore::SEGMENT_SIZE + 3));
+
+    size_t visited = 0;
+    store.forEach([&](const PostView&) { visited++; });
+    REQUIRE(visited == store.size());
+
+    store.clear();
+    REQUIRE(store.size() == 0);
+}
+
+TEST_CASE("BoardStore - readers never see a partial batch while a writer appends", "[BoardStore]") {
+    BoardStore store;
+    const int batches = 2000;
+    const size_t batchSize = 3;
+    std::atomic<bool> done{false};
+
+    // Reader walks concurrently; published length must always be a whole number of batches
+    bool consistent = true;
+    std::thread reader([&] {
+        while (!done) {
+            size_t count = store.size();
+            if (count % batchSize != 0) consistent = false;
+            for (size_t i = 0; i < count; i++) {
+                if (store.at(i).message != "Message" + std::to_string(i / batchSize)) consistent = false;
+            }
+        }
+    });
+
+    for (int b = 0; b < batches; b++) {
+        std::vector<Post> batch;
+        for (size_t i = 0; i < batchSize; i++) {
+            batch.push_back(Post{"Writer", "Batch", "Message" + std::to_string(b)});
+        }
+        store.append(std::move(batch));
+    }
+    done = true;
+    reader.join();
+
+    REQUIRE(consistent);
+    REQUIRE(store.size() == batches * batchSize);
+}
+
+// ============================================================================
+// TEST SUITE: StringPool
+// ============================================================================
+
+TEST_CASE("StringPool - concurrent interning agrees on one id per string", "[StringPool]") {
+    StringPool pool;
+    const int threads = 4, names = 2000;
+    std::vector<std::vector<uint32_t>> ids(threads, std::vector<uint32_t>(names));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            // Every thread interns the same names in a different order
+            for (int i = 0; i < names; i++) {
+                int n = (i * 7919 + t * 500) % names;
+                ids[t][n] = pool.intern("name " + std::to_string(n) + std::string(n % 40, 'x'));
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    int mismatches = 0;
+    for (int n = 0; n < names; n++) {
+        std::string name = "name " + std::to_string(n) + std::string(n % 40, 'x');
+        for (int t = 1; t < threads; t++) mismatches += ids[t][n] != ids[0][n];
+        mismatches += pool.view(ids[0][n]) != name || pool.find(name) != ids[0][n];
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(pool.size() == (size_t)names);
+
+    // find() never adds
+    REQUIRE(pool.find("unknown") == NO_STRING_ID);
+    REQUIRE(pool.size() == (size_t)names);
+}
+
+TEST_CASE("BoardStore - stores authors and titles as interned ids", "[BoardStore][StringPool]") {
+    BoardStore store;
+    store.append(std::vector<Post>{Post{"Alice", "News", "One"}, Post{"Bob", "News", "Two"}, Post{"Alice", "Other", "Three"}});
+    REQUIRE(store.at(0).authorId == store.at(2).authorId);
+    REQUIRE(store.at(0).authorId != store.at(1).authorId);
+    REQUIRE(store.at(0).titleId == store.at(1).titleId);
+    REQUIRE(store.at(2).author == "Alice");
+    REQUIRE(store.at(2).title == "Other");
+    REQUIRE(store.at(2).message == "Three");
+    REQUIRE(store.names().size() == 4);  // Alice, News, Bob, Other
+}
+
+TEST_CASE("BoardStore - column select matches a row-by-row filter", "[BoardStore]") {
+    BoardStore store;
+    // A few messages are too long to share a blob chunk
+    auto message = [](size_t i) { return std::string(i % 500 == 7 ? 300000 : i % 5, 'x') + std::to_string(i); };
+    std::vector<Post> batch;
+    for (int i = 0; i < 2500; i++) {  // Crosses segment boundaries
+        batch.push_back(Post{"Author " + std::to_string(i % 13), "Title " + std::to_string(i % 7), message(i), i});
+    }
+    store.append(std::move(batch));
+
+    auto authorOk = [](std::string_view author) { return author.find('1') != std::string_view::npos; };
+    auto titleOk = [](std::string_view title) { return title.find('3') == std::string_view::npos; };
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < store.size(); i++) {
+        PostView post = store.at(i);
+        if (authorOk(post.author) && titleOk(post.title)) expected.push_back((uint32_t)i);
+    }
+    REQUIRE(!expected.empty());
+    REQUIRE(store.select(0, store.size(), authorOk, titleOk) == expected);
+    REQUIRE(store.select(1000, 1010, authorOk, titleOk).size() ==
+            (size_t)std::count_if(expected.begin(), expected.end(), [](uint32_t i) { return i >= 1000 && i < 1010; }));
+
+    int wrong = 0;
+    for (size_t i = 0; i < store.size(); i++) {
+        wrong += store.at(i).message != message(i);
+        wrong += store.at(i).clientId != (int)i;
+    }
+    REQUIRE(wrong == 0);
+}
+
+// ============================================================================
+// TEST SUITE: PostLog (write-ahead log)
+// ============================================================================
+
+/// @brief Deletes every segment of a test post log
+static void remove_post_log(const std::string& basePath) {
+    for (const PostLogSegment& segment : PostLog::listSegments(basePath)) {
+        unlink(segment.path.c_str());
+    }
+}
+
+/// @brief Returns g_serverState.postLog to its never-opened state (posts kept in memory only)
+/// A closed log refuses POSTs, so tests that stop it reset it for the tests that follow
+static void reset_post_log() {
+    std::string error;
+    g_serverState.postLog.open("", 0, PostLogOptions{LogDurability::NONE}, error);
+}
+
+TEST_CASE("PostLog - replay returns records and cuts a torn tail", "[PostLog]") {
+    std::string base = "/tmp/server_test_postlog_" + std::to_string(getpid()) + ".wal";
+    std::string path = PostLog::segmentPath(base, 0);
+    std::string encoded;
+    PostLog::encodeRecord(0, Post{"Alice", "Title1", "Message1", 7}, encoded);
+    PostLog::encodeRecord(1, Post{"Bob", "", "Message2", 8}, encoded);
+    size_t intact = encoded.size();
+    PostLog::encodeRecord(2, Post{"Carol", "Title3", "Message3", 9}, encoded);
+    encoded.resize(encoded.size() - 3);  // Crash mid-write
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << encoded;
+    }
+
+    std::vector<std::pair<uint64_t, Post>> records;
+    std::string error;
+    REQUIRE(PostLog::replay(base, [&](uint64_t sequence, Post&& post) {
+        records.emplace_back(sequence, std::move(post));
+    }, error));
+
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].first == 0);
+    REQUIRE(records[0].second.author == "Alice");
+    REQUIRE(records[0].second.clientId == 7);
+    REQUIRE(records[1].first == 1);
+    REQUIRE(records[1].second.title.empty());
+    struct stat info;
+    REQUIRE(stat(path.c_str(), &info) == 0);
+    REQUIRE((size_t)info.st_size == intact);
+    remove_post_log(base);
+}
+
+TEST_CASE("start_post_log - logged posts survive a restart on top of the snapshot", "[PostLog]") {
+    std::string path = "/tmp/server_test_restart_" + std::to_string(getpid()) + ".wal";
+    remove_post_log(path);
+    ServerConfig config;
+    config.postLogPath = path;
+    config.postLog.durability = LogDurability::WRITE;
+    std::string error;
+
+    // First run: one post from the snapshot, then two logged POST batches from concurrent clients
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"Snapshot", "Saved", "Already in MessageBoard.board"});
+    REQUIRE(start_post_log(config, error));
+    std::thread other([] {
+        std::string otherError;
+        publish_posts({Post{"Bob", "Title2", "Message2"}}, otherError);
+    });
+    REQUIRE(publish_posts({Post{"Alice", "Title1", "Message1"}}, error));
+    other.join();
+    stop_post_log();
+    std::vector<std::string> before;
+    g_serverState.messageBoard.forEach([&](const PostView& post) { before.emplace_back(post.author); });
+
+    // Once the log is closed (shutdown) a POST is refused, never acknowledged without a record
+    REQUIRE_FALSE(publish_posts({Post{"Late", "Title3", "Message3"}}, error));
+    REQUIRE(error.find("post log is closed") != std::string::npos);
+    REQUIRE(g_serverState.messageBoard.size() == 3);
+
+    // Restart from the same snapshot: the log supplies everything after it, in board order
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"Snapshot", "Saved", "Already in MessageBoard.board"});
+    REQUIRE(start_post_log(config, error));
+    stop_post_log();
+    std::vector<std::string> after;
+    g_serverState.messageBoard.forEach([&](const PostView& post) { after.emplace_back(post.author); });
+
+    REQUIRE(before.size() == 3);
+    REQUIRE(after == before);
+    g_serverState.messageBoard.clear();
+    reset_post_log();
+    remove_post_log(path);
+}
+
+TEST_CASE("PostLog - a failed group commit stops the log accepting posts", "[PostLog]") {
+    std::string dir = "/tmp/server_test_failing_" + std::to_string(getpid());
+    REQUIRE(mkdir(dir.c_str(), 0755) == 0);
+    ServerConfig config;
+    config.postLogPath = dir + "/board.wal";
+    config.postLog.durability = LogDurability::WRITE;
+    config.postLog.segmentBytes = 1;  // The second group commit rolls over to a new segment
+    std::string error;
+    g_serverState.messageBoard.clear();
+    REQUIRE(start_post_log(config, error));
+    REQUIRE(publish_posts({Post{"Alice", "Title1", "Message1"}}, error));
+
+    // The rollover cannot create its segment once the directory is gone
+    remove_post_log(config.postLogPath);
+    REQUIRE(rmdir(dir.c_str()) == 0);
+    REQUIRE_FALSE(publish_posts({Post{"Bob", "Title2", "Message2"}}, error));
+    REQUIRE(error.find("Failed to persist post") == 0);
+    uint64_t commits = g_serverState.postLog.commitCount();
+
+    // Sticky: later POSTs are refused before they reach the board or the log
+    error.clear();
+    REQUIRE_FALSE(publish_posts({Post{"Carol", "Title3", "Message3"}}, error));
+    REQUIRE(error.find("post log failed earlier") != std::string::npos);
+    REQUIRE(g_serverState.messageBoard.size() == 2);
+    REQUIRE(g_serverState.postLog.commitCount() == commits);
+    std::string settleError;
+    REQUIRE(g_serverState.postLog.settle(2, -1, settleError) == TicketState::FAILED);  // Bob's ticket
+
+    stop_post_log();
+    reset_post_log();
+    g_serverState.messageBoard.clear();
+}
+
+TEST_CASE("saveToFile - incremental snapshot compacts the log and restart replays only the tail", "[PostLog]") {
+    std::string prefix = "/tmp/server_test_snapshot_" + std::to_string(getpid());
+    std::string snapshot = prefix + ".board";
+    std::string savedSnapshotPath = g_serverState.config.snapshotPath;
+    std::string savedLegacyPath = g_serverState.config.legacyBoardPath;
+    g_serverState.config.snapshotPath = snapshot;
+    g_serverState.config.legacyBoardPath = prefix + ".missing.txt";
+    unlink(snapshot.c_str());
+    ServerConfig config;
+    config.postLogPath = prefix + ".wal";
+    config.postLog.durability = LogDurability::WRITE;
+    config.postLog.segmentBytes = 1;  // Every group commit starts a new segment
+    config.snapshotIntervalSec = 0;
+    remove_post_log(config.postLogPath);
+    std::string error;
+
+    g_serverState.messageBoard.clear();
+    g_serverState.loadFromFile();
+    REQUIRE(start_post_log(config, error));
+    REQUIRE(publish_posts({Post{"Alice", "a|b", "line1\nline2 \\ end", 3}}, error));
+    REQUIRE(publish_posts({Post{"Bob", "Title2", "Message2", 4}}, error));
+    REQUIRE(publish_posts({Post{"Carol", "Title3", "Message3", 5}}, error));
+    REQUIRE(PostLog::listSegments(config.postLogPath).size() == 3);
+
+    // The snapshot covers all three posts, so only the newest segment is kept
+    REQUIRE(g_serverState.saveToFile());
+    REQUIRE(PostLog::listSegments(config.postLogPath).size() == 1);
+    REQUIRE(publish_posts({Post{"Dave", "Title4", "Message4", 6}}, error));
+    REQUIRE(g_serverState.saveToFile());  // Appends only Dave
+    REQUIRE(publish_posts({Post{"Erin", "Title5", "Message5", 7}}, error));
+    stop_post_log();
+
+    // Restart: four posts come from the snapshot, Erin from the log tail
+    g_serverState.messageBoard.clear();
+    g_serverState.loadFromFile();
+    REQUIRE(g_serverState.messageBoard.size() == 4);
+    REQUIRE(start_post_log(config, error));
+    stop_post_log();
+
+    REQUIRE(g_serverState.messageBoard.size() == 5);
+    REQUIRE(g_serverState.messageBoard.at(0).title == "a|b");
+    REQUIRE(g_serverState.messageBoard.at(0).message == "line1\nline2 \\ end");
+    REQUIRE(g_serverState.messageBoard.at(0).clientId == 3);
+    REQUIRE(g_serverState.messageBoard.at(3).author == "Dave");
+    REQUIRE(g_serverState.messageBoard.at(4).author == "Erin");
+
+    g_serverState.messageBoard.clear();
+    g_serverState.config.snapshotPath = savedSnapshotPath;
+    g_serverState.config.legacyBoardPath = savedLegacyPath;
+    reset_post_log();
+    remove_post_log(config.postLogPath);
+    unlink(snapshot.c_str());
+}
+
+// ============================================================================
+// TEST SUITE: BoardFile (binary board snapshot)
+// ============================================================================
+
+TEST_CASE("BoardFile - write, append and rebuild after an interrupted append", "[BoardFile]") {
+    std::string path = "/tmp/server_test_boardfile_" + std::to_string(getpid()) + ".board";
+    std::vector<Post> posts = {Post{"Alice", "a|b", "line1\nline2", 1}, Post{"", "", "", 2},
+                               Post{"Carol", "Title3", std::string(3000, 'x'), 3}};
+    auto viewAt = [&](size_t i) { return PostView(posts[i]); };
+    std::string error;
+
+    REQUIRE(BoardFile::write(path, 2, viewAt, error));
+    REQUIRE(BoardFile::append(path, 2, 3, viewAt, error));
+    REQUIRE_FALSE(BoardFile::append(path, 2, 3, viewAt, error));  // File now holds 3 posts
+
+    BoardFile file;
+    REQUIRE(file.open(path, error));
+    REQUIRE(file.size() == 3);
+    REQUIRE_FALSE(file.indexRebuilt());
+    REQUIRE(file.view(0).title == "a|b");
+    REQUIRE(file.view(0).message == "line1\nline2");
+    REQUIRE(file.view(1).author.empty());
+    REQUIRE(file.view(1).clientId == 2);
+    REQUIRE(file.view(2).message.size() == 3000);
+
+    // Crash after the new records overwrote the old index but before the header was rewritten
+    {
+        std::fstream raw(path, std::ios::in | std::ios::out | std::ios::binary);
+        raw.seekp(0, std::ios::end);
+        std::streamoff end = raw.tellp();
+        raw.seekp(end - 8);
+        raw.write("garbage!", 8);
+    }
+    BoardFile damaged;
+    REQUIRE(damaged.open(path, error));
+    REQUIRE(damaged.indexRebuilt());
+    REQUIRE(damaged.size() == 3);
+    REQUIRE(damaged.view(2).author == "Carol");
+    unlink(path.c_str());
+}
+
+TEST_CASE("loadFromFile - converts the text board once and serves it from the mapping", "[BoardFile]") {
+    std::string prefix = "/tmp/server_test_convert_" + std::to_string(getpid());
+    std::string savedSnapshotPath = g_serverState.config.snapshotPath;
+    std::string savedLegacyPath = g_serverState.config.legacyBoardPath;
+    g_serverState.config.snapshotPath = prefix + ".board";
+    g_serverState.config.legacyBoardPath = prefix + ".txt";
+    unlink(g_serverState.config.snapshotPath.c_str());
+    {
+        std::string text;
+        BoardFile::appendTextHeader(text);
+        BoardFile::appendTextLine(Post{"Alice", "Pipe|Title", "Message1", 7}, text);
+        text += "malformed line\n";
+        BoardFile::appendTextLine(Post{"Bob", "Title2", "Message2", 8}, text);
+        text += "Torn|Tit";  // Crash mid-save: no newline
+        std::ofstream file(g_serverState.config.legacyBoardPath, std::ios::binary);
+        file << text;
+    }
+
+    g_serverState.loadFromFile();
+    REQUIRE(g_serverState.messageBoard.size() == 2);
+    REQUIRE(g_serverState.messageBoard.mappedCount() == 2);
+    REQUIRE(g_serverState.messageBoard.at(0).title == "Pipe|Title");
+    REQUIRE(g_serverState.messageBoard.at(1).clientId == 8);
+
+    // New posts go to the heap segments; GET_BOARD mixes both seamlessly
+    g_serverState.messageBoard.append(Post{"Carol", "Title3", "Message3", 9});
+    REQUIRE(get_board_handler("", "") == "GET_BOARD}+{Alice}+{Pipe|Title}+{Message1}#{}+{Bob}+{Title2}+{Message2}#{}+{Carol}+{Title3}+{Message3}}&{{");
+
+    // The binary file now exists, so a restart no longer reads the text file
+    unlink(g_serverState.config.legacyBoardPath.c_str());
+    REQUIRE(g_serverState.saveToFile());
+    g_serverState.messageBoard.clear();
+    g_serverState.loadFromFile();
+    REQUIRE(g_serverState.messageBoard.size() == 3);
+    REQUIRE(g_serverState.messageBoard.at(2).author == "Carol");
+
+    g_serverState.messageBoard.clear();
+    unlink(g_serverState.config.snapshotPath.c_str());
+    g_serverState.config.snapshotPath = savedSnapshotPath;
+    g_serverState.config.legacyBoardPath = savedLegacyPath;
+}
+
+TEST_CASE("BoardFile - reads a text board written by the original server with its rules", "[BoardFile]") {
+    std::string path = "/tmp/server_test_legacy_" + std::to_string(getpid()) + ".txt";
+    {
+        // Raw fields: backslashes are literal and a '|' always separates
+        std::ofstream file(path, std::ios::binary);
+        file << "Alice|C:\\temp\\new|Line one\\nstill one|7\n"
+             << "\n"
+             << "Bob|Title|Message|8|extra\n"
+             << "Carol|Title|Message|not a number\n"
+             << "Dave|Title|Message\n";
+    }
+    std::vector<Post> posts;
+    std::string error;
+    REQUIRE(BoardFile::readText(path, posts, error));
+    REQUIRE(posts.size() == 2);
+    REQUIRE(posts[0].title == "C:\\temp\\new");
+    REQUIRE(posts[0].message == "Line one\\nstill one");
+    REQUIRE(posts[0].clientId == 7);
+    REQUIRE(posts[1].author == "Bob");
+    REQUIRE(posts[1].clientId == 8);
+    unlink(path.c_str());
+}
+
+// ============================================================================
+// TEST SUITE: extract_message_from_buffer
+// ============================================================================
+
+TEST_CASE("extract_message_from_buffer - keeps data after the terminator", "[extract_message_from_buffer]") {
+    std::string buffer = "GET_BOARD}}&{{POST}+{A}+{T}+{partial";
+    std::string message;
+
+    REQUIRE(extract_message_from_buffer(buffer, "}}&{{", message) == true);
+    REQUIRE(message == "GET_BOARD");
+    REQUIRE(buffer == "POST}+{A}+{T}+{partial");
+
+    // Remaining data has no terminator yet
+    REQUIRE(extract_message_from_buffer(buffer, "}}&{{", message) == false);
+    REQUIRE(buffer == "POST}+{A}+{T}+{partial");
+}
+
+// ============================================================================
+// TEST SUITE: MessageFramer
+// ============================================================================
+
+TEST_CASE("MessageFramer - terminator split across every possible boundary", "[MessageFramer]") {
+    const std::string stream = "GET_BOARD}}&{{POST}+{A}+{T}+{M}}&{{";
+    for (size_t cut = 0; cut <= stream.size(); cut++) {
+        MessageFramer framer("}}&{{");
+        std::string_view frame;
+        framer.append(stream.data(), cut);
+        std::vector<std::string> frames;
+        while (framer.next(frame)) frames.emplace_back(frame);
+        framer.append(stream.data() + cut, stream.size() - cut);
+        while (framer.next(frame)) frames.emplace_back(frame);
+
+        REQUIRE(frames == std::vector<std::string>{"GET_BOARD", "POST}+{A}+{T}+{M"});
+        REQUIRE(framer.buffered() == 0);
+    }
+}
+
+TEST_CASE("MessageFramer - fuzz: random messages in random recv() sizes", "[MessageFramer]") {
+    // Payload bytes include terminator look-alikes ("}}&{", "}&{{") that must not end a frame
+    const std::vector<std::string> pieces = {"}", "}}", "}}&", "}}&{", "&{{", "{", "a", "bc", "}+{", "}#{", "POST"};
+    std::mt19937 rng(12345);
+    for (int round = 0; round < 300; round++) {
+        std::vector<std::string> expected;
+        std::string stream;
+        int messages = 1 + (int)(rng() % 20);
+        for (int m = 0; m < messages; m++) {
+            std::string message;
+            int length = (int)(rng() % 40);
+            if (rng() % 16 == 0) length += 5000;  // Some messages span several recv() buffers
+            for (int k = 0; k < length; k++) message += pieces[rng() % pieces.size()];
+            // Drop any accidental terminator (and a trailing "}" that would join the next one)
+            size_t pos;
+            while ((pos = message.find("}}&{{")) != std::string::npos) message.erase(pos, 1);
+            while (!message.empty() && message.back() == '}') message.pop_back();
+            expected.push_back(message);
+            stream += message + "}}&{{";
+        }
+
+        MessageFramer framer("}}&{{");
+        std::string legacyBuffer, legacyMessage;
+        std::vector<std::string> frames, legacyFrames;
+        std::string_view frame;
+        for (size_t offset = 0; offset < stream.size();) {
+            size_t chunk = std::min(stream.size() - offset, (size_t)(1 + rng() % 700));
+            if (rng() % 2) {
+                framer.append(stream.data() + offset, chunk);
+            } else {
+                std::memcpy(framer.writeBuffer(chunk), stream.data() + offset, chunk);
+                framer.commit(chunk);
+            }
+            legacyBuffer.append(stream, offset, chunk);
+            offset += chunk;
+            while (framer.next(frame)) frames.emplace_back(frame);
+            while (extract_message_from_buffer(legacyBuffer, "}}&{{", legacyMessage)) legacyFrames.push_back(legacyMessage);
+        }
+
+        REQUIRE(frames == expected);
+        REQUIRE(legacyFrames == expected);
+        REQUIRE(framer.buffered() == 0);
+    }
+}
+
+// ============================================================================
+// TEST SUITE: parse_server_args
+// ============================================================================
+
+TEST_CASE("parse_server_args - selects epoll mode and loop count", "[parse_server_args]") {
+    char prog[] = "server", io[] = "--io=epoll", loops[] = "--loops=4", port[] = "--port=27000";
+    char* argv[] = {prog, io, loops, port};
+    ServerConfig config;
+    std::string error;
+
+    REQUIRE(parse_server_args(4, argv, config, error) == true);
+    REQUIRE(config.ioMode == IoMode::EPOLL);
+    REQUIRE(config.loopThreads == 4);
+    REQUIRE(config.port == 27000);
+}
+
+TEST_CASE("parse_server_args - rejects unknown options", "[parse_server_args]") {
+    char prog[] = "server", bad[] = "--io=fibers";
+    char* argv[] = {prog, bad};
+    ServerConfig config;
+    std::string error;
+
+    REQUIRE(parse_server_args(2, argv, config, error) == false);
+    REQUIRE(error.find("--io=fibers") != std::string::npos);
+    REQUIRE(config.ioMode == IoMode::THREAD_PER_CLIENT);  // Unchanged
+}
+
+// ============================================================================
+// TEST SUITE: client_handler
+// ============================================================================
+
+TEST_CASE("client_handler - answers a pipelined batch with one send", "[client_handler]") {
+    g_serverState.messageBoard.clear();
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+    // The whole batch is buffered before the handler starts, so one recv() picks it all up
+    std::string request = "POST}+{Alice}+{Title1}+{Message1}}&{{GET_BOARD}}&{{BOGUS}}&{{QUIT}}&{{";
+    REQUIRE(send_all_bytes(fds[0], request.data(), request.size(), 0) == (ssize_t)request.size());
+
+    long syscallsBefore = g_serverState.workerStats[0].ioSyscalls;
+    long requestsBefore = g_serverState.workerStats[0].requests;
+    ServerStatsTotals statsBefore = g_serverState.stats.totals();
+    std::thread handler(client_handler, fds[1]);
+
+    std::string rx, reply;
+    std::vector<std::string> replies;
+    while (replies.size() < 4 && read_message_until_terminator(fds[0], rx, "}}&{{", reply)) replies.push_back(reply);
+    handler.join();
+    close(fds[0]);
+
+    REQUIRE(replies.size() == 4);
+    REQUIRE(replies[0].find("POST_OK") == 0);
+    REQUIRE(replies[1] == "GET_BOARD}+{Alice}+{Title1}+{Message1");
+    REQUIRE(replies[2].find("INVALID_COMMAND") == 0);
+    REQUIRE(replies[3].find("QUIT") == 0);
+
+    // One recv() for the batch and one sendmsg() for all four replies
+    REQUIRE(g_serverState.workerStats[0].requests - requestsBefore == 4);
+    REQUIRE(g_serverState.workerStats[0].ioSyscalls - syscallsBefore == 2);
+
+    // Server-wide counters: traffic, one request per command, the unknown command as a parse error
+    ServerStatsTotals stats = g_serverState.stats.totals();
+    size_t replyBytes = 0;
+    for (const std::string& r : replies) replyBytes += r.size() + 5;  // Plus the "}}&{{" terminator
+    REQUIRE(stats.bytesIn - statsBefore.bytesIn == (long long)request.size());
+    REQUIRE(stats.bytesOut - statsBefore.bytesOut == (long long)replyBytes);
+    REQUIRE(stats.messagesReceived - statsBefore.messagesReceived == 1);
+    REQUIRE(stats.messagesSent - statsBefore.messagesSent == 4);
+    REQUIRE(stats.connectionsClosed - statsBefore.connectionsClosed == 1);
+    for (StatCommand c : {StatCommand::POST, StatCommand::GET_BOARD, StatCommand::INVALID_COMMAND, StatCommand::QUIT}) {
+        REQUIRE(stats.requests[(size_t)c] - statsBefore.requests[(size_t)c] == 1);
+    }
+    REQUIRE(stats.errors[(size_t)StatError::PARSE] - statsBefore.errors[(size_t)StatError::PARSE] == 1);
+}
+
+TEST_CASE("client_handler - pooled handlers do not wait for the group commit", "[client_handler][PostLog]") {
+    std::string path = "/tmp/server_test_pooled_" + std::to_string(getpid()) + ".wal";
+    remove_post_log(path);
+    ServerConfig config;
+    config.postLogPath = path;
+    config.postLog.durability = LogDurability::WRITE;
+    config.postLog.flushIntervalUs = 300000;  // One commit window for every client below
+    config.postLog.maxBatchRecords = 1000;
+    std::string error;
+    g_serverState.messageBoard.clear();
+    REQUIRE(start_post_log(config, error));
+    RequestPoolOptions poolOptions;
+    poolOptions.threads = 2;
+    g_serverState.requestPool.start(poolOptions);
+    uint64_t commitsBefore = g_serverState.postLog.commitCount();
+
+    // More concurrent POSTs than handlers: all of them must join the same group commit
+    const int CLIENTS = 6;
+    std::vector<int> clientSockets;
+    std::vector<std::thread> handlers;
+    for (int c = 0; c < CLIENTS; c++) {
+        int fds[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        std::string request = "POST}+{Client" + std::to_string(c) + "}+{T}+{M}}&{{QUIT}}&{{";
+        REQUIRE(send_all_bytes(fds[0], request.data(), request.size(), 0) == (ssize_t)request.size());
+        clientSockets.push_back(fds[0]);
+        handlers.emplace_back(client_handler, fds[1]);
+    }
+    int acknowledged = 0;
+    for (int socket : clientSockets) {
+        std::string rx, reply;
+        if (read_message_until_terminator(socket, rx, "}}&{{", reply) && reply.find("POST_OK") == 0) acknowledged++;
+        close(socket);
+    }
+    for (std::thread& handler : handlers) handler.join();
+
+    REQUIRE(acknowledged == CLIENTS);
+    REQUIRE(g_serverState.postLog.commitCount() - commitsBefore == 1);
+    REQUIRE(g_serverState.messageBoard.size() == (size_t)CLIENTS);
+
+    g_serverState.requestPool.stop();
+    stop_post_log();
+    reset_post_log();
+    remove_post_log(path);
+    g_serverState.messageBoard.clear();
+}
+
+TEST_CASE("client_handler - sends pushes while part of a request has arrived", "[client_handler][subscribe]") {
+    g_serverState.messageBoard.clear();
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    std::thread handler(client_handler, fds[1]);
+
+    std::string rx, reply;
+    std::string request = "SUBSCRIBE}+{Alice}}&{{";
+    REQUIRE(send_all_bytes(fds[0], request.data(), request.size(), 0) == (ssize_t)request.size());
+    REQUIRE(read_message_until_terminator(fds[0], rx, "}}&{{", reply));
+    REQUIRE(reply == "SUBSCRIBE_OK}+{0");
+
+    // Half a request is buffered when the post arrives: the push must not wait for the rest
+    request = "GET_BO";
+    REQUIRE(send_all_bytes(fds[0], request.data(), request.size(), 0) == (ssize_t)request.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::string error;
+    REQUIRE(publish_posts({Post{"Alice", "T", "Pushed"}}, error));
+    REQUIRE(read_message_until_terminator(fds[0], rx, "}}&{{", reply));
+    REQUIRE(reply == "NEW_POST}+{0}+{Alice}+{T}+{Pushed");
+
+    request = "ARD}}&{{QUIT}}&{{";
+    REQUIRE(send_all_bytes(fds[0], request.data(), request.size(), 0) == (ssize_t)request.size());
+    REQUIRE(read_message_until_terminator(fds[0], rx, "}}&{{", reply));
+    REQUIRE(reply == "GET_BOARD}+{Alice}+{T}+{Pushed");
+    REQUIRE(read_message_until_terminator(fds[0], rx, "}}&{{", reply));
+    REQUIRE(reply.find("QUIT") == 0);
+    handler.join();
+    close(fds[0]);
+    g_serverState.messageBoard.clear();
+}
+
+// ============================================================================
+// TEST SUITE: RequestPool
+// ============================================================================
+
+TEST_CASE("RequestPool - bounded handlers run every submitted request", "[RequestPool]") {
+    RequestPool pool;
+    RequestPoolOptions options;
+    options.threads = 2;
+    options.queueLimit = 2;
+    pool.start(options);
+    REQUIRE(pool.size() == 2);
+
+    // More submitters than handlers plus queue slots, so some must be held back
+    const int submitters = 8, perSubmitter = 200;
+    std::atomic<int> running{0}, maxRunning{0}, executed{0};
+    std::vector<std::thread> threads;
+    for (int s = 0; s < submitters; s++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < perSubmitter; i++) {
+                pool.run([&] {
+                    int now = running.fetch_add(1) + 1;
+                    int seen = maxRunning.load();
+                    while (now > seen && !maxRunning.compare_exchange_weak(seen, now)) {}
+                    std::this_thread::sleep_for(std::chrono::microseconds(20));
+                    running.fetch_sub(1);
+                    executed.fetch_add(1);
+                });
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    REQUIRE(executed == submitters * perSubmitter);
+    REQUIRE(pool.executed == submitters * perSubmitter);
+    REQUIRE(maxRunning <= 2);
+    REQUIRE(pool.peakQueued <= 2);
+    REQUIRE(pool.throttled > 0);
+    REQUIRE(pool.queued() == 0);
+
+    // Once stopped, requests run on the submitting thread
+    pool.stop();
+    std::thread::id ranOn;
+    pool.run([&] { ranOn = std::this_thread::get_id(); });
+    REQUIRE(ranOn == std::this_thread::get_id());
+}
+
+TEST_CASE("RequestPool - holds accepts back at the connection cap and counts them", "[RequestPool]") {
+    RequestPool pool;
+    RequestPoolOptions defaults;
+    REQUIRE(defaults.threads != 0);  // The pool is on unless --handlers=0
+    REQUIRE(defaults.maxConnections > 0);
+
+    RequestPoolOptions options;
+    options.threads = 0;
+    options.maxConnections = 2;
+    pool.start(options);
+    auto never = [] { return false; };
+    REQUIRE(pool.admitConnection(never));
+    REQUIRE(pool.admitConnection(never));
+    REQUIRE(pool.connections() == 2);
+
+    // A third connection waits until one of the first two finishes
+    std::atomic<bool> admitted{false};
+    std::thread acceptor([&] { admitted = pool.admitConnection(never); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(admitted);
+    pool.releaseConnection();
+    acceptor.join();
+    REQUIRE(admitted);
+    REQUIRE(pool.connections() == 2);
+    REQUIRE(pool.peakConnections == 2);
+    REQUIRE(pool.acceptsThrottled == 1);
+
+    // Shutdown stops the wait
+    REQUIRE_FALSE(pool.admitConnection([] { return true; }));
+    REQUIRE(pool.acceptsThrottled == 2);
+    pool.releaseConnection();
+    pool.releaseConnection();
+    REQUIRE(pool.connections() == 0);
+}
+
+// ============================================================================
+// TEST SUITE: EventLog
+// ============================================================================
+
+TEST_CASE("EventLog - concurrent producers keep the newest events and readers never see torn ones", "[EventLog]") {
+    EventLog log;
+    log.setRawVisible(true);
+    REQUIRE(log.snapshot().empty());
+
+    // Every field of an event names its producer and sequence number, so a torn copy shows
+    const int producers = 4, perProducer = 20000;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0}, reads{0};
+    std::thread reader([&] {
+        while (!done) {
+            for (const ServerEvent& e : log.snapshot()) {
+                torn += e.message != "event " + e.event_type || e.raw_message.compare(0, e.event_type.size(), e.event_type) != 0;
+            }
+            reads++;
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < perProducer; i++) {
+                std::string tag = std::to_string(p) + ":" + std::to_string(i);
+                log.push(tag, "event " + tag, tag + std::string(i % 200, 'r'));
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    done = true;
+    reader.join();
+    REQUIRE(reads > 0);
+    REQUIRE(torn == 0);
+
+    // Quiescent: the ring holds exactly the newest CAPACITY events, newest first per producer
+    REQUIRE(log.total() == (uint64_t)producers * perProducer);
+    std::vector<ServerEvent> events = log.snapshot();
+    REQUIRE(events.size() == EventLog::CAPACITY);
+    std::vector<int> lastSeen(producers, perProducer);
+    int outOfOrder = 0;
+    for (const ServerEvent& e : events) {
+        int p = std::stoi(e.event_type);
+        int i = std::stoi(e.event_type.substr(e.event_type.find(':') + 1));
+        outOfOrder += i >= lastSeen[p];
+        lastSeen[p] = i;
+    }
+    REQUIRE(outOfOrder == 0);
+    REQUIRE(events.front().timestamp.size() == 8);  // HH:MM:SS
+
+    // Long text is cut to the slot size and marked
+    log.push("LONG", std::string(1000, 'm'), std::string(1000, 'r'));
+    ServerEvent longEvent = log.snapshot(1).front();
+    REQUIRE(longEvent.message.size() == EventLog::MESSAGE_BYTES);
+    REQUIRE(longEvent.raw_message.size() == EventLog::RAW_BYTES);
+    REQUIRE(longEvent.raw_message.compare(EventLog::RAW_BYTES - 3, 3, "...") == 0);
+}
+
+TEST_CASE("EventLog - formats per-request messages lazily and keeps raw payloads only when shown or sampled", "[EventLog]") {
+    EventLog log;
+    log.pushFormat("POST", "Client posted %lld message(s) (socket: %lld)", 3, 17, "POST}+{a}+{b}+{c}}&{{");
+    log.push("ERROR", "Invalid command: x", "raw");
+    std::vector<ServerEvent> hidden = log.snapshot();
+    REQUIRE(hidden.size() == 2);
+    REQUIRE(hidden[1].message == "Client posted 3 message(s) (socket: 17)");
+    REQUIRE(hidden[0].message == "Invalid command: x");
+    REQUIRE(hidden[0].raw_message.empty());  // Nobody is looking: raw payloads are not copied
+    REQUIRE(hidden[1].raw_message.empty());
+
+    log.setRawVisible(true);
+    log.pushFormat("GET_BOARD", "Client requested board (socket: %lld)", 5, 0, "GET_BOARD}}&{{");
+    REQUIRE(log.snapshot(1).front().raw_message == "GET_BOARD}}&{{");
+
+    // Hidden again, sampling one event in four: tickets 3..10 keep the raw payload of 4 and 8
+    log.setRawVisible(false);
+    log.setRawSampling(4);
+    for (int i = 0; i < 8; i++) log.pushFormat("GET_BOARD", "Client requested board (socket: %lld)", i, 0, "raw");
+    int kept = 0;
+    for (const ServerEvent& e : log.snapshot(8)) kept += !e.raw_message.empty();
+    REQUIRE(kept == 2);
+}
+
+// ============================================================================
+// TEST SUITE: ServerStats
+// ============================================================================
+
+TEST_CASE("ServerStats - sharded counters from many threads sum exactly and client IDs stay unique", "[ServerStats]") {
+    ServerStats stats;
+    constexpr int THREADS = 8;
+    constexpr int ROUNDS = 20000;
+    std::vector<std::vector<int>> ids(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < ROUNDS; i++) {
+                stats.add(ServerStats::CONNECTIONS_OPENED);
+                stats.add(ServerStats::BYTES_IN, 3);
+                stats.countRequest((StatCommand)(i % (int)StatCommand::COUNT));
+                if (i % 2 == 0) stats.countError(StatError::SEND);
+                if (i % 4 == 0) stats.add(ServerStats::CONNECTIONS_CLOSED);
+                if (i % 100 == 0) ids[t].push_back(stats.nextClientId());
+            }
+        });
+    }
+    ServerStatsTotals during = stats.totals();  // Concurrent reads are allowed (and never negative)
+    for (std::thread& thread : threads) thread.join();
+
+    ServerStatsTotals totals = stats.totals();
+    REQUIRE(during.activeConnections >= 0);
+    REQUIRE(totals.connectionsOpened == THREADS * ROUNDS);
+    REQUIRE(totals.activeConnections == THREADS * ROUNDS * 3 / 4);
+    REQUIRE(totals.bytesIn == 3LL * THREADS * ROUNDS);
+    REQUIRE(totals.totalRequests() == THREADS * ROUNDS);
+    REQUIRE(totals.requests[(size_t)StatCommand::GET_BOARD] == THREADS * ((ROUNDS + 6) / 7));  // i % 7 == 0
+    REQUIRE(totals.errors[(size_t)StatError::SEND] == THREADS * ROUNDS / 2);
+    REQUIRE(totals.totalErrors() == totals.errors[(size_t)StatError::SEND]);
+
+    std::vector<int> all;
+    for (const std::vector<int>& threadIds : ids) all.insert(all.end(), threadIds.begin(), threadIds.end());
+    std::sort(all.begin(), all.end());
+    REQUIRE(all.size() == THREADS * ROUNDS / 100);
+    REQUIRE(all.front() == 1);
+    REQUIRE(all.back() == (int)all.size());  // 1..N with no repeats
+}
+
+// ============================================================================
+// TEST SUITE: LatencyHistogram
+// ============================================================================
+
+TEST_CASE("LatencyHistogram - percentiles within 0.1% and merged halves match the whole", "[LatencyHistogram]") {
+    // Exact percentiles are known for 1..N; spread the values over many powers of two
+    std::vector<uint64_t> values;
+    for (uint64_t v = 1; v <= 200000; v++) values.push_back(v * 37);
+    LatencyHistogram whole, low, high;
+    for (size_t i = 0; i < values.size(); i++) {
+        whole.record(values[i]);
+        (i % 2 ? high : low).record(values[i]);
+    }
+    REQUIRE(whole.count() == values.size());
+    REQUIRE(whole.min() == values.front());
+    REQUIRE(whole.max() == values.back());
+
+    int outOfBounds = 0;
+    for (double p : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 99.99, 100.0}) {
+        uint64_t exact = values[(size_t)(p / 100.0 * values.size() + 0.5) - 1];
+        uint64_t reported = whole.percentile(p);
+        outOfBounds += reported < exact || reported > exact + exact / 1000;
+    }
+    REQUIRE(outOfBounds == 0);
+
+    low.merge(high);
+    int differ = 0;
+    for (double p : {0.5, 25.0, 75.0, 99.9}) differ += low.percentile(p) != whole.percentile(p);
+    REQUIRE(differ == 0);
+    REQUIRE(low.mean() == Approx(whole.mean()));
+
+    // Values past the trackable range are clamped, not lost
+    LatencyHistogram huge;
+    huge.record(UINT64_MAX);
+    REQUIRE(huge.count() == 1);
+    REQUIRE(huge.percentile(50) == UINT64_MAX);
+}
+
+// ============================================================================
+// TEST SUITE: reactor_loop
+// ============================================================================
+
+TEST_CASE("reactor_loop - serves pipelined requests over loopback", "[reactor_loop]") {
+    g_serverState.messageBoard.clear();
+
+    // Listening socket on an ephemeral loopback port
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+    REQUIRE(set_non_blocking(listener));
+
+    std::atomic<bool> stop{false};
+    std::thread loop(reactor_loop, 0, listener, std::cref(stop));
+
+    int client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(connect(client, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+
+    // Two requests in one send: the reactor must answer both, in order
+    std::string request = "POST}+{Alice}+{Title1}+{Message1}}&{{GET_BOARD}}&{{QUIT}}&{{";
+    REQUIRE(send_all_bytes(client, request.data(), request.size(), 0) == (ssize_t)request.size());
+
+    std::string rx, first, second, third;
+    REQUIRE(read_message_until_terminator(client, rx, "}}&{{", first));
+    REQUIRE(read_message_until_terminator(client, rx, "}}&{{", second));
+    REQUIRE(read_message_until_terminator(client, rx, "}}&{{", third));
+    REQUIRE(first.find("POST_OK") == 0);
+    REQUIRE(second == "GET_BOARD}+{Alice}+{Title1}+{Message1");
+    REQUIRE(third.find("QUIT") == 0);
+
+    close(client);
+    stop = true;
+    loop.join();
+    close(listener);
+}
+
+TEST_CASE("reactor_loop - closes a connection whose request outgrows MAX_REQUEST_BYTES and keeps serving others", "[reactor_loop]") {
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+    REQUIRE(set_non_blocking(listener));
+
+    long long oversizedBefore = g_serverState.stats.totals().errors[(size_t)StatError::OVERSIZED];
+    std::atomic<bool> stop{false};
+    std::thread loop(reactor_loop, 0, listener, std::cref(stop));
+
+    // One client streams a request that never ends; it is cut off past the limit
+    int flooder = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(connect(flooder, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    std::thread flood([&] {
+        std::string junk(64 * 1024, 'x');
+        for (size_t sent = 0; sent <= MAX_REQUEST_BYTES + junk.size(); sent += junk.size()) {
+            if (send_all_bytes(flooder, junk.data(), junk.size(), MSG_NOSIGNAL) < 0) break;
+        }
+    });
+
+    // Meanwhile another connection on the same loop is answered
+    int client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(connect(client, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    std::string request = "GET_BOARD}}&{{", rx, reply;
+    REQUIRE(send_all_bytes(client, request.data(), request.size(), 0) == (ssize_t)request.size());
+    REQUIRE(read_message_until_terminator(client, rx, "}}&{{", reply));
+    REQUIRE(reply.find("GET_BOARD") == 0);
+
+    flood.join();
+    char byte;
+    REQUIRE(recv(flooder, &byte, 1, 0) <= 0);  // Closed (EOF or reset), never answered
+    REQUIRE(g_serverState.stats.totals().errors[(size_t)StatError::OVERSIZED] - oversizedBefore == 1);
+
+    close(flooder);
+    close(client);
+    stop = true;
+    loop.join();
+    close(listener);
+}
+
+/// @brief Runs a SUBSCRIBE round trip against an event loop listening on addr
+/// The subscriber must get only matching posts published after SUBSCRIBE_OK, in order
+static void check_subscription_pushes(const struct sockaddr_in& addr) {
+    int subscriber = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int poster = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(connect(subscriber, (const struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(connect(poster, (const struct sockaddr*)&addr, sizeof(addr)) == 0);
+
+    std::string rxSub, rxPost, message;
+    std::string request = "SUBSCRIBE}+{Alice}}&{{";
+    REQUIRE(send_all_bytes(subscriber, request.data(), request.size(), 0) == (ssize_t)request.size());
+    REQUIRE(read_message_until_terminator(subscriber, rxSub, "}}&{{", message));
+    REQUIRE(message == "SUBSCRIBE_OK}+{1");
+
+    request = "POST}+{Bob}+{T}+{Skipped}#{Alice}+{T}+{First}}&{{POST}+{Alice}+{T}+{Second}}&{{";
+    REQUIRE(send_all_bytes(poster, request.data(), request.size(), 0) == (ssize_t)request.size());
+    REQUIRE(read_message_until_terminator(poster, rxPost, "}}&{{", message));
+    REQUIRE(read_message_until_terminator(poster, rxPost, "}}&{{", message));
+
+    REQUIRE(read_message_until_terminator(subscriber, rxSub, "}}&{{", message));
+    REQUIRE(message == "NEW_POST}+{2}+{Alice}+{T}+{First");
+    REQUIRE(read_message_until_terminator(subscriber, rxSub, "}}&{{", message));
+    REQUIRE(message == "NEW_POST}+{3}+{Alice}+{T}+{Second");
+
+    request = "UNSUBSCRIBE}}&{{";
+    REQUIRE(send_all_bytes(subscriber, request.data(), request.size(), 0) == (ssize_t)request.size());
+    REQUIRE(read_message_until_terminator(subscriber, rxSub, "}}&{{", message));
+    REQUIRE(message == "UNSUBSCRIBE_OK");
+    close(subscriber);
+    close(poster);
+}
+
+/// @brief Checks that an event loop listening on addr keeps serving while a POST is syncing
+/// The post log is started with a half-second group-commit delay: another connection's
+/// GET_BOARD must be answered before the POST's batch is durable, and POST_OK (followed by the
+/// request pipelined behind it) only once it is
+static void check_post_sync_does_not_block_loop(const struct sockaddr_in& addr) {
+    std::string path = "/tmp/server_test_heldpost_" + std::to_string(getpid()) + ".wal";
+    remove_post_log(path);
+    ServerConfig config;
+    config.postLogPath = path;
+    config.postLog.durability = LogDurability::WRITE;
+    config.postLog.flushIntervalUs = 500000;
+    config.postLog.maxBatchRecords = 1000;
+    std::string error;
+    g_serverState.messageBoard.clear();
+    REQUIRE(start_post_log(config, error));
+    uint64_t commitsBefore = g_serverState.postLog.commitCount();
+
+    int poster = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int reader = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(connect(poster, (const struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(connect(reader, (const struct sockaddr*)&addr, sizeof(addr)) == 0);
+
+    std::string rxPost, rxRead, message;
+    std::string request = "POST}+{Alice}+{T}+{Held}}&{{GET_BOARD}}&{{";
+    REQUIRE(send_all_bytes(poster, request.data(), request.size(), 0) == (ssize_t)request.size());
+    request = "GET_BOARD}}&{{";
+    REQUIRE(send_all_bytes(reader, request.data(), request.size(), 0) == (ssize_t)request.size());
+    REQUIRE(read_message_until_terminator(reader, rxRead, "}}&{{", message));
+    REQUIRE(message == "GET_BOARD}+{Alice}+{T}+{Held");  // Published, just not durable yet
+
+    // Still syncing: no commit yet and nothing sent to the poster
+    char byte;
+    REQUIRE(g_serverState.postLog.commitCount() == commitsBefore);
+    REQUIRE(recv(poster, &byte, 1, MSG_DONTWAIT) == -1);
+    REQUIRE(errno == EAGAIN);
+
+    REQUIRE(read_message_until_terminator(poster, rxPost, "}}&{{", message));
+    REQUIRE(message.find("POST_OK") == 0);
+    REQUIRE(g_serverState.postLog.commitCount() > commitsBefore);
+    REQUIRE(read_message_until_terminator(poster, rxPost, "}}&{{", message));
+    REQUIRE(message == "GET_BOARD}+{Alice}+{T}+{Held");
+
+    close(poster);
+    close(reader);
+    stop_post_log();
+    reset_post_log();
+    remove_post_log(path);
+    g_serverState.messageBoard.clear();
+}
+
+TEST_CASE("reactor_loop - pushes new posts to SUBSCRIBE'd connections", "[reactor_loop][subscribe]") {
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"Alice", "T", "Before"});
+
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+    REQUIRE(set_non_blocking(listener));
+
+    std::atomic<bool> stop{false};
+    std::thread loop(reactor_loop, 0, listener, std::cref(stop));
+    check_subscription_pushes(addr);
+    stop = true;
+    loop.join();
+    close(listener);
+    REQUIRE(g_serverState.subscriptions.size() == 0);
+}
+
+TEST_CASE("reactor_loop - answers other connections while a POST waits for the post log", "[reactor_loop][PostLog]") {
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+    REQUIRE(set_non_blocking(listener));
+
+    std::atomic<bool> stop{false};
+    std::thread loop(reactor_loop, 0, listener, std::cref(stop));
+    check_post_sync_does_not_block_loop(addr);
+    stop = true;
+    loop.join();
+    close(listener);
+}
+
+#ifdef SERVER_HAVE_IO_URING
+// ============================================================================
+// TEST SUITE: uring_loop
+// ============================================================================
+
+TEST_CASE("uring_loop - serves pipelined requests and counts requests", "[uring_loop]") {
+    g_serverState.messageBoard.clear();
+
+    // Listening socket on an ephemeral loopback port (left blocking for io_uring)
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+
+    WorkerStats& stats = g_serverState.workerStats[3];
+    long requestsBefore = stats.requests;
+
+    std::atomic<bool> stop{false};
+    std::thread loop(uring_loop, 3, listener, std::cref(stop));
+
+    int client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(connect(client, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+
+    // Three requests in one send: the responses go out as one linked chain, in order
+    std::string request = "POST}+{Alice}+{Title1}+{Message1}}&{{GET_BOARD}}&{{QUIT}}&{{";
+    REQUIRE(send_all_bytes(client, request.data(), request.size(), 0) == (ssize_t)request.size());
+
+    std::string rx, first, second, third;
+    REQUIRE(read_message_until_terminator(client, rx, "}}&{{", first));
+    REQUIRE(read_message_until_terminator(client, rx, "}}&{{", second));
+    REQUIRE(read_message_until_terminator(client, rx, "}}&{{", third));
+    REQUIRE(first.find("POST_OK") == 0);
+    REQUIRE(second == "GET_BOARD}+{Alice}+{Title1}+{Message1");
+    REQUIRE(third.find("QUIT") == 0);
+
+    // QUIT closes the connection once the goodbye is sent
+    char byte;
+    REQUIRE(recv(client, &byte, 1, 0) == 0);
+    REQUIRE(stats.requests - requestsBefore == 3);
+
+    close(client);
+    stop = true;
+    loop.join();
+    close(listener);
+}
+
+TEST_CASE("uring_loop - pushes new posts to SUBSCRIBE'd connections", "[uring_loop][subscribe]") {
+    g_serverState.messageBoard.clear();
+    g_serverState.messageBoard.append(Post{"Alice", "T", "Before"});
+
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+
+    std::atomic<bool> stop{false};
+    std::thread loop(uring_loop, 3, listener, std::cref(stop));
+    check_subscription_pushes(addr);
+    stop = true;
+    loop.join();
+    close(listener);
+    REQUIRE(g_serverState.subscriptions.size() == 0);
+}
+
+TEST_CASE("uring_loop - answers other connections while a POST waits for the post log", "[uring_loop][PostLog]") {
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+
+    std::atomic<bool> stop{false};
+    std::thread loop(uring_loop, 3, listener, std::cref(stop));
+    check_post_sync_does_not_block_loop(addr);
+    stop = true;
+    loop.join();
+    close(listener);
+}
+
+TEST_CASE("uring_loop - shutdown drains sends stuck on a client that stopped reading", "[uring_loop]") {
+    g_serverState.messageBoard.clear();
+    for (int i = 0; i < 200; i++) g_serverState.messageBoard.append(Post{"Alice", "T", std::string(4000, 'm')});
+
+    int listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, SOMAXCONN) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listener, (struct sockaddr*)&addr, &len);
+
+    size_t clientsBefore;
+    {
+        std::lock_guard<std::mutex> lock(g_serverState.clientsMutex);
+        clientsBefore = g_serverState.activeClientSockets.size();
+    }
+    std::atomic<bool> stop{false};
+    std::thread loop(uring_loop, 3, listener, std::cref(stop));
+
+    // Megabytes of replies the client never reads: the send chain stays in flight
+    int client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(connect(client, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    std::string request;
+    for (int i = 0; i < 8; i++) request += "GET_BOARD}}&{{";
+    REQUIRE(send_all_bytes(client, request.data(), request.size(), 0) == (ssize_t)request.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto started = std::chrono::steady_clock::now();
+    stop = true;
+    loop.join();
+    REQUIRE(std::chrono::steady_clock::now() - started < std::chrono::seconds(2));
+    {
+        std::lock_guard<std::mutex> lock(g_serverState.clientsMutex);
+        REQUIRE(g_serverState.activeClientSockets.size() == clientsBefore);
+    }
+
+    // The connection was closed: reading ends instead of blocking
+    char buffer[65536];
+    ssize_t got;
+    while ((got = recv(client, buffer, sizeof(buffer), 0)) > 0) {}
+    REQUIRE(got <= 0);
+    close(client);
+    close(listener);
+    g_serverState.messageBoard.clear();
+}
+#endif
+
+// ============================================================================
+// TEST SUITE: open_listening_socket (SO_REUSEPORT workers)
+// ============================================================================
+
+TEST_CASE("open_listening_socket - workers share a port and keep per-worker counters", "[open_listening_socket]") {
+    ServerConfig config;
+    config.port = 26977;
+    config.backlog = 64;
+
+    // Two SO_REUSEPORT listeners can bind the same port
+    int listenerA = open_listening_socket(config, true);
+    int listenerB = open_listening_socket(config, true);
+    REQUIRE(listenerA != INVALID_SOCKET);
+    REQUIRE(listenerB != INVALID_SOCKET);
+    REQUIRE(set_non_blocking(listenerA));
+    REQUIRE(set_non_blocking(listenerB));
+
+    WorkerStats& statsA = g_serverState.workerStats[1];
+    WorkerStats& statsB = g_serverState.workerStats[2];
+    long acceptedBefore = statsA.accepted + statsB.accepted;
+    long closedBefore = statsA.closed + statsB.closed;
+
+    std::atomic<bool> stop{false};
+    std::thread workerA(reactor_loop, 1, listenerA, std::cref(stop));
+    std::thread workerB(reactor_loop, 2, listenerB, std::cref(stop));
+
+    // Each client completes a request, so it has certainly been accepted by some worker
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(config.port);
+    const int clients = 16;
+    for (int i = 0; i < clients; i++) {
+        int client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        REQUIRE(connect(client, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+        std::string request = "QUIT}}&{{", rx, reply;
+        send_all_bytes(client, request.data(), request.size(), 0);
+        REQUIRE(read_message_until_terminator(client, rx, "}}&{{", reply));
+        close(client);
+    }
+
+    stop = true;
+    workerA.join();
+    workerB.join();
+    close(listenerA);
+    close(listenerB);
+
+    REQUIRE(statsA.accepted + statsB.accepted - acceptedBefore == clients);
+    REQUIRE(statsA.closed + statsB.closed - closedBefore == clients);
+    REQUIRE(statsA.active == 0);
+    REQUIRE(statsB.active == 0);
+}
@@ -0,0 +1,250 @@
+#pragma once
+// Minimal io_uring wrapper built directly on the kernel ABI (no liburing dependency).
+// Only what the server's io_uring backend needs: one SQ/CQ pair, batched submission
+// with a wait timeout, and a provided-buffer ring for multishot recv.
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+/// @brief One io_uring instance (submission + completion queue) owned by a single thread
+class IoUring {
+public:
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring() { close(); }
+
+    /// @brief Unmaps the queues and closes the ring; the kernel cancels whatever is still in flight
+    /// Safe to call more than once; the ring is unusable afterwards
+    void close() {
+        if (bufRing) munmap(bufRing, bufRingSize);
+        if (sqes) munmap(sqes, sqesSize);
+        if (cqPtr && cqPtr != sqPtr) munmap(cqPtr, cqSize);
+        if (sqPtr) munmap(sqPtr, sqSize);
+        if (ringFd >= 0) ::close(ringFd);
+        bufRing = nullptr;
+        sqes = nullptr;
+        cqPtr = nullptr;
+        sqPtr = nullptr;
+        ringFd = -1;
+    }
+
+    /// @brief Creates the ring and maps its queues
+    /// @param entries Submission queue size (the kernel rounds it up to a power of two)
+    /// @param error Output: description of the failure
+    /// @return True on success
+    bool init(unsigned entries, std::string& error) {
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+#if defined(IORING_SETUP_DEFER_TASKRUN)
+        // Completion work runs only inside io_uring_enter() on the owning thread, so the
+        // loop is not interrupted between waits (kernel 6.1+; retried without it below)
+        params.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+        ringFd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (ringFd < 0 && errno == EINVAL)
+#endif
+        {
+            memset(&params, 0, sizeof(params));
+            params.flags = IORING_SETUP_SUBMIT_ALL;
+            ringFd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        }
+        if (ringFd < 0) {
+            error = std::string("io_uring_setup failed: ") + strerror(errno);
+            return false;
+        }
+        if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG)) {
+            error = "kernel io_uring lacks SINGLE_MMAP/EXT_ARG support";
+            return false;
+        }
+
+        // Submission and completion rings share one mapping (IORING_FEAT_SINGLE_MMAP)
+        sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (cqSize > sqSize) sqSize = cqSize;
+        sqPtr = mmap(nullptr, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqPtr == MAP_FAILED) {
+            sqPtr = nullptr;
+            error = std::string("mmap of io_uring rings failed: ") + strerror(errno);
+            return false;
+        }
+        cqPtr = sqPtr;
+
+        sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        void* sqeMem = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqeMem == MAP_FAILED) {
+            error = std::string("mmap of io_uring SQEs failed: ") + strerror(errno);
+            return false;
+        }
+        sqes = static_cast<struct io_uring_sqe*>(sqeMem);
+
+        char* sq = static_cast<char*>(sqPtr);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries = params.sq_entries;
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(cqPtr);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        localTail = *sqTail;
+        submittedTail = localTail;
+        return true;
+    }
+
+    /// @brief Returns a zeroed submission entry, or nullptr if the queue is full
+    /// The caller should submit() and retry when nullptr is returned
+    struct io_uring_sqe* getSqe() {
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (localTail - head >= sqEntries) return nullptr;
+        unsigned index = localTail & sqMask;
+        struct io_uring_sqe* sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        localTail++;
+        return sqe;
+    }
+
+    /// @brief Number of entries prepared with getSqe() but not yet submitted
+    unsigned pending() const { return localTail - submittedTail; }
+
+    /// @brief Submits all prepared entries and optionally waits for completions
+    /// One io_uring_enter() call covers both the submission and the wait
+    /// @param waitNr Minimum completions to wait for (0 = do not wait)
+    /// @param timeoutMs Upper bound on the wait in milliseconds
+    /// @return Entries submitted, or -errno (-ETIME when the wait timed out)
+    int submitAndWait(unsigned waitNr, int timeoutMs) {
+        __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+        unsigned toSubmit = localTail - submittedTail;
+
+        struct __kernel_timespec ts;
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = (long long)(timeoutMs % 1000) * 1000000;
+        struct io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.ts = (unsigned long long)(uintptr_t)&ts;
+
+        unsigned flags = IORING_ENTER_EXT_ARG | (waitNr ? IORING_ENTER_GETEVENTS : 0);
+        int ret = (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, waitNr, flags, &arg, sizeof(arg));
+        if (ret < 0) return -errno;
+        submittedTail += (unsigned)ret;
+        return ret;
+    }
+
+    /// @brief Calls fn(cqe) for every available completion, then releases them to the kernel
+    /// @return Number of completions processed
+    template <typename Fn>
+    unsigned forEachCompletion(Fn&& fn) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        while (head != tail) {
+            fn(cqes[head & cqMask]);
+            head++;
+            count++;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    /// @brief Registers a ring of provided buffers for IOSQE_BUFFER_SELECT receives
+    /// Buffer i of the group starts at base + i * bufferSize
+    /// @param groupId Buffer group ID used in sqe->buf_group
+    /// @param base Start of the caller-owned buffer memory (count * bufferSize bytes)
+    /// @param count Number of buffers (must be a power of two)
+    /// @param bufferSize Size of each buffer in bytes
+    /// @param error Output: description of the failure
+    /// @return True on success
+    bool registerBufferRing(unsigned short groupId, char* base, unsigned count, unsigned bufferSize, std::string& error) {
+        bufRingSize = count * sizeof(struct io_uring_buf);
+        void* mem = mmap(nullptr, bufRingSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (mem == MAP_FAILED) {
+            error = std::string("mmap of buffer ring failed: ") + strerror(errno);
+            return false;
+        }
+        bufRing = static_cast<struct io_uring_buf_ring*>(mem);
+        bufRingMask = count - 1;
+        bufBase = base;
+        bufSize = bufferSize;
+
+        struct io_uring_buf_reg reg;
+        memset(&reg, 0, sizeof(reg));
+        reg.ring_addr = (unsigned long long)(uintptr_t)bufRing;
+        reg.ring_entries = count;
+        reg.bgid = groupId;
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            error = std::string("IORING_REGISTER_PBUF_RING failed: ") + strerror(errno);
+            return false;
+        }
+
+        // Hand every buffer to the kernel
+        for (unsigned i = 0; i < count; i++) {
+            addBuffer((unsigned short)i, false);
+        }
+        publishBuffers();
+        return true;
+    }
+
+    /// @brief Address of a provided buffer by ID
+    char* bufferAt(unsigned short bufferId) const { return bufBase + (size_t)bufferId * bufSize; }
+
+    /// @brief Returns a consumed buffer to the kernel (visible after publishBuffers())
+    void addBuffer(unsigned short bufferId, bool publish = true) {
+        // Index the ring as a plain array: in C++ the header's flexible-array member can
+        // be placed after an empty struct, which shifts bufs[] off the kernel's layout
+        struct io_uring_buf* buf = reinterpret_cast<struct io_uring_buf*>(bufRing) + (bufLocalTail & bufRingMask);
+        buf->addr = (unsigned long long)(uintptr_t)bufferAt(bufferId);
+        buf->len = bufSize;
+        buf->bid = bufferId;
+        bufLocalTail++;
+        if (publish) publishBuffers();
+    }
+
+    /// @brief Makes buffers added with addBuffer() visible to the kernel
+    void publishBuffers() {
+        __atomic_store_n(&bufRing->tail, bufLocalTail, __ATOMIC_RELEASE);
+    }
+
+private:
+    int ringFd = -1;
+
+    // Shared ring mappings
+    void* sqPtr = nullptr;
+    void* cqPtr = nullptr;
+    size_t sqSize = 0;
+    size_t cqSize = 0;
+    struct io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    // Submission queue
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned localTail = 0;       // Next SQE to hand out
+    unsigned submittedTail = 0;   // Entries consumed by io_uring_enter so far
+
+    // Completion queue
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    struct io_uring_cqe* cqes = nullptr;
+
+    // Provided buffer ring
+    struct io_uring_buf_ring* bufRing = nullptr;
+    size_t bufRingSize = 0;
+    unsigned bufRingMask = 0;
+    unsigned short bufLocalTail = 0;
+    char* bufBase = nullptr;
+    unsigned bufSize = 0;
+};